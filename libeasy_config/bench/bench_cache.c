@@ -0,0 +1,124 @@
+/*
+ * Cold start: parsing the text file vs. mapping the compiled cache.
+ *
+ * A config of "service.N.keyN = <typed value>" lines (ints, sizes,
+ * durations, lists) is written to /tmp. Each mode is timed from the load
+ * call through 10k random typed lookups, the work a service does at
+ * startup:
+ *   text   - Config.Load
+ *   build  - Config.LoadCached with no cache: parse + write the cache
+ *   cache  - Config.LoadCached with a valid cache: map only
+ * Each runs with the files in the page cache (warm) and after dropping
+ * them with posix_fadvise (cold, as after a reboot; needs the files to
+ * be clean, so they are fsync'ed first).
+ *
+ * Usage: ./bench/bench_cache [megabytes]
+ */
+#include "easy_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOOKUPS 10000
+
+static FILE* out;
+static char path[64], cache[64];
+static long lines;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool write_config(long bytes) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    long written = 0;
+    for (lines = 0; written < bytes; lines++) {
+        int n;
+        switch (lines % 4) {
+            case 0:  n = fprintf(f, "service.%ld.key%ld = %ld\n", lines / 64, lines, lines * 7919); break;
+            case 1:  n = fprintf(f, "service.%ld.key%ld = %ldK\n", lines / 64, lines, lines % 4096); break;
+            case 2:  n = fprintf(f, "service.%ld.key%ld = %ldms\n", lines / 64, lines, lines % 10000); break;
+            default: n = fprintf(f, "service.%ld.key%ld = a%ld, b, c\n", lines / 64, lines, lines); break;
+        }
+        if (n < 0) break;
+        written += n;
+    }
+    return fclose(f) == 0;
+}
+
+static void drop_page_cache(const char* file) {
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static void run(const char* name, bool cached, bool cold) {
+    if (cold) {
+        drop_page_cache(path);
+        drop_page_cache(cache);
+    }
+
+    srand(1);
+    double t0 = now_s();
+    bool ok = cached ? Config.LoadCached(path, cache) : Config.Load(path);
+    double loaded = now_s() - t0;
+
+    long found = 0;
+    char key[64];
+    const char* items[4];
+    for (int i = 0; ok && i < LOOKUPS; i++) {
+        long n = rand() % lines;
+        snprintf(key, sizeof(key), "service.%ld.key%ld", n / 64, n);
+        ConfigStatus_t st;
+        switch (n % 4) {
+            case 0:  Config.GetInt64(key, 0, &st); break;
+            case 1:  Config.GetSize(key, 0, &st); break;
+            case 2:  Config.GetDuration(key, 0, &st); break;
+            default: st = (Config.GetList(key, items, 4) == 3) ? CONFIG_OK : CONFIG_BAD_VALUE; break;
+        }
+        found += (st == CONFIG_OK);
+    }
+    double total = now_s() - t0;
+
+    fprintf(out, "%-6s %-5s %10.1f %12.1f %10.1f %8s\n", name, cold ? "cold" : "warm", loaded * 1e3,
+            (total - loaded) * 1e3, total * 1e3, (found == LOOKUPS) ? "ok" : "MISSING");
+    Config.Cleanup();
+}
+
+int main(int argc, char** argv) {
+    int mb = (argc > 1) ? atoi(argv[1]) : 100;
+    if (mb <= 0) mb = 100;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    snprintf(path, sizeof(path), "/tmp/bench_cache_%d.conf", (int)getpid());
+    snprintf(cache, sizeof(cache), "/tmp/bench_cache_%d.bin", (int)getpid());
+    if (!write_config((long)mb << 20)) {
+        perror("bench_cache: write config");
+        return 1;
+    }
+
+    fprintf(out, "%d MB, %ld keys\n", mb, lines);
+    fprintf(out, "%-6s %-5s %10s %12s %10s %8s\n", "mode", "cache", "load ms", "lookups ms", "total ms", "values");
+    for (int cold = 0; cold < 2; cold++) {
+        run("text", false, cold);
+        unlink(cache);
+        run("build", true, cold);
+        run("cache", true, cold);
+    }
+
+    unlink(path);
+    unlink(cache);
+    fclose(out);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+ * Config load time: mmap tokenizer vs. the previous fgets/strdup parser.
+ *
+ * A config of "group.N.keyN = value" lines (every 100th value 400 bytes
+ * long, past the old 256-byte line buffer) is written to /tmp and loaded
+ *   mmap  - Config.Load
+ *   fgets - a copy of the previous loader: 256-byte fgets, trim, two
+ *           strdup per entry, into a plain array (no index, so it is
+ *           flattered here)
+ * Reported: load time, MB/s, entries and how many of the long values came
+ * back cut short.
+ *
+ * Usage: ./bench/bench_load [megabytes]
+ */
+#include "easy_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_LINE_LEN 256
+
+typedef struct {
+    char* key;
+    char* value;
+} OldEntry;
+
+static FILE* out;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char* trim(char* str) {
+    char* end;
+    while (isspace((unsigned char)*str)) str++;
+    if (*str == 0) return str;
+    end = str + strlen(str) - 1;
+    while (end > str && isspace((unsigned char)*end)) end--;
+    *(end + 1) = 0;
+    return str;
+}
+
+static int old_load(const char* filename, OldEntry** result) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return -1;
+
+    OldEntry* entries = NULL;
+    int count = 0, cap = 0;
+    char line[MAX_LINE_LEN];
+    while (fgets(line, sizeof(line), file)) {
+        char* start = trim(line);
+        if (*start == '#' || *start == '\0') continue;
+        char* delimiter = strchr(start, '=');
+        if (!delimiter) continue;
+        *delimiter = '\0';
+        if (count == cap) {
+            cap = cap ? cap * 2 : 64;
+            entries = realloc(entries, cap * sizeof(OldEntry));
+        }
+        entries[count].key = strdup(trim(start));
+        entries[count].value = strdup(trim(delimiter + 1));
+        count++;
+    }
+    fclose(file);
+    *result = entries;
+    return count;
+}
+
+static long write_config(const char* path, long bytes) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    char long_val[401];
+    memset(long_val, 'v', 400);
+    long_val[400] = '\0';
+
+    long written = 0, lines = 0;
+    while (written < bytes) {
+        int n = (lines % 100 == 99)
+              ? fprintf(f, "group.%ld.key%ld = %s\n", lines / 64, lines, long_val)
+              : fprintf(f, "group.%ld.key%ld = value_%ld\n", lines / 64, lines, lines * 7919);
+        if (n < 0) break;
+        written += n;
+        lines++;
+    }
+    if (fclose(f) != 0) return -1;
+    return written;
+}
+
+int main(int argc, char** argv) {
+    int mb = (argc > 1) ? atoi(argv[1]) : 100;
+    if (mb <= 0) mb = 100;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/bench_load_%d.conf", (int)getpid());
+    long bytes = write_config(path, (long)mb << 20);
+    if (bytes < 0) {
+        perror("bench_load: write config");
+        return 1;
+    }
+
+    // Warm the page cache so both parsers read from memory
+    OldEntry* old;
+    int old_count = old_load(path, &old);
+    for (int i = 0; i < old_count; i++) {
+        free(old[i].key);
+        free(old[i].value);
+    }
+    free(old);
+
+    fprintf(out, "%-6s %10s %9s %10s %10s\n", "parser", "load ms", "MB/s", "entries", "truncated");
+
+    double t0 = now_s();
+    bool loaded = Config.Load(path);
+    double elapsed = now_s() - t0;
+    long found = 0, truncated = 0;
+    char key[64];
+    for (long i = 0; loaded; i++) {
+        snprintf(key, sizeof(key), "group.%ld.key%ld", i / 64, i);
+        const char* val = Config.GetString(key, NULL);
+        if (!val) break;
+        truncated += (i % 100 == 99 && strlen(val) != 400);
+        found++;
+    }
+    fprintf(out, "%-6s %10.1f %9.1f %10ld %10ld\n", "mmap", elapsed * 1e3, bytes / elapsed / 1e6, found, truncated);
+    Config.Cleanup();
+
+    t0 = now_s();
+    old_count = old_load(path, &old);
+    elapsed = now_s() - t0;
+    truncated = 0;
+    for (int i = 0; i < old_count; i++) truncated += (strncmp(old[i].value, "vvvv", 4) == 0 && strlen(old[i].value) != 400);
+    fprintf(out, "%-6s %10.1f %9.1f %10d %10ld\n", "fgets", elapsed * 1e3, bytes / elapsed / 1e6, old_count, truncated);
+    for (int i = 0; i < old_count; i++) {
+        free(old[i].key);
+        free(old[i].value);
+    }
+    free(old);
+
+    unlink(path);
+    fclose(out);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+ * Config lookups/sec: hash index vs. the old linear strcmp scan.
+ *
+ * For 100, 10k and 1M keys a config file of "service.section.keyN = N"
+ * lines is written to /tmp and loaded with Config.Load. Random existing
+ * keys (and a share of missing ones) are then looked up through
+ *   hash - Config.GetInt
+ *   scan - a copy of the previous GetString loop over the same pairs
+ * Each side runs for about half a second; the scan is what the library did
+ * before the index, kept here only as the baseline.
+ *
+ * Usage: ./bench/bench_lookup [seconds per run]
+ */
+#include "easy_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KEYS      4096   // Distinct lookup keys per run
+#define MISS_RATE 8      // One lookup in MISS_RATE asks for an absent key
+
+typedef struct {
+    char* key;
+    char* value;
+} ScanEntry;
+
+static FILE* out;
+static ScanEntry* scan_entries;
+static int scan_count;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static const char* scan_get(const char* key, const char* default_val) {
+    for (int i = 0; i < scan_count; i++) {
+        if (strcmp(scan_entries[i].key, key) == 0) return scan_entries[i].value;
+    }
+    return default_val;
+}
+
+static int scan_get_int(const char* key, int default_val) {
+    const char* val = scan_get(key, NULL);
+    return val ? atoi(val) : default_val;
+}
+
+static bool write_config(const char* path, int count) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "# generated by bench_lookup\n");
+    for (int i = 0; i < count; i++) fprintf(f, "service.section.key%d = %d\n", i, i);
+    return fclose(f) == 0;
+}
+
+// Returns lookups/sec; *checksum guards against the loop being optimised away
+static double run(bool hashed, char** keys, double seconds, long* checksum) {
+    long lookups = 0, sum = 0;
+    double t0 = now_s(), elapsed;
+    do {
+        for (int i = 0; i < KEYS; i++) {
+            sum += hashed ? Config.GetInt(keys[i], -1) : scan_get_int(keys[i], -1);
+            // The scan at 1M keys takes ms per lookup: check the clock often
+            if (!hashed && (i & 15) == 15 && now_s() - t0 > seconds) {
+                lookups += i + 1;
+                goto done;
+            }
+        }
+        lookups += KEYS;
+    } while (now_s() - t0 < seconds);
+done:
+    elapsed = now_s() - t0;
+    *checksum = sum;
+    return lookups / elapsed;
+}
+
+static void bench(int count, double seconds) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/bench_lookup_%d.conf", (int)getpid());
+    if (!write_config(path, count)) {
+        perror("bench_lookup: write config");
+        return;
+    }
+
+    double t0 = now_s();
+    bool loaded = Config.Load(path);
+    double load_ms = (now_s() - t0) * 1e3;
+    unlink(path);
+    if (!loaded) return;
+
+    scan_entries = malloc(count * sizeof(ScanEntry));
+    for (int i = 0; i < count; i++) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "service.section.key%d", i);
+        scan_entries[i].key = strdup(buf);
+        snprintf(buf, sizeof(buf), "%d", i);
+        scan_entries[i].value = strdup(buf);
+    }
+    scan_count = count;
+
+    char** keys = malloc(KEYS * sizeof(char*));
+    srand(count);
+    for (int i = 0; i < KEYS; i++) {
+        char buf[64];
+        int n = rand() % count;
+        snprintf(buf, sizeof(buf), (i % MISS_RATE) ? "service.section.key%d" : "service.section.missing%d", n);
+        keys[i] = strdup(buf);
+    }
+
+    long hash_sum, scan_sum;
+    double hash_rate = run(true, keys, seconds, &hash_sum);
+    double scan_rate = run(false, keys, seconds, &scan_sum);
+
+    fprintf(out, "%9d %10.1f %14.0f %14.0f %9.0fx\n", count, load_ms, hash_rate, scan_rate,
+            hash_rate / scan_rate);
+
+    for (int i = 0; i < KEYS; i++) free(keys[i]);
+    free(keys);
+    for (int i = 0; i < count; i++) {
+        free(scan_entries[i].key);
+        free(scan_entries[i].value);
+    }
+    free(scan_entries);
+    Config.Cleanup();
+}
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1) ? atof(argv[1]) : 0.5;
+    if (seconds <= 0) seconds = 0.5;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    fprintf(out, "%9s %10s %14s %14s %10s\n", "keys", "load ms", "hash/s", "scan/s", "speedup");
+    int counts[] = { 100, 10000, 1000000 };
+    for (int i = 0; i < 3; i++) bench(counts[i], seconds);
+
+    fclose(out);
+    return 0;
+}
\ No newline at end of file
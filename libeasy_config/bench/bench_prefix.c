@@ -0,0 +1,145 @@
+/*
+ * Prefix enumeration on a sectioned config: sorted index vs. linear scan.
+ *
+ * The config has [serial.portN] sections of "paramM = value" lines
+ * (100k keys by default, 100 per section). Queries:
+ *   section - "serial.portN." (100 keys)
+ *   key     - "serial.portN.paramM" (1 key; M >= 10 so no param1 vs param10)
+ *   wide    - "serial.port1" (every section whose number starts with 1)
+ * each through Config.ForEach and through a strncmp scan over every key,
+ * which is what hierarchy-by-prefix cost before the index. The first
+ * ForEach after a load builds the index; that time is reported separately.
+ *
+ * Usage: ./bench/bench_prefix [keys]
+ */
+#include "easy_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PER_SECTION 100
+
+typedef struct {
+    char** keys;
+    int count;
+} KeyList;
+
+static FILE* out;
+static int sections;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool count_key(const char* key, const char* value, void* ctx) {
+    (void)key;
+    (void)value;
+    (*(long*)ctx)++;
+    return true;
+}
+
+static bool collect_key(const char* key, const char* value, void* ctx) {
+    (void)value;
+    KeyList* list = ctx;
+    list->keys[list->count++] = strdup(key);
+    return true;
+}
+
+static long scan(const KeyList* list, const char* prefix) {
+    size_t len = strlen(prefix);
+    long found = 0;
+    for (int i = 0; i < list->count; i++) found += (strncmp(list->keys[i], prefix, len) == 0);
+    return found;
+}
+
+static void make_prefix(char* buf, size_t size, const char* kind, int n) {
+    if (strcmp(kind, "section") == 0) {
+        snprintf(buf, size, "serial.port%d.", n % sections);
+    } else if (strcmp(kind, "key") == 0) {
+        snprintf(buf, size, "serial.port%d.param%d", n % sections, 10 + n % (PER_SECTION - 10));
+    } else {
+        snprintf(buf, size, "serial.port1");
+    }
+}
+
+static void run(const char* kind, const KeyList* list) {
+    char prefix[64];
+    long indexed = 0, scanned = 0;
+    int queries = 0;
+
+    srand(7);
+    double t0 = now_s();
+    do {
+        for (int i = 0; i < 256; i++) {
+            make_prefix(prefix, sizeof(prefix), kind, rand());
+            Config.ForEach(prefix, count_key, &indexed);
+        }
+        queries += 256;
+    } while (now_s() - t0 < 0.3);
+    double index_rate = queries / (now_s() - t0);
+
+    int scans = 0;
+    srand(7);
+    t0 = now_s();
+    do {
+        make_prefix(prefix, sizeof(prefix), kind, rand());
+        scanned += scan(list, prefix);
+        scans++;
+    } while (now_s() - t0 < 0.3);
+    double scan_rate = scans / (now_s() - t0);
+
+    fprintf(out, "%-8s %9.0f %12.0f %12.0f %9.0fx%s\n", kind, (double)indexed / queries, index_rate, scan_rate,
+            index_rate / scan_rate, (indexed / queries == scanned / scans) ? "" : "  MISMATCH");
+}
+
+int main(int argc, char** argv) {
+    int keys = (argc > 1) ? atoi(argv[1]) : 100000;
+    if (keys < PER_SECTION) keys = 100000;
+    sections = keys / PER_SECTION;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/bench_prefix_%d.conf", (int)getpid());
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        perror("bench_prefix: write config");
+        return 1;
+    }
+    // Sections in shuffled order, so the file is not already sorted
+    for (int s = 0; s < sections; s++) {
+        fprintf(f, "[serial.port%d]\n", (int)(((long)s * 7919) % sections));
+        for (int k = 0; k < PER_SECTION; k++) fprintf(f, "param%d = %d\n", k, s * k);
+    }
+    fclose(f);
+
+    double t0 = now_s();
+    bool loaded = Config.Load(path);
+    double load = now_s() - t0;
+    unlink(path);
+    if (!loaded) return 1;
+
+    KeyList list = { malloc(keys * sizeof(char*)), 0 };
+    t0 = now_s();
+    Config.ForEach("", collect_key, &list);
+    double build = now_s() - t0;
+
+    fprintf(out, "%d keys in %d sections: load %.1f ms, first ForEach (sorts the index) %.1f ms\n",
+            list.count, sections, load * 1e3, build * 1e3);
+    fprintf(out, "%-8s %9s %12s %12s %10s\n", "query", "keys/q", "index q/s", "scan q/s", "speedup");
+    run("section", &list);
+    run("key", &list);
+    run("wide", &list);
+
+    for (int i = 0; i < list.count; i++) free(list.keys[i]);
+    free(list.keys);
+    Config.Cleanup();
+    fclose(out);
+    return 0;
+}
\ No newline at end of file
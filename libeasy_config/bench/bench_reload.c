@@ -0,0 +1,159 @@
+/*
+ * Read-while-reload stress: lookups/sec with and without background reloads.
+ *
+ * Reader threads look up random keys of a 10k-key config loaded with
+ * Config.Watch and call Config.Quiescent every 256 lookups. Each value is
+ * "generation:index"; a reader checks that the index matches the key and
+ * that generations never go backwards, which a torn table or a freed
+ * string would break.
+ *
+ *   steady - no writes to the file
+ *   reload - the file is rewritten (temp file + rename) every 10 ms and
+ *            picked up by the watcher thread
+ *
+ * Reported: lookups/s per phase, lookups per second of reader CPU time
+ * (wall-clock throughput also drops by whatever CPU the writer and watcher
+ * take from the readers), reloads the readers saw, and errors.
+ *
+ * Usage: ./bench/bench_reload [readers] [seconds per phase]
+ */
+#include "easy_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define KEYS        10000
+#define MAX_READERS 64
+#define REWRITE_US  10000
+
+typedef struct {
+    pthread_t thread;
+    unsigned seed;
+    long lookups;
+    long cpu_ns;         // Reader thread CPU time
+    long errors;
+    long generation;     // Highest generation seen
+} Reader;
+
+static FILE* out;
+static char path[64];
+static bool stop;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+static bool write_config(long generation) {
+    char tmp[80];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* f = fopen(tmp, "w");
+    if (!f) return false;
+    for (int i = 0; i < KEYS; i++) fprintf(f, "node.%d.setting = %ld:%d\n", i, generation, i);
+    if (fclose(f) != 0) return false;
+    return rename(tmp, path) == 0;
+}
+
+static void* reader(void* arg) {
+    Reader* r = arg;
+    char key[48];
+    while (!__atomic_load_n(&stop, __ATOMIC_RELAXED)) {
+        for (int n = 0; n < 256; n++) {
+            int i = rand_r(&r->seed) % KEYS;
+            snprintf(key, sizeof(key), "node.%d.setting", i);
+            const char* val = Config.GetString(key, NULL);
+            char* end;
+            long g = val ? strtol(val, &end, 10) : -1;
+            if (g < r->generation || *end != ':' || atoi(end + 1) != i) {
+                r->errors++;
+            } else {
+                r->generation = g;
+            }
+        }
+        __atomic_store_n(&r->lookups, r->lookups + 256, __ATOMIC_RELAXED);
+        __atomic_store_n(&r->cpu_ns, thread_cpu_ns(), __ATOMIC_RELAXED);
+        Config.Quiescent();
+    }
+    return NULL;
+}
+
+static long total_lookups(Reader* readers, int count, long* cpu_ns) {
+    long sum = 0;
+    *cpu_ns = 0;
+    for (int i = 0; i < count; i++) {
+        sum += __atomic_load_n(&readers[i].lookups, __ATOMIC_RELAXED);
+        *cpu_ns += __atomic_load_n(&readers[i].cpu_ns, __ATOMIC_RELAXED);
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    int count = (argc > 1) ? atoi(argv[1]) : 4;
+    double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+    if (count <= 0 || count > MAX_READERS) count = 4;
+    if (seconds <= 0) seconds = 1.0;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    snprintf(path, sizeof(path), "/tmp/bench_reload_%d.conf", (int)getpid());
+    if (!write_config(0) || !Config.Watch(path)) {
+        perror("bench_reload: config");
+        return 1;
+    }
+
+    static Reader readers[MAX_READERS];
+    for (int i = 0; i < count; i++) {
+        readers[i].seed = i + 1;
+        pthread_create(&readers[i].thread, NULL, reader, &readers[i]);
+    }
+
+    // Steady phase
+    long c0, c1;
+    long l0 = total_lookups(readers, count, &c0);
+    double t0 = now_s();
+    usleep((useconds_t)(seconds * 1e6));
+    long l1 = total_lookups(readers, count, &c1);
+    double steady = (l1 - l0) / (now_s() - t0), steady_cpu = (l1 - l0) * 1e9 / (c1 - c0);
+
+    // Reload phase
+    long generation = 0;
+    l0 = total_lookups(readers, count, &c0);
+    t0 = now_s();
+    while (now_s() - t0 < seconds) {
+        if (!write_config(++generation)) break;
+        usleep(REWRITE_US);
+    }
+    l1 = total_lookups(readers, count, &c1);
+    double reloading = (l1 - l0) / (now_s() - t0), reloading_cpu = (l1 - l0) * 1e9 / (c1 - c0);
+
+    usleep(200000); // Let the watcher pick up the last write
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    long errors = 0, seen = 0;
+    for (int i = 0; i < count; i++) {
+        pthread_join(readers[i].thread, NULL);
+        errors += readers[i].errors;
+        seen = (readers[i].generation > seen) ? readers[i].generation : seen;
+    }
+
+    fprintf(out, "%-8s %7s %14s %14s %9s %8s\n", "phase", "readers", "lookups/s", "per cpu-s", "reloads", "errors");
+    fprintf(out, "%-8s %7d %14.0f %14.0f %9s %8s\n", "steady", count, steady, steady_cpu, "-", "-");
+    fprintf(out, "%-8s %7d %14.0f %14.0f %4ld/%-4ld %8ld\n", "reload", count, reloading, reloading_cpu,
+            seen, generation, errors);
+
+    Config.Cleanup();
+    unlink(path);
+    fclose(out);
+    return 0;
+}
\ No newline at end of file
@@ -1,104 +1,356 @@
-#include "easy_config.h"
+#include "easy_config_internal.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-#define MAX_ENTRIES 100
-#define MAX_LINE_LEN 256
-
-// --- Internal Storage ---
-typedef struct {
-    char* key;
-    char* value;
-} ConfigEntry;
-
-static ConfigEntry entries[MAX_ENTRIES];
-static int entry_count = 0;
-
-// --- Helper: Trim whitespace ---
-static char* trim(char* str) {
-    char* end;
-    while(isspace((unsigned char)*str)) str++; // Trim leading
-    if(*str == 0) return str;
-    end = str + strlen(str) - 1;
-    while(end > str && isspace((unsigned char)*end)) end--; // Trim trailing
-    *(end+1) = 0;
+#define MIN_ENTRIES  64
+
+// --- Helper: Trim whitespace from a [start, end) slice ---
+static const char* skip_space(const char* str, const char* end) {
+    while (str < end && isspace((unsigned char)*str)) str++;
     return str;
 }
 
-// --- Helper: Cleanup ---
-static void Config_Cleanup() {
-    for (int i = 0; i < entry_count; i++) {
-        free(entries[i].key);
-        free(entries[i].value);
+static const char* trim_end(const char* start, const char* end) {
+    while (end > start && isspace((unsigned char)end[-1])) end--;
+    return end;
+}
+
+// --- Helper: Hash a key (8 bytes per step, then a final mix) ---
+static uint32_t hash_key(const char* key, size_t len) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ len;
+    while (len >= 8) {
+        uint64_t w;
+        memcpy(&w, key, 8);
+        h = (h ^ w) * 0xFF51AFD7ED558CCDull;
+        h ^= h >> 32;
+        key += 8;
+        len -= 8;
     }
-    entry_count = 0;
+    uint64_t w = 0;
+    memcpy(&w, key, len);
+    h = (h ^ w) * 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 29;
+    return (uint32_t)h ^ (uint32_t)(h >> 32);
 }
 
-// --- Implementation ---
+// --- Helper: Find a key's slot (empty slot if absent) ---
+static ConfigSlot* find_slot(const ConfigSnapshot* snap, const char* key, size_t len, uint32_t hash) {
+    for (uint32_t i = hash;; i++) {
+        ConfigSlot* s = &snap->slots[i & snap->slot_mask];
+        if (s->entry == 0) return s;
+        if (s->hash == hash) {
+            const ConfigEntry* e = &snap->entries[s->entry - 1];
+            if (e->key_len == len && memcmp(snap->arena + e->key, key, len) == 0) return s;
+        }
+    }
+}
 
-static bool Config_Load(const char* filename) {
-    Config_Cleanup(); // Clear old config if reloading
-    
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        perror("EasyConfig: Could not open file");
-        return false;
+// --- Helper: Build the index once all entries are known ---
+// Duplicate keys are dropped while indexing (the first definition wins)
+// and the survivors compacted. Slots are prefetched a few entries ahead:
+// on large files nearly every insert would otherwise miss the cache.
+static bool build_index(ConfigSnapshot* snap) {
+    uint32_t size = MIN_ENTRIES * 2;
+    while (size < (uint32_t)snap->count * 2) size *= 2;
+    snap->slots = calloc(size, sizeof(ConfigSlot));
+    if (!snap->slots) return false;
+    snap->slot_mask = size - 1;
+
+    ConfigEntry* entries = snap->entries;
+    int kept = 0;
+    for (int i = 0; i < snap->count; i++) {
+        if (i + 8 < snap->count) __builtin_prefetch(&snap->slots[entries[i + 8].hash & snap->slot_mask], 1);
+        ConfigEntry e = entries[i];
+        ConfigSlot* s = find_slot(snap, snap->arena + e.key, e.key_len, e.hash);
+        if (s->entry) continue; // Duplicate key
+        entries[kept] = e;
+        s->hash = e.hash;
+        s->entry = (uint32_t)++kept;
+    }
+    snap->count = kept;
+    return true;
+}
+
+// --- Helper: Store one KEY=VALUE pair at the end of the arena ---
+// Keys inside a [section] are stored as "section.key". The arena starts at
+// the file's size, which is enough unless sections lengthen the keys;
+// entries hold offsets, so growing it moves nothing that matters.
+static bool add_entry(ConfigSnapshot* snap, size_t* cap, const char* section, size_t section_len,
+                      const char* key, size_t len, const char* val, size_t val_len) {
+    if (snap->count == snap->cap) {
+        int grow = snap->cap ? snap->cap * 2 : MIN_ENTRIES;
+        ConfigEntry* grown = realloc(snap->entries, grow * sizeof(ConfigEntry));
+        if (!grown) return false;
+        snap->entries = grown;
+        snap->cap = grow;
     }
 
-    char line[MAX_LINE_LEN];
-    while (fgets(line, sizeof(line), file)) {
-        // Skip comments and empty lines
-        char* start = trim(line);
-        if (*start == '#' || *start == '\0') continue;
+    size_t key_len = section_len ? section_len + 1 + len : len;
+    size_t need = snap->arena_len + key_len + val_len + 2;
+    if (need > *cap) {
+        size_t grow = (*cap * 2 > need) ? *cap * 2 : need;
+        char* arena = realloc(snap->arena, grow);
+        if (!arena) return false;
+        snap->arena = arena;
+        *cap = grow;
+    }
 
-        // Find '='
-        char* delimiter = strchr(start, '=');
-        if (!delimiter) continue; // Invalid line
+    char* k = snap->arena + snap->arena_len;
+    if (section_len) {
+        memcpy(k, section, section_len);
+        k[section_len] = '.';
+    }
+    memcpy(k + key_len - len, key, len);
+    k[key_len] = '\0';
+    char* v = k + key_len + 1;
+    memcpy(v, val, val_len);
+    v[val_len] = '\0';
+    snap->arena_len = need;
 
-        // Split and trim
-        *delimiter = '\0'; // Cut string at =
-        char* key = trim(start);
-        char* val = trim(delimiter + 1);
+    ConfigEntry* e = &snap->entries[snap->count++];
+    e->key = (uint64_t)(k - snap->arena);
+    e->value = (uint64_t)(v - snap->arena);
+    e->hash = hash_key(k, key_len);
+    e->key_len = (uint32_t)key_len;
+    easy_config_parse_value(v, val_len, &e->typed);
+    return true;
+}
 
-        if (entry_count < MAX_ENTRIES) {
-            entries[entry_count].key = strdup(key);
-            entries[entry_count].value = strdup(val);
-            entry_count++;
+// --- Helper: Tokenize a whole file image in one pass ---
+static bool parse(ConfigSnapshot* snap, size_t cap, const char* p, const char* end) {
+    const char* section = NULL;
+    size_t section_len = 0;
+    while (p < end) {
+        const char* eol = memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+
+        // Skip comments, empty and invalid lines
+        const char* start = skip_space(p, eol);
+        if (start < eol && *start == '[') {
+            // "[section]" prefixes the keys below it; "[]" goes back to the top
+            const char* close = trim_end(start, eol);
+            if (close - start >= 2 && close[-1] == ']') {
+                section = skip_space(start + 1, close - 1);
+                section_len = trim_end(section, close - 1) - section;
+            }
+            p = eol + 1;
+            continue;
+        }
+        const char* delimiter = (start < eol && *start != '#') ? memchr(start, '=', eol - start) : NULL;
+        if (delimiter) {
+            const char* key_end = trim_end(start, delimiter);
+            const char* val = skip_space(delimiter + 1, eol);
+            const char* val_end = trim_end(val, eol);
+            if (!add_entry(snap, &cap, section, section_len, start, key_end - start, val, val_end - val)) return false;
         }
+        p = eol + 1;
     }
+    return build_index(snap) && easy_config_split_lists(snap);
+}
 
-    fclose(file);
-    printf("EasyConfig: Loaded %d entries from %s\n", entry_count, filename);
-    return true;
+void easy_config_snapshot_free(ConfigSnapshot* snap) {
+    if (!snap) return;
+    if (snap->map) {
+        munmap(snap->map, snap->map_len);
+    } else {
+        free(snap->arena);
+        free(snap->entries);
+        free(snap->slots);
+        free(snap->list_items);
+        free(snap->order);
+    }
+    free(snap);
 }
 
-static const char* Config_GetString(const char* key, const char* default_val) {
-    for (int i = 0; i < entry_count; i++) {
-        if (strcmp(entries[i].key, key) == 0) {
-            return entries[i].value;
+const ConfigEntry* easy_config_find(const ConfigSnapshot* snap, const char* key) {
+    if (!snap || snap->count == 0) return NULL;
+
+    size_t len = strlen(key);
+    ConfigSlot* s = find_slot(snap, key, len, hash_key(key, len));
+    return s->entry ? &snap->entries[s->entry - 1] : NULL;
+}
+
+// --- Helper: Open a file and stat it ---
+static int open_source(const char* filename, struct stat* st) {
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror("EasyConfig: Could not open file");
+        return -1;
+    }
+    if (fstat(fd, st) < 0) {
+        perror("EasyConfig: Could not stat file");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// --- Helper: Parse an open file (closes fd) ---
+static ConfigSnapshot* parse_fd(int fd, const struct stat* st) {
+    size_t size = (size_t)st->st_size;
+    const char* map = NULL;
+    if (size > 0) {
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        if (map == MAP_FAILED) {
+            perror("EasyConfig: Could not map file");
+            close(fd);
+            return NULL;
         }
     }
+    close(fd);
+
+    ConfigSnapshot* snap = calloc(1, sizeof(ConfigSnapshot));
+    bool ok = snap && (snap->arena = malloc(size + 1)) &&
+              (map ? parse(snap, size + 1, map, map + size) : build_index(snap));
+    if (map) munmap((void*)map, size);
+    if (!ok) {
+        perror("EasyConfig: Out of memory");
+        easy_config_snapshot_free(snap);
+        return NULL;
+    }
+    return snap;
+}
+
+ConfigSnapshot* easy_config_parse_file(const char* filename) {
+    struct stat st;
+    int fd = open_source(filename, &st);
+    return (fd < 0) ? NULL : parse_fd(fd, &st);
+}
+
+// --- Helper: Cleanup ---
+static void Config_Cleanup() {
+    easy_config_unwatch();
+    easy_config_release_all();
+}
+
+// --- Implementation ---
+
+static bool Config_Load(const char* filename) {
+    // A failed load leaves no config, as before; readers on other threads
+    // keep the old snapshot until they pass a quiescent point
+    ConfigSnapshot* snap = easy_config_parse_file(filename);
+    int count = snap ? snap->count : 0;
+    easy_config_publish(snap);
+    if (!snap) return false;
+
+    printf("EasyConfig: Loaded %d entries from %s\n", count, filename);
+    return true;
+}
+
+static bool Config_LoadCached(const char* filename, const char* cache_file) {
+    struct stat st;
+    int fd = open_source(filename, &st);
+    if (fd < 0) {
+        easy_config_publish(NULL); // Same as a failed Load
+        return false;
+    }
+
+    ConfigSnapshot* snap = easy_config_cache_map(cache_file, &st);
+    bool cached = snap != NULL;
+    if (cached) {
+        close(fd);
+    } else {
+        snap = parse_fd(fd, &st);
+        // Without a usable cache the text is still good: just log it
+        if (snap && !easy_config_cache_write(snap, cache_file, &st)) perror("EasyConfig: Could not write cache");
+    }
+
+    int count = snap ? snap->count : 0;
+    easy_config_publish(snap);
+    if (!snap) return false;
+
+    printf("EasyConfig: Loaded %d entries from %s%s\n", count, cached ? cache_file : filename,
+           cached ? " (cache)" : "");
+    return true;
+}
+
+static const char* Config_GetString(const char* key, const char* default_val) {
+    const ConfigSnapshot* snap = easy_config_current();
+    const ConfigEntry* e = easy_config_find(snap, key);
+    return e ? snap->arena + e->value : default_val;
+}
+
+// --- Helper: Typed lookup ---
+static const ConfigValue* find_value(const char* key, ConfigStatus_t* status) {
+    const ConfigEntry* e = easy_config_find(easy_config_current(), key);
+    if (status) *status = e ? CONFIG_OK : CONFIG_MISSING;
+    return e ? &e->typed : NULL;
+}
+
+static ConfigStatus_t set_status(ConfigStatus_t* status, ConfigStatus_t result) {
+    if (status) *status = result;
+    return result;
+}
+
+static int64_t Config_GetInt64(const char* key, int64_t default_val, ConfigStatus_t* status) {
+    const ConfigValue* v = find_value(key, status);
+    if (!v) return default_val;
+    if (v->types & CONFIG_T_INT) return v->i;
+    set_status(status, (v->types & CONFIG_T_RANGE) ? CONFIG_OUT_OF_RANGE : CONFIG_BAD_VALUE);
+    return default_val;
+}
+
+static double Config_GetDouble(const char* key, double default_val, ConfigStatus_t* status) {
+    const ConfigValue* v = find_value(key, status);
+    if (!v) return default_val;
+    if (v->types & CONFIG_T_DOUBLE) return v->num;
+    set_status(status, CONFIG_BAD_VALUE);
     return default_val;
 }
 
+static int64_t Config_GetSize(const char* key, int64_t default_val, ConfigStatus_t* status) {
+    const ConfigValue* v = find_value(key, status);
+    int64_t bytes;
+    if (!v || set_status(status, easy_config_to_size(v, &bytes)) != CONFIG_OK) return default_val;
+    return bytes;
+}
+
+static int64_t Config_GetDuration(const char* key, int64_t default_ns, ConfigStatus_t* status) {
+    const ConfigValue* v = find_value(key, status);
+    int64_t ns;
+    if (!v || set_status(status, easy_config_to_duration(v, &ns)) != CONFIG_OK) return default_ns;
+    return ns;
+}
+
+static int Config_GetList(const char* key, const char** items, int max_items) {
+    const ConfigSnapshot* snap = easy_config_current();
+    const ConfigEntry* e = easy_config_find(snap, key);
+    if (!e) return -1;
+
+    const ConfigValue* v = &e->typed;
+    if (v->list_count == 1 && max_items > 0) items[0] = snap->arena + e->value;
+    for (uint32_t i = 0; v->list_count > 1 && i < v->list_count && (int)i < max_items; i++) {
+        items[i] = snap->arena + snap->list_items[v->list + i];
+    }
+    return (int)v->list_count;
+}
+
 static int Config_GetInt(const char* key, int default_val) {
-    const char* val = Config_GetString(key, NULL);
-    if (!val) return default_val;
-    return atoi(val);
+    int64_t val = Config_GetInt64(key, default_val, NULL);
+    return (val < INT_MIN || val > INT_MAX) ? default_val : (int)val;
 }
 
 static bool Config_GetBool(const char* key, bool default_val) {
-    const char* val = Config_GetString(key, NULL);
-    if (!val) return default_val;
-    
-    if (strcasecmp(val, "true") == 0 || 
-        strcasecmp(val, "yes") == 0 || 
-        strcmp(val, "1") == 0) {
-        return true;
+    const ConfigValue* v = find_value(key, NULL);
+    if (!v || !(v->types & CONFIG_T_BOOL)) return default_val;
+    return (v->types & CONFIG_T_TRUE) != 0;
+}
+
+static const char* Config_StatusString(ConfigStatus_t status) {
+    switch (status) {
+        case CONFIG_OK:           return "ok";
+        case CONFIG_MISSING:      return "missing";
+        case CONFIG_BAD_VALUE:    return "bad value";
+        case CONFIG_OUT_OF_RANGE: return "out of range";
     }
-    return false;
+    return "unknown";
 }
 
 // --- Interface Mapping ---
@@ -107,5 +359,16 @@ const EasyConfig_t Config = {
     .GetString = Config_GetString,
     .GetInt = Config_GetInt,
     .GetBool = Config_GetBool,
-    .Cleanup = Config_Cleanup
+    .GetInt64 = Config_GetInt64,
+    .GetDouble = Config_GetDouble,
+    .GetSize = Config_GetSize,
+    .GetDuration = Config_GetDuration,
+    .GetList = Config_GetList,
+    .ForEach = easy_config_for_each,
+    .StatusString = Config_StatusString,
+    .LoadCached = Config_LoadCached,
+    .Cleanup = Config_Cleanup,
+    .Watch = easy_config_watch,
+    .Unwatch = easy_config_unwatch,
+    .Quiescent = easy_config_quiescent
 };
\ No newline at end of file
@@ -2,12 +2,26 @@
 #define EASY_CONFIG_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+// Outcome of a typed lookup
+typedef enum {
+    CONFIG_OK = 0,
+    CONFIG_MISSING,        // Key not present
+    CONFIG_BAD_VALUE,      // Present, but not of the requested type
+    CONFIG_OUT_OF_RANGE    // Right type, but does not fit the result
+} ConfigStatus_t;
+
+// Called by ForEach for every matching key, in key order; return false to stop
+typedef bool (*ConfigVisit_t)(const char* key, const char* value, void* ctx);
 
 typedef struct {
     /**
      * @brief Loads a configuration file into memory.
      * Supports format: KEY=VALUE
-     * Lines starting with # are comments.
+     * Lines starting with # are comments. Lines and files may be any length.
+     * A "[section]" line prefixes the keys after it, so "baud" under
+     * "[serial.port3]" is read as "serial.port3.baud"; "[]" ends it.
      * @param filename Path to the config file (e.g., "server.conf")
      * @return true if loaded successfully, false otherwise.
      */
@@ -17,29 +31,114 @@ typedef struct {
      * @brief Get a string value.
      * @param key The key to look for (case-sensitive).
      * @param default_val Value to return if key is not found.
-     * @return The value from the file, or default_val.
+     * @return The value from the file, or default_val. After a reload the
+     *         string stays valid until this thread calls Quiescent, Load
+     *         or Cleanup.
      */
     const char* (*GetString)(const char* key, const char* default_val);
 
     /**
      * @brief Get an integer value.
      * @param key The key to look for.
-     * @param default_val Value to return if key is not found.
+     * @param default_val Value to return if key is not found, is not an
+     *        integer or does not fit an int.
      * @return The integer value.
      */
     int (*GetInt)(const char* key, int default_val);
 
     /**
      * @brief Get a boolean value.
-     * Handles "true", "yes", "1" as true.
+     * Handles "true", "yes", "on", "1" as true and "false", "no", "off",
+     * "0" as false (any case); anything else returns default_val.
      */
     bool (*GetBool)(const char* key, bool default_val);
 
+    /*
+     * Typed getters. Values are parsed once when the file is loaded, so
+     * these only copy out the result. Each returns default_val unless
+     * *status (may be NULL) is set to CONFIG_OK.
+     */
+
+    /**
+     * @brief Get a 64-bit integer (decimal, or hex with 0x).
+     */
+    int64_t (*GetInt64)(const char* key, int64_t default_val, ConfigStatus_t* status);
+
+    /**
+     * @brief Get a floating-point value.
+     */
+    double (*GetDouble)(const char* key, double default_val, ConfigStatus_t* status);
+
+    /**
+     * @brief Get a size in bytes: "4096", "64K", "1.5M", "2GiB" (binary
+     * multiples; suffixes K, M, G, T with optional B or iB, any case).
+     */
+    int64_t (*GetSize)(const char* key, int64_t default_val, ConfigStatus_t* status);
+
+    /**
+     * @brief Get a duration in nanoseconds: "250ms", "1.5s", "2m", "1h";
+     * units ns, us, ms, s, m/min, h, d. A bare number is only accepted for 0.
+     */
+    int64_t (*GetDuration)(const char* key, int64_t default_ns, ConfigStatus_t* status);
+
+    /**
+     * @brief Get a comma-separated list, each item trimmed.
+     * @param items Receives up to max_items pointers, valid like GetString.
+     * @return Number of items in the value (may exceed max_items), or -1
+     *         if the key is not found. An empty value has 0 items.
+     */
+    int (*GetList)(const char* key, const char** items, int max_items);
+
+    /**
+     * @brief Visits every key that starts with prefix, in sorted order,
+     * e.g. "serial." for everything under [serial]. Matching is by bytes,
+     * so include the trailing dot to stay within one section. Uses a
+     * sorted index built on the first call after each load.
+     * @return Number of keys visited.
+     */
+    int (*ForEach)(const char* prefix, ConfigVisit_t visit, void* ctx);
+
+    /**
+     * @brief Short description of a status, for log messages.
+     */
+    const char* (*StatusString)(ConfigStatus_t status);
+
+    /**
+     * @brief Like Load, but keeps a compiled binary copy of the file in
+     * cache_file. When the cache matches the file's size, mtime and inode
+     * it is mapped directly with no parsing; otherwise the text is parsed
+     * and the cache rewritten. The cache is native-endian and only meant
+     * for the machine that wrote it.
+     */
+    bool (*LoadCached)(const char* filename, const char* cache_file);
+
     /**
      * @brief Frees the memory used by the loaded config.
      */
     void (*Cleanup)(void);
 
+    /**
+     * @brief Loads a file and reloads it in the background whenever it is
+     * rewritten or replaced (inotify). Readers keep the previous contents
+     * until the new file has been parsed completely; a file that fails to
+     * load is ignored. Cleanup or Unwatch stops the watcher.
+     * @return true if the initial load and the watch succeeded.
+     */
+    bool (*Watch)(const char* filename);
+
+    /**
+     * @brief Stops the background reload started by Watch.
+     */
+    void (*Unwatch)(void);
+
+    /**
+     * @brief Tells the library this thread holds no strings returned by
+     * GetString. Replaced configs are freed once every reading thread has
+     * called this (or exited), so long-lived readers should call it
+     * regularly, e.g. once per main-loop iteration.
+     */
+    void (*Quiescent)(void);
+
 } EasyConfig_t;
 
 extern const EasyConfig_t Config;
@@ -0,0 +1,192 @@
+#include "easy_config_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Compiled cache: a snapshot's own arrays written back to back, so mapping
+ * the file is the whole load. Entries already hold arena offsets rather
+ * than pointers, and both indexes are stored as built.
+ *
+ *   header | entries | slots | sorted order | list items | arena
+ *
+ * The header records the source file's size, mtime, inode and device;
+ * any difference makes the cache stale and it is rebuilt from the text.
+ */
+
+#define CACHE_MAGIC    "EZCFGBIN"
+#define CACHE_VERSION  2
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_size;       // sizeof(ConfigEntry), a cheap layout check
+    uint64_t src_size;
+    int64_t src_mtime_sec;
+    int64_t src_mtime_nsec;
+    uint64_t src_ino;
+    uint64_t src_dev;
+    uint64_t count;
+    uint64_t slot_count;
+    uint64_t list_count;
+    uint64_t arena_len;
+    uint64_t entries_off;
+    uint64_t slots_off;
+    uint64_t order_off;
+    uint64_t lists_off;
+    uint64_t arena_off;
+    uint64_t file_len;
+} CacheHeader;
+
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~(uint64_t)7;
+}
+
+static void describe_source(CacheHeader* h, const struct stat* src) {
+    h->src_size = (uint64_t)src->st_size;
+    h->src_mtime_sec = src->st_mtim.tv_sec;
+    h->src_mtime_nsec = src->st_mtim.tv_nsec;
+    h->src_ino = src->st_ino;
+    h->src_dev = src->st_dev;
+}
+
+// --- Helper: Offsets of every section for a snapshot's sizes ---
+static void layout(CacheHeader* h) {
+    h->entries_off = align8(sizeof(CacheHeader));
+    h->slots_off = align8(h->entries_off + h->count * sizeof(ConfigEntry));
+    h->order_off = h->slots_off + h->slot_count * sizeof(ConfigSlot);
+    h->lists_off = align8(h->order_off + h->count * sizeof(uint32_t));
+    h->arena_off = h->lists_off + h->list_count * sizeof(uint64_t);
+    h->file_len = h->arena_off + h->arena_len;
+}
+
+static bool write_at(int fd, const void* buf, size_t len, uint64_t offset) {
+    const char* p = buf;
+    while (len > 0) {
+        ssize_t n = pwrite(fd, p, len, (off_t)offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return true;
+}
+
+bool easy_config_cache_write(const ConfigSnapshot* snap, const char* cache_file, const struct stat* src) {
+    CacheHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CACHE_MAGIC, sizeof(h.magic));
+    h.version = CACHE_VERSION;
+    h.entry_size = sizeof(ConfigEntry);
+    describe_source(&h, src);
+    h.count = (uint64_t)snap->count;
+    h.slot_count = (uint64_t)snap->slot_mask + 1;
+    h.list_count = snap->list_count;
+    h.arena_len = snap->arena_len;
+    layout(&h);
+
+    // The prefix index is normally built on demand; a cache always has it
+    const uint32_t* order = easy_config_sorted(snap);
+    if (!order && snap->count > 0) return false;
+
+    // Written beside the target and renamed over it, so a reader never
+    // maps a half-written cache
+    char tmp[4096];
+    if (snprintf(tmp, sizeof(tmp), "%s.%d.tmp", cache_file, (int)getpid()) >= (int)sizeof(tmp)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    bool ok = ftruncate(fd, (off_t)h.file_len) == 0 &&
+              write_at(fd, &h, sizeof(h), 0) &&
+              write_at(fd, snap->entries, h.count * sizeof(ConfigEntry), h.entries_off) &&
+              write_at(fd, snap->slots, h.slot_count * sizeof(ConfigSlot), h.slots_off) &&
+              write_at(fd, order, h.count * sizeof(uint32_t), h.order_off) &&
+              write_at(fd, snap->list_items, h.list_count * sizeof(uint64_t), h.lists_off) &&
+              write_at(fd, snap->arena, h.arena_len, h.arena_off);
+    if (close(fd) < 0) ok = false;
+    if (ok && rename(tmp, cache_file) == 0) return true;
+
+    int saved = errno;
+    unlink(tmp);
+    errno = saved;
+    return false;
+}
+
+// --- Helper: Header sanity, so a foreign or damaged file is just stale ---
+static bool header_valid(const CacheHeader* h, const struct stat* src, uint64_t file_len) {
+    CacheHeader expect = *h;
+    describe_source(&expect, src);
+    layout(&expect);
+
+    return memcmp(h->magic, CACHE_MAGIC, sizeof(h->magic)) == 0 &&
+           h->version == CACHE_VERSION &&
+           h->entry_size == sizeof(ConfigEntry) &&
+           h->src_size == expect.src_size &&
+           h->src_mtime_sec == expect.src_mtime_sec &&
+           h->src_mtime_nsec == expect.src_mtime_nsec &&
+           h->src_ino == expect.src_ino &&
+           h->src_dev == expect.src_dev &&
+           h->count <= INT32_MAX &&
+           h->slot_count >= 2 && h->slot_count <= ((uint64_t)1 << 32) &&
+           (h->slot_count & (h->slot_count - 1)) == 0 &&
+           h->count * 2 <= h->slot_count &&
+           h->list_count <= UINT32_MAX &&
+           h->arena_len <= file_len &&
+           h->entries_off == expect.entries_off &&
+           h->slots_off == expect.slots_off &&
+           h->order_off == expect.order_off &&
+           h->lists_off == expect.lists_off &&
+           h->arena_off == expect.arena_off &&
+           h->file_len == expect.file_len &&
+           h->file_len == file_len;
+}
+
+ConfigSnapshot* easy_config_cache_map(const char* cache_file, const struct stat* src) {
+    int fd = open(cache_file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL; // No cache yet
+
+    struct stat st;
+    CacheHeader h;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(h) ||
+        pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+        !header_valid(&h, src, (uint64_t)st.st_size)) {
+        close(fd);
+        return NULL;
+    }
+
+    // Nothing is read up front: pages fault in as lookups touch them,
+    // while WILLNEED starts readahead of the rest in the background
+    char* map = mmap(NULL, h.file_len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+    madvise(map, h.file_len, MADV_WILLNEED);
+
+    ConfigSnapshot* snap = calloc(1, sizeof(ConfigSnapshot));
+    if (!snap) {
+        munmap(map, h.file_len);
+        return NULL;
+    }
+    snap->map = map;
+    snap->map_len = h.file_len;
+    snap->arena = map + h.arena_off;
+    snap->arena_len = h.arena_len;
+    snap->entries = (ConfigEntry*)(map + h.entries_off);
+    snap->count = snap->cap = (int)h.count;
+    snap->slots = (ConfigSlot*)(map + h.slots_off);
+    snap->slot_mask = (uint32_t)(h.slot_count - 1);
+    snap->order = (h.count > 0) ? (uint32_t*)(map + h.order_off) : NULL;
+    snap->list_items = (uint64_t*)(map + h.lists_off);
+    snap->list_count = (uint32_t)h.list_count;
+    return snap;
+}
\ No newline at end of file
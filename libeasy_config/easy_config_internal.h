@@ -0,0 +1,107 @@
+#ifndef EASY_CONFIG_INTERNAL_H
+#define EASY_CONFIG_INTERNAL_H
+
+/*
+ * Helpers shared between the library's source files.
+ * Not installed; applications only need easy_config.h.
+ */
+
+#include "easy_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Bits of ConfigValue.types: the forms a value parsed as at load time
+#define CONFIG_T_INT       0x01
+#define CONFIG_T_DOUBLE    0x02
+#define CONFIG_T_BOOL      0x04
+#define CONFIG_T_TRUE      0x08   // Bool value, with CONFIG_T_BOOL
+#define CONFIG_T_NUMBER    0x10   // Number (+ unit suffix) in 'num'
+#define CONFIG_T_RANGE     0x20   // Integer syntax but does not fit int64
+
+// ConfigValue.unit: size shift (KiB = 10, ...) in the low nibble as an
+// index, duration unit in the high nibble; 0 = no suffix, 0xF = not a unit
+#define CONFIG_UNIT_NONE   0x0
+#define CONFIG_UNIT_BAD    0xF
+
+// Pre-parsed forms of a value, filled once per load
+typedef struct {
+    int64_t i;
+    double num;          // Number before any unit suffix
+    uint32_t list;       // First item in list_items, for values with commas
+    uint32_t list_count;
+    uint8_t types;       // CONFIG_T_*
+    uint8_t unit;
+} ConfigValue;
+
+// Keys and values are NUL-terminated slices of one arena filled at load
+// time, stored as offsets so a snapshot can also live in a mapped cache.
+typedef struct {
+    uint64_t key;        // Offsets into the arena
+    uint64_t value;
+    uint32_t hash;       // Cached so lookups and rehashing never rehash keys
+    uint32_t key_len;
+    ConfigValue typed;
+} ConfigEntry;
+
+// Open-addressing index over the entries, kept at most half full.
+// Each slot holds the key's hash and entry number + 1 (0 = empty), so a
+// probe only touches an entry's key when the full hash matches.
+typedef struct {
+    uint32_t hash;
+    uint32_t entry;
+} ConfigSlot;
+
+// One parsed file. Never modified once published, so readers need no lock.
+typedef struct ConfigSnapshot {
+    char* arena;
+    size_t arena_len;
+    ConfigEntry* entries;
+    int count;
+    int cap;
+    ConfigSlot* slots;
+    uint32_t slot_mask;
+    uint64_t* list_items;          // Arena offsets of list items
+    uint32_t list_count;
+    uint32_t* order;               // Entries sorted by key, built on first use
+    void* map;                     // Cache mapping holding all of the above
+    size_t map_len;
+    uint64_t retired;              // Epoch at which a reload replaced it
+    struct ConfigSnapshot* next;   // Retired list
+} ConfigSnapshot;
+
+// --- Parsing and lookup (easy_config.c) ---
+ConfigSnapshot* easy_config_parse_file(const char* filename);
+void easy_config_snapshot_free(ConfigSnapshot* snap);
+const ConfigEntry* easy_config_find(const ConfigSnapshot* snap, const char* key);
+
+// --- Typed values (easy_config_value.c) ---
+void easy_config_parse_value(const char* val, size_t len, ConfigValue* v);
+// Copies the items of comma-separated values into the arena (may move it)
+bool easy_config_split_lists(ConfigSnapshot* snap);
+ConfigStatus_t easy_config_to_size(const ConfigValue* v, int64_t* out);
+ConfigStatus_t easy_config_to_duration(const ConfigValue* v, int64_t* out);
+
+// --- Prefix index (easy_config_prefix.c) ---
+// Entry numbers in key order; NULL only if out of memory
+const uint32_t* easy_config_sorted(const ConfigSnapshot* snap);
+int easy_config_for_each(const char* prefix, ConfigVisit_t visit, void* ctx);
+
+// --- Binary cache (easy_config_cache.c) ---
+struct stat;
+ConfigSnapshot* easy_config_cache_map(const char* cache_file, const struct stat* src);
+bool easy_config_cache_write(const ConfigSnapshot* snap, const char* cache_file, const struct stat* src);
+
+// --- Publication and reclamation (easy_config_reload.c) ---
+// The current snapshot for a lookup; registers the calling thread as a
+// reader on first use. NULL when nothing is loaded.
+const ConfigSnapshot* easy_config_current(void);
+// Swap in 'snap' (may be NULL); the old one is freed once every reader
+// has passed a quiescent point. The caller counts as quiescent.
+void easy_config_publish(ConfigSnapshot* snap);
+void easy_config_quiescent(void);
+bool easy_config_watch(const char* filename);
+void easy_config_unwatch(void);
+// Frees the current and every retired snapshot; no reader may be active
+void easy_config_release_all(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#define _GNU_SOURCE // qsort_r
+#include "easy_config_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Prefix queries go through the entry numbers sorted by key: a binary
+ * search finds the first key >= prefix and the matches follow it. The
+ * order is built lazily, since most services never enumerate, and is
+ * published with a compare-and-swap so readers stay lock-free; a racing
+ * builder just frees its copy.
+ */
+
+typedef struct {
+    uint64_t head;       // First 8 key bytes, big-endian: most compares end here
+    uint32_t entry;
+} SortKey;
+
+static uint64_t key_head(const char* key) {
+    uint64_t head = 0;
+    for (int i = 0; i < 8 && key[i]; i++) head |= (uint64_t)(unsigned char)key[i] << (56 - 8 * i);
+    return head;
+}
+
+static int compare_keys(const void* a, const void* b, void* arg) {
+    const ConfigSnapshot* snap = arg;
+    const SortKey* x = a;
+    const SortKey* y = b;
+    if (x->head != y->head) return (x->head < y->head) ? -1 : 1;
+    if ((x->head & 0xFF) == 0) return 0; // Both shorter than 8 bytes, so equal
+    return strcmp(snap->arena + snap->entries[x->entry].key + 8, snap->arena + snap->entries[y->entry].key + 8);
+}
+
+const uint32_t* easy_config_sorted(const ConfigSnapshot* snap) {
+    uint32_t* order = __atomic_load_n(&snap->order, __ATOMIC_ACQUIRE);
+    if (order || snap->count == 0) return order;
+
+    SortKey* keys = malloc(snap->count * sizeof(SortKey));
+    order = malloc(snap->count * sizeof(uint32_t));
+    if (!keys || !order) {
+        free(keys);
+        free(order);
+        return NULL;
+    }
+    for (int i = 0; i < snap->count; i++) {
+        keys[i].head = key_head(snap->arena + snap->entries[i].key);
+        keys[i].entry = (uint32_t)i;
+    }
+    qsort_r(keys, snap->count, sizeof(SortKey), compare_keys, (void*)snap);
+    for (int i = 0; i < snap->count; i++) order[i] = keys[i].entry;
+    free(keys);
+
+    // Snapshots are otherwise immutable; this field is the one exception
+    uint32_t* expected = NULL;
+    if (!__atomic_compare_exchange_n((uint32_t**)&snap->order, &expected, order, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        free(order);
+        order = expected;
+    }
+    return order;
+}
+
+int easy_config_for_each(const char* prefix, ConfigVisit_t visit, void* ctx) {
+    const ConfigSnapshot* snap = easy_config_current();
+    if (!snap || snap->count == 0) return 0;
+
+    const uint32_t* order = easy_config_sorted(snap);
+    if (!order) {
+        perror("EasyConfig: Out of memory");
+        return 0;
+    }
+
+    // First key >= prefix
+    size_t len = strlen(prefix);
+    int lo = 0, hi = snap->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (strcmp(snap->arena + snap->entries[order[mid]].key, prefix) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    int visited = 0;
+    for (int i = lo; i < snap->count; i++) {
+        const ConfigEntry* e = &snap->entries[order[i]];
+        const char* key = snap->arena + e->key;
+        if (strncmp(key, prefix, len) != 0) break;
+        visited++;
+        if (!visit(key, snap->arena + e->value, ctx)) break;
+    }
+    return visited;
+}
\ No newline at end of file
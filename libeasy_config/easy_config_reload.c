@@ -0,0 +1,253 @@
+#include "easy_config_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+
+/*
+ * Snapshots are published with an atomic pointer swap and reclaimed with
+ * quiescent-state based reclamation (QSBR): each reader thread records the
+ * epoch it last passed a quiescent point in, and a replaced snapshot is
+ * freed once every reader has recorded a later epoch. Lookups only load
+ * the current pointer; they never lock or write shared memory.
+ */
+
+#define READER_OFFLINE  UINT64_MAX
+#define RECLAIM_MS      100     // Retry interval while snapshots are pending
+
+typedef struct ConfigReader {
+    uint64_t seen;                 // Epoch of the last quiescent point
+    int in_use;
+    struct ConfigReader* next;
+} ConfigReader;
+
+typedef struct {
+    bool running;
+    char* path;
+    const char* name;              // File name inside path
+    int inotify_fd;
+    int wake_fd;
+    pthread_t thread;
+} ConfigWatch;
+
+static ConfigSnapshot* current = NULL;
+static uint64_t epoch = 1;
+static ConfigReader* readers = NULL;  // Push-only list, records are reused
+static __thread ConfigReader* self = NULL;
+
+static pthread_once_t reader_once = PTHREAD_ONCE_INIT;
+static pthread_key_t reader_key;
+
+static pthread_mutex_t writer_lock = PTHREAD_MUTEX_INITIALIZER; // Publishers and the retired list
+static ConfigSnapshot* retired = NULL;
+
+static ConfigWatch watch;
+
+// --- Reader registry ---
+
+static void reader_exit(void* arg) {
+    ConfigReader* r = arg;
+    __atomic_store_n(&r->seen, READER_OFFLINE, __ATOMIC_RELEASE);
+    __atomic_store_n(&r->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void reader_key_init(void) {
+    pthread_key_create(&reader_key, reader_exit);
+}
+
+static ConfigReader* reader_register(void) {
+    pthread_once(&reader_once, reader_key_init);
+
+    // Reuse the record of a thread that has exited
+    ConfigReader* r;
+    for (r = __atomic_load_n(&readers, __ATOMIC_ACQUIRE); r; r = r->next) {
+        int idle = 0;
+        if (__atomic_compare_exchange_n(&r->in_use, &idle, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) break;
+    }
+    if (!r) {
+        r = calloc(1, sizeof(ConfigReader));
+        if (!r) return NULL;
+        r->in_use = 1;
+        r->seen = __atomic_load_n(&epoch, __ATOMIC_SEQ_CST);
+        r->next = __atomic_load_n(&readers, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&readers, &r->next, r, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {}
+    } else {
+        __atomic_store_n(&r->seen, __atomic_load_n(&epoch, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    }
+    // The record must be visible before this thread first loads 'current'
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    pthread_setspecific(reader_key, r);
+    self = r;
+    return r;
+}
+
+const ConfigSnapshot* easy_config_current(void) {
+    if (!self && !reader_register()) return NULL;
+    return __atomic_load_n(&current, __ATOMIC_ACQUIRE);
+}
+
+void easy_config_quiescent(void) {
+    if (!self) return;
+    __atomic_store_n(&self->seen, __atomic_load_n(&epoch, __ATOMIC_SEQ_CST), __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+// --- Reclamation (writer_lock held) ---
+
+// A snapshot retired at epoch E is unreachable for any reader that has
+// since seen E, so it can go once the oldest reader is past it
+static void reclaim(void) {
+    uint64_t oldest = READER_OFFLINE;
+    for (ConfigReader* r = __atomic_load_n(&readers, __ATOMIC_ACQUIRE); r; r = r->next) {
+        uint64_t seen = __atomic_load_n(&r->seen, __ATOMIC_ACQUIRE);
+        if (seen < oldest) oldest = seen;
+    }
+
+    ConfigSnapshot** link = &retired;
+    while (*link) {
+        ConfigSnapshot* snap = *link;
+        if (snap->retired <= oldest) {
+            *link = snap->next;
+            easy_config_snapshot_free(snap);
+        } else {
+            link = &snap->next;
+        }
+    }
+}
+
+void easy_config_publish(ConfigSnapshot* snap) {
+    pthread_mutex_lock(&writer_lock);
+    ConfigSnapshot* old = __atomic_exchange_n(&current, snap, __ATOMIC_SEQ_CST);
+    uint64_t now = __atomic_add_fetch(&epoch, 1, __ATOMIC_SEQ_CST);
+    if (old) {
+        old->retired = now;
+        old->next = retired;
+        retired = old;
+    }
+    easy_config_quiescent(); // The publisher holds nothing from the old one
+    reclaim();
+    pthread_mutex_unlock(&writer_lock);
+}
+
+void easy_config_release_all(void) {
+    pthread_mutex_lock(&writer_lock);
+    easy_config_snapshot_free(__atomic_exchange_n(&current, NULL, __ATOMIC_SEQ_CST));
+    __atomic_add_fetch(&epoch, 1, __ATOMIC_SEQ_CST);
+    while (retired) {
+        ConfigSnapshot* snap = retired;
+        retired = snap->next;
+        easy_config_snapshot_free(snap);
+    }
+    pthread_mutex_unlock(&writer_lock);
+}
+
+// --- Watcher ---
+
+// Drains queued events; true if any of them replaced or rewrote our file
+static bool file_changed(ConfigWatch* w) {
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+    for (;;) {
+        ssize_t n = read(w->inotify_fd, buf, sizeof(buf));
+        if (n <= 0) {
+            if (n < 0 && errno != EAGAIN && errno != EINTR) perror("EasyConfig: inotify read");
+            return changed;
+        }
+        for (char* p = buf; p < buf + n;) {
+            struct inotify_event* ev = (struct inotify_event*)p;
+            if (ev->len && strcmp(ev->name, w->name) == 0) changed = true;
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+}
+
+static void* watch_thread(void* arg) {
+    ConfigWatch* w = arg;
+    struct pollfd pfd[2] = {
+        { .fd = w->inotify_fd, .events = POLLIN },
+        { .fd = w->wake_fd, .events = POLLIN },
+    };
+
+    for (;;) {
+        pthread_mutex_lock(&writer_lock);
+        bool pending = retired != NULL;
+        pthread_mutex_unlock(&writer_lock);
+
+        if (poll(pfd, 2, pending ? RECLAIM_MS : -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("EasyConfig: poll failed");
+            break;
+        }
+        if (pfd[1].revents & POLLIN) break;
+
+        if ((pfd[0].revents & POLLIN) && file_changed(w)) {
+            // A half-written or vanished file keeps the current snapshot
+            ConfigSnapshot* snap = easy_config_parse_file(w->path);
+            if (snap) {
+                int count = snap->count;
+                easy_config_publish(snap);
+                printf("EasyConfig: Reloaded %d entries from %s\n", count, w->path);
+                continue;
+            }
+        }
+        pthread_mutex_lock(&writer_lock);
+        reclaim();
+        pthread_mutex_unlock(&writer_lock);
+    }
+    return NULL;
+}
+
+bool easy_config_watch(const char* filename) {
+    easy_config_unwatch();
+
+    ConfigSnapshot* snap = easy_config_parse_file(filename);
+    if (!snap) return false;
+    int count = snap->count;
+    easy_config_publish(snap);
+    printf("EasyConfig: Loaded %d entries from %s\n", count, filename);
+
+    ConfigWatch* w = &watch;
+    w->path = strdup(filename);
+    if (!w->path) return false;
+
+    // Watch the directory: editors and deploy tools replace the file by
+    // renaming a new one over it, which a watch on the file itself misses
+    char* slash = strrchr(w->path, '/');
+    char* dir = slash ? strndup(w->path, (slash == w->path) ? 1 : (size_t)(slash - w->path)) : strdup(".");
+    w->name = slash ? slash + 1 : w->path;
+
+    w->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    w->wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (!dir || w->inotify_fd < 0 || w->wake_fd < 0 ||
+        inotify_add_watch(w->inotify_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0 ||
+        pthread_create(&w->thread, NULL, watch_thread, w) != 0) {
+        perror("EasyConfig: Could not watch file");
+        free(dir);
+        if (w->inotify_fd >= 0) close(w->inotify_fd);
+        if (w->wake_fd >= 0) close(w->wake_fd);
+        free(w->path);
+        return false;
+    }
+    free(dir);
+    w->running = true;
+    return true;
+}
+
+void easy_config_unwatch(void) {
+    ConfigWatch* w = &watch;
+    if (!w->running) return;
+
+    uint64_t one = 1;
+    if (write(w->wake_fd, &one, sizeof(one)) < 0) perror("EasyConfig: eventfd");
+    pthread_join(w->thread, NULL);
+    close(w->inotify_fd);
+    close(w->wake_fd);
+    free(w->path);
+    w->running = false;
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "easy_config_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+
+// --- Unit tables ---
+// Size suffixes are matched case-insensitively, durations exactly
+typedef struct {
+    const char* suffix;
+    uint8_t code;
+} UnitName;
+
+static const UnitName size_units[] = {
+    { "b", 1 },
+    { "k", 2 }, { "kb", 2 }, { "kib", 2 },
+    { "m", 3 }, { "mb", 3 }, { "mib", 3 },
+    { "g", 4 }, { "gb", 4 }, { "gib", 4 },
+    { "t", 5 }, { "tb", 5 }, { "tib", 5 },
+};
+
+static const UnitName duration_units[] = {
+    { "ns", 1 }, { "us", 2 }, { "ms", 3 }, { "s", 4 },
+    { "m", 5 }, { "min", 5 }, { "h", 6 }, { "d", 7 },
+};
+
+static const double duration_ns[] = { 0, 1, 1e3, 1e6, 1e9, 60e9, 3600e9, 86400e9 };
+
+// Largest double below 2^63, so converting it never overflows
+#define INT64_LIMIT 9223372036854774784.0
+
+static uint8_t parse_unit(const char* s, size_t len) {
+    uint8_t size = CONFIG_UNIT_BAD, duration = CONFIG_UNIT_BAD;
+    for (size_t i = 0; i < sizeof(size_units) / sizeof(size_units[0]); i++) {
+        if (strlen(size_units[i].suffix) == len && strncasecmp(s, size_units[i].suffix, len) == 0) {
+            size = size_units[i].code;
+        }
+    }
+    for (size_t i = 0; i < sizeof(duration_units) / sizeof(duration_units[0]); i++) {
+        if (strlen(duration_units[i].suffix) == len && strncmp(s, duration_units[i].suffix, len) == 0) {
+            duration = duration_units[i].code;
+        }
+    }
+    return (uint8_t)(size | duration << 4);
+}
+
+// --- Helper: Numbers, with an optional unit suffix ---
+static void set_unit(const char* s, const char* end, ConfigValue* v) {
+    // One optional space between the number and its unit
+    if (*s == ' ') s++;
+    uint8_t unit = (end - s <= 3) ? parse_unit(s, end - s) : (uint8_t)(CONFIG_UNIT_BAD | CONFIG_UNIT_BAD << 4);
+    if (unit != (CONFIG_UNIT_BAD | CONFIG_UNIT_BAD << 4)) {
+        v->types |= CONFIG_T_NUMBER;
+        v->unit = unit;
+    }
+}
+
+static void set_int(int64_t i, ConfigValue* v) {
+    v->types |= CONFIG_T_INT;
+    v->i = i;
+    if (i == 0 || i == 1) v->types |= CONFIG_T_BOOL | (i ? CONFIG_T_TRUE : 0);
+}
+
+static void parse_number(const char* s, size_t len, ConfigValue* v) {
+    const char* end = s + len;
+    const char* digits = (*s == '-' || *s == '+') ? s + 1 : s;
+    char* stop;
+
+    // Hex integers (a leading 0 alone is not octal)
+    if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+        errno = 0;
+        long long i = strtoll(s, &stop, 16);
+        if (stop != end || stop == digits + 2) return;
+        if (errno == ERANGE) {
+            v->types |= CONFIG_T_RANGE;
+            return;
+        }
+        set_int(i, v);
+        v->num = (double)i;
+        v->types |= CONFIG_T_DOUBLE | CONFIG_T_NUMBER;
+        return;
+    }
+
+    // Decimal digits by hand: most values are plain integers or an
+    // integer with a unit, and strtod is several times slower
+    const char* p = digits;
+    uint64_t acc = 0;
+    bool overflow = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (acc > (UINT64_MAX - 9) / 10) overflow = true;
+        acc = acc * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    bool negative = *s == '-';
+    if (p > digits && !overflow && acc <= (uint64_t)INT64_MAX + negative &&
+        (p == end || (*p != '.' && *p != 'e' && *p != 'E'))) {
+        int64_t i = negative ? (int64_t)(0 - acc) : (int64_t)acc;
+        v->num = (double)i;
+        if (p == end) {
+            set_int(i, v);
+            v->types |= CONFIG_T_DOUBLE | CONFIG_T_NUMBER;
+        } else {
+            set_unit(p, end, v);
+        }
+        return;
+    }
+    if (p > digits && p == end) v->types |= CONFIG_T_RANGE; // Integer, but too big
+
+    double d = strtod(s, &stop);
+    if (stop == s || !isfinite(d)) return;
+    v->num = d;
+    if (stop == end) {
+        v->types |= CONFIG_T_DOUBLE | CONFIG_T_NUMBER;
+        return;
+    }
+    set_unit(stop, end, v);
+}
+
+// --- Helper: Booleans spelled out ---
+static void parse_word(const char* s, size_t len, ConfigValue* v) {
+    static const char* const truths[] = { "true", "yes", "on" };
+    static const char* const lies[] = { "false", "no", "off" };
+    for (int i = 0; i < 3; i++) {
+        if (strlen(truths[i]) == len && strncasecmp(s, truths[i], len) == 0) {
+            v->types |= CONFIG_T_BOOL | CONFIG_T_TRUE;
+        } else if (strlen(lies[i]) == len && strncasecmp(s, lies[i], len) == 0) {
+            v->types |= CONFIG_T_BOOL;
+        }
+    }
+}
+
+void easy_config_parse_value(const char* val, size_t len, ConfigValue* v) {
+    memset(v, 0, sizeof(*v));
+    if (len == 0) return;
+
+    // Items are counted here and copied out by easy_config_split_lists
+    v->list_count = 1;
+    for (const char* c = memchr(val, ',', len); c; c = memchr(c + 1, ',', val + len - c - 1)) {
+        v->list_count++;
+    }
+
+    unsigned char first = (unsigned char)val[0];
+    if (isdigit(first) || first == '-' || first == '+' || first == '.') {
+        parse_number(val, len, v);
+    } else if (len <= 5) {
+        parse_word(val, len, v);
+    }
+}
+
+// --- Lists ---
+
+bool easy_config_split_lists(ConfigSnapshot* snap) {
+    // Each list needs at most its own length + 1 bytes: the commas become
+    // the NULs and trimming only shrinks the items
+    size_t extra = 0;
+    uint32_t items = 0;
+    for (int i = 0; i < snap->count; i++) {
+        const ConfigValue* v = &snap->entries[i].typed;
+        if (v->list_count < 2) continue;
+        extra += strlen(snap->arena + snap->entries[i].value) + 1;
+        items += v->list_count;
+    }
+    if (items == 0) return true;
+
+    char* arena = realloc(snap->arena, snap->arena_len + extra);
+    snap->list_items = malloc(items * sizeof(uint64_t));
+    if (!arena || !snap->list_items) {
+        if (arena) snap->arena = arena;
+        return false;
+    }
+    snap->arena = arena;
+
+    size_t dst = snap->arena_len;
+    for (int i = 0; i < snap->count; i++) {
+        ConfigValue* v = &snap->entries[i].typed;
+        if (v->list_count < 2) continue;
+        v->list = snap->list_count;
+
+        const char* p = arena + snap->entries[i].value;
+        for (uint32_t n = 0; n < v->list_count; n++) {
+            const char* comma = strchr(p, ',');
+            const char* end = comma ? comma : p + strlen(p);
+            const char* start = p;
+            while (start < end && isspace((unsigned char)*start)) start++;
+            while (end > start && isspace((unsigned char)end[-1])) end--;
+
+            memcpy(arena + dst, start, end - start);
+            arena[dst + (end - start)] = '\0';
+            snap->list_items[snap->list_count++] = dst;
+            dst += (end - start) + 1;
+            p = comma ? comma + 1 : end;
+        }
+    }
+    snap->arena_len = dst;
+    return true;
+}
+
+// --- Conversions for the typed getters ---
+
+ConfigStatus_t easy_config_to_size(const ConfigValue* v, int64_t* out) {
+    uint8_t unit = v->unit & 0xF;
+    if (!(v->types & CONFIG_T_NUMBER) || unit == CONFIG_UNIT_BAD) return CONFIG_BAD_VALUE;
+    if (unit == CONFIG_UNIT_NONE) {
+        if (v->types & CONFIG_T_RANGE) return CONFIG_OUT_OF_RANGE;
+        if (!(v->types & CONFIG_T_INT)) return CONFIG_BAD_VALUE; // No fractional bytes
+        if (v->i < 0) return CONFIG_OUT_OF_RANGE;
+        *out = v->i;
+        return CONFIG_OK;
+    }
+    double bytes = ldexp(v->num, (unit - 1) * 10);
+    if (bytes < 0 || bytes > INT64_LIMIT) return CONFIG_OUT_OF_RANGE;
+    *out = (int64_t)bytes;
+    return CONFIG_OK;
+}
+
+ConfigStatus_t easy_config_to_duration(const ConfigValue* v, int64_t* out) {
+    uint8_t unit = v->unit >> 4;
+    if (!(v->types & CONFIG_T_NUMBER) || unit == CONFIG_UNIT_BAD) return CONFIG_BAD_VALUE;
+    if (unit == CONFIG_UNIT_NONE) {
+        // A bare number has no obvious unit; only zero is unambiguous
+        if (v->num != 0) return CONFIG_BAD_VALUE;
+        *out = 0;
+        return CONFIG_OK;
+    }
+    double ns = v->num * duration_ns[unit];
+    if (ns < 0 || ns > INT64_LIMIT) return CONFIG_OUT_OF_RANGE;
+    *out = (int64_t)llround(ns);
+    return CONFIG_OK;
+}
\ No newline at end of file
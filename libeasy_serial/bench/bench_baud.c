@@ -0,0 +1,128 @@
+/*
+ * Custom baud rates, low-latency mode and VMIN/VTIME batching over a pty.
+ *
+ *   baud    - open at rates with and without a Bxxx constant and read back
+ *             what the driver applied (a pty stores any rate)
+ *   latency - whether ASYNC_LOW_LATENCY could be set (ptys can't)
+ *   batch   - a writer streams 64-byte messages into the master while a
+ *             reader calls Serial.Receive with different VMIN/VTIME;
+ *             reported: MB/s, bytes per read() and reader CPU per MB.
+ *             Note: the pty line discipline may return a single write's
+ *             worth of data before VMIN is reached; UART drivers batch
+ *             as configured.
+ *
+ * Usage: ./bench/bench_baud [seconds]
+ */
+#define _GNU_SOURCE // posix_openpt, ptsname, RUSAGE_THREAD
+#include "easy_serial.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#define MSG_LEN 64
+
+typedef struct {
+    int master;
+    double seconds;
+    volatile bool done;
+} WriterArgs;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double thread_cpu_s(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+static int open_master(void) {
+    int m = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m < 0 || grantpt(m) < 0 || unlockpt(m) < 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+    return m;
+}
+
+static void* writer(void* arg) {
+    WriterArgs* a = arg;
+    uint8_t msg[MSG_LEN];
+    memset(msg, 0xA5, sizeof(msg));
+    double end = now_s() + a->seconds;
+    while (now_s() < end) {
+        if (write(a->master, msg, sizeof(msg)) < 0) break;
+    }
+    a->done = true;
+    return NULL;
+}
+
+static void run_batch(FILE* out, int vmin, int vtime, double seconds) {
+    int m = open_master();
+    if (m < 0) return;
+    SerialPort* port = Serial.Open(ptsname(m), 3000000);
+    if (!port || !Serial.SetReadBatching(port, vmin, vtime)) return;
+
+    WriterArgs args = { m, seconds, false };
+    pthread_t tid;
+    pthread_create(&tid, NULL, writer, &args);
+
+    uint8_t buf[65536];
+    long reads = 0, bytes = 0;
+    double c0 = thread_cpu_s(), t0 = now_s();
+    while (!args.done) {
+        int n = Serial.Receive(port, buf, sizeof(buf));
+        if (n < 0) break;
+        reads++;
+        bytes += n;
+    }
+    double elapsed = now_s() - t0, cpu = thread_cpu_s() - c0;
+    pthread_join(tid, NULL);
+
+    fprintf(out, "VMIN %3d VTIME %d   %7.1f MB/s   %7.1f bytes/read   %6.1f ms CPU/MB\n",
+            vmin, vtime, bytes / elapsed / 1e6, reads ? (double)bytes / reads : 0.0,
+            bytes ? cpu * 1e3 / (bytes / 1e6) : 0.0);
+    fflush(out);
+
+    Serial.Close(port);
+    close(m);
+}
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1) ? atof(argv[1]) : 1.0;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    static const int rates[] = { 115200, 250000, 1234567, 3000000, 4000000 };
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        int m = open_master();
+        if (m < 0) return 1;
+        SerialPort* port = Serial.Open(ptsname(m), rates[i]);
+        if (!port) return 1;
+        if (i == 0) {
+            fprintf(out, "low latency: %s\n", Serial.SetLowLatency(port, true) ? "enabled" : "not supported by this driver");
+        }
+        Serial.SetReadBatching(port, 255, 1); // Must not lose the custom rate
+        fprintf(out, "baud %8d -> %8d\n", rates[i], Serial.Baud(port));
+        Serial.Close(port);
+        close(m);
+    }
+
+    fprintf(out, "%d-byte messages, %.1fs per setting\n", MSG_LEN, seconds);
+    run_batch(out, 0, 1, seconds);   // Library default
+    run_batch(out, 64, 1, seconds);
+    run_batch(out, 255, 1, seconds);
+
+    fclose(out);
+    return 0;
+}
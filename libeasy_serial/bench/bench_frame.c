@@ -0,0 +1,197 @@
+/*
+ * Frame codec throughput, no serial hardware needed.
+ *
+ *   decode - a stream of encoded frames (random payloads) is fed to the
+ *            framer in 4 KB chunks, as a UART read would deliver it;
+ *            reported: frames/s and MB/s of wire data, for each mode and
+ *            CRC at 64- and 256-byte payloads
+ *   encode - the same frames encoded into one buffer
+ *   crc    - table CRCs against a bit-at-a-time reference
+ *   errors - every 10th frame has one byte flipped; the counters must
+ *            match and all other frames must arrive intact
+ *
+ * Usage: ./bench/bench_frame [megabytes]
+ */
+#include "easy_serial.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHUNK 4096
+
+static FILE* out;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t rng = 12345;
+static uint8_t next_byte(void) {
+    rng = rng * 1103515245u + 12345u;
+    return (uint8_t)(rng >> 16);
+}
+
+static uint32_t crc32_bitwise(const uint8_t* p, int n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    return ~crc;
+}
+
+static uint16_t crc16_bitwise(const uint8_t* p, int n) {
+    uint16_t crc = 0xFFFF;
+    while (n--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int k = 0; k < 8; k++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Encodes 'count' payloads of 'len' bytes; returns the stream length
+static size_t build_stream(SerialFrameMode_t mode, SerialCrc_t crc, int len, int count,
+                           uint8_t* payloads, uint8_t* stream) {
+    size_t pos = 0;
+    int max = SerialFrame.MaxEncoded(mode, crc, len);
+    for (int i = 0; i < count; i++) {
+        uint8_t* p = payloads + (size_t)i * len;
+        for (int k = 0; k < len; k++) p[k] = next_byte();
+        pos += SerialFrame.Encode(mode, crc, p, len, stream + pos, max);
+    }
+    return pos;
+}
+
+// Feeds the stream in chunks; returns good frames, checking them if 'payloads' is set
+static int decode_stream(SerialFramer* f, const uint8_t* stream, size_t size,
+                         const uint8_t* payloads, int len, int skip_every, int* mismatches) {
+    SerialSpan_t frame;
+    int got = 0, idx = 0;
+    for (size_t pos = 0; pos < size;) {
+        int take = (size - pos < CHUNK) ? (int)(size - pos) : CHUNK;
+        int n = SerialFrame.Feed(f, stream + pos, take);
+        pos += n;
+        while (SerialFrame.Next(f, &frame)) {
+            got++;
+            if (!payloads) continue;
+            if (skip_every && idx % skip_every == 0) idx++; // That one was corrupted
+            if (frame.length != len || memcmp(frame.data, payloads + (size_t)idx * len, len) != 0) {
+                (*mismatches)++;
+            }
+            idx++;
+        }
+    }
+    return got;
+}
+
+static const char* mode_name(SerialFrameMode_t m) {
+    return m == SERIAL_FRAME_COBS ? "cobs" : m == SERIAL_FRAME_SLIP ? "slip" : "length";
+}
+
+static const char* crc_name(SerialCrc_t c) {
+    return c == SERIAL_CRC16 ? "crc16" : c == SERIAL_CRC32 ? "crc32" : "none";
+}
+
+int main(int argc, char** argv) {
+    int mb = (argc > 1) ? atoi(argv[1]) : 64;
+    if (mb <= 0) mb = 64;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    int lens[] = { 64, 256 };
+    SerialFrameMode_t modes[] = { SERIAL_FRAME_COBS, SERIAL_FRAME_SLIP, SERIAL_FRAME_LENGTH };
+    SerialCrc_t crcs[] = { SERIAL_CRC_NONE, SERIAL_CRC16, SERIAL_CRC32 };
+
+    fprintf(out, "%-7s %-6s %5s %12s %10s %12s\n", "mode", "crc", "len", "dec fr/s", "dec MB/s", "enc MB/s");
+    for (int li = 0; li < 2; li++) {
+        int len = lens[li];
+        int count = (int)(((size_t)mb << 20) / len);
+        uint8_t* payloads = malloc((size_t)count * len);
+        uint8_t* stream = malloc((size_t)count * SerialFrame.MaxEncoded(SERIAL_FRAME_SLIP, SERIAL_CRC32, len));
+
+        for (int mi = 0; mi < 3; mi++) {
+            for (int ci = 0; ci < 3; ci++) {
+                double t0 = now_s();
+                size_t size = build_stream(modes[mi], crcs[ci], len, count, payloads, stream);
+                double enc = now_s() - t0;
+
+                SerialFramer* f = SerialFrame.Create(modes[mi], crcs[ci], 0);
+                int mismatches = 0;
+                decode_stream(f, stream, size, payloads, len, 0, &mismatches); // Warm-up + check
+                SerialFrame.Reset(f);
+
+                t0 = now_s();
+                int got = decode_stream(f, stream, size, NULL, len, 0, NULL);
+                double dec = now_s() - t0;
+
+                fprintf(out, "%-7s %-6s %5d %12.0f %10.1f %12.1f%s\n", mode_name(modes[mi]),
+                        crc_name(crcs[ci]), len, got / dec, size / dec / 1e6, size / enc / 1e6,
+                        (got != count || mismatches) ? "  MISMATCH" : "");
+                SerialFrame.Destroy(f);
+            }
+        }
+        free(payloads);
+        free(stream);
+    }
+
+    // CRC speed against the bit-at-a-time definitions
+    size_t n = (size_t)mb << 20;
+    uint8_t* buf = malloc(n);
+    for (size_t i = 0; i < n; i++) buf[i] = next_byte();
+    double t0 = now_s();
+    uint32_t a = SerialFrame.Crc32(buf, (int)n);
+    double table32 = now_s() - t0;
+    t0 = now_s();
+    uint32_t b = crc32_bitwise(buf, (int)n);
+    double bit32 = now_s() - t0;
+    t0 = now_s();
+    uint16_t c = SerialFrame.Crc16(buf, (int)n);
+    double table16 = now_s() - t0;
+    t0 = now_s();
+    uint16_t d = crc16_bitwise(buf, (int)n);
+    double bit16 = now_s() - t0;
+    fprintf(out, "\ncrc32: table %.0f MB/s, bitwise %.0f MB/s%s\n", n / table32 / 1e6, n / bit32 / 1e6,
+            (a == b && SerialFrame.Crc32((const uint8_t*)"123456789", 9) == 0xCBF43926u) ? "" : "  MISMATCH");
+    fprintf(out, "crc16: table %.0f MB/s, bitwise %.0f MB/s%s\n", n / table16 / 1e6, n / bit16 / 1e6,
+            (c == d && SerialFrame.Crc16((const uint8_t*)"123456789", 9) == 0x29B1) ? "" : "  MISMATCH");
+    free(buf);
+
+    // Corrupt every 10th frame; the rest must survive
+    fprintf(out, "\n%-7s %-6s %8s %8s %8s %8s %8s\n", "mode", "crc", "frames", "crc_err", "framing", "oversize", "bad");
+    int count = 10000, len = 64;
+    uint8_t* payloads = malloc((size_t)count * len);
+    int max = SerialFrame.MaxEncoded(SERIAL_FRAME_SLIP, SERIAL_CRC32, len);
+    uint8_t* stream = malloc((size_t)count * max);
+    for (int mi = 0; mi < 3; mi++) {
+        SerialCrc_t crc = (mi == 0) ? SERIAL_CRC16 : SERIAL_CRC32;
+        size_t pos = 0;
+        for (int i = 0; i < count; i++) {
+            uint8_t* p = payloads + (size_t)i * len;
+            for (int k = 0; k < len; k++) p[k] = next_byte();
+            int e = SerialFrame.Encode(modes[mi], crc, p, len, stream + pos, max);
+            // Flip a payload byte, never a delimiter or header
+            if (i % 10 == 0) stream[pos + e / 2] ^= 0x01;
+            pos += e;
+        }
+        SerialFramer* f = SerialFrame.Create(modes[mi], crc, 0);
+        int mismatches = 0;
+        decode_stream(f, stream, pos, payloads, len, 10, &mismatches);
+        SerialFrameStats_t st;
+        SerialFrame.Stats(f, &st);
+        fprintf(out, "%-7s %-6s %8llu %8llu %8llu %8llu %8d\n", mode_name(modes[mi]), crc_name(crc),
+                (unsigned long long)st.frames, (unsigned long long)st.crc_errors,
+                (unsigned long long)st.framing_errors, (unsigned long long)st.oversize, mismatches);
+        SerialFrame.Destroy(f);
+    }
+    free(payloads);
+    free(stream);
+
+    fclose(out);
+    return 0;
+}
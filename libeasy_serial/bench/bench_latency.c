@@ -0,0 +1,214 @@
+/*
+ * Receive timestamps and latency histograms over a pty.
+ *
+ * A writer thread sends 16-byte messages carrying their CLOCK_MONOTONIC_RAW
+ * send time into the master every 200 us. The port is read with
+ *   direct - Serial.ReceiveStamped
+ *   rx     - RS232Rx.ReadStamped (background reader thread + ring)
+ * and for each the stamp - send time ("arrival") and the port's own
+ * histograms are printed. A final phase times Serial.SendBytes (write_ns).
+ *
+ * Usage: ./bench/bench_latency [messages]
+ */
+#define _GNU_SOURCE // posix_openpt, ptsname
+#include "easy_serial.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define MSG_LEN      16
+#define INTERVAL_NS  200000
+
+typedef struct {
+    int master;
+    int count;
+} WriterArgs;
+
+static FILE* out;
+
+static uint64_t raw_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int open_master(void) {
+    int m = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m < 0 || grantpt(m) < 0 || unlockpt(m) < 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+    return m;
+}
+
+static void* writer(void* arg) {
+    WriterArgs* a = arg;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    for (int i = 0; i < a->count; i++) {
+        next.tv_nsec += INTERVAL_NS;
+        if (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        uint8_t msg[MSG_LEN] = { 0 };
+        uint64_t sent = raw_ns();
+        memcpy(msg, &sent, sizeof(sent));
+        if (write(a->master, msg, sizeof(msg)) < 0) break;
+    }
+    return NULL;
+}
+
+static void* drain(void* arg) {
+    int m = *(int*)arg;
+    uint8_t buf[65536];
+    while (read(m, buf, sizeof(buf)) > 0) {}
+    return NULL;
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_row(const char* name, const SerialHistogram_t* h) {
+    fprintf(out, "  %-12s %8llu %9llu %9llu %9llu %9llu %9llu %9llu\n", name,
+            (unsigned long long)h->count, (unsigned long long)h->min,
+            (unsigned long long)h->p50, (unsigned long long)h->p90,
+            (unsigned long long)h->p99, (unsigned long long)h->p999,
+            (unsigned long long)h->max);
+}
+
+// Send times are only read from chunks that start on a message boundary
+static void note_arrival(const uint8_t* buf, int n, uint64_t stamp, uint64_t* lags, int* count, int* offset) {
+    if (*offset == 0 && n >= MSG_LEN) {
+        uint64_t sent;
+        memcpy(&sent, buf, sizeof(sent));
+        if (stamp >= sent) lags[(*count)++] = stamp - sent;
+    }
+    *offset = (*offset + n) % MSG_LEN;
+}
+
+static void report(const char* name, SerialPort* port, uint64_t* lags, int count) {
+    SerialLatencyStats_t st;
+    Serial.Latency(port, &st);
+
+    qsort(lags, count, sizeof(uint64_t), cmp_u64);
+    SerialHistogram_t arrival = { 0 };
+    if (count) {
+        arrival.count = count;
+        arrival.min = lags[0];
+        arrival.p50 = lags[count / 2];
+        arrival.p90 = lags[(int)(count * 0.90)];
+        arrival.p99 = lags[(int)(count * 0.99)];
+        arrival.p999 = lags[(int)(count * 0.999)];
+        arrival.max = lags[count - 1];
+    }
+
+    fprintf(out, "%s\n  %-12s %8s %9s %9s %9s %9s %9s %9s\n", name, "", "count",
+            "min", "p50", "p90", "p99", "p99.9", "max");
+    print_row("arrival_ns", &arrival);
+    print_row("wakeup_ns", &st.wakeup_ns);
+    print_row("read_bytes", &st.read_bytes);
+}
+
+static void run_direct(int messages) {
+    int m = open_master();
+    if (m < 0) return;
+    SerialPort* port = Serial.Open(ptsname(m), 115200);
+    if (!port) return;
+
+    WriterArgs args = { m, messages };
+    pthread_t tid;
+    pthread_create(&tid, NULL, writer, &args);
+
+    uint64_t* lags = calloc(messages, sizeof(uint64_t));
+    uint8_t buf[4096];
+    int count = 0, offset = 0, total = 0;
+    while (total < messages * MSG_LEN) {
+        uint64_t stamp;
+        int n = Serial.ReceiveStamped(port, buf, sizeof(buf), 1000, &stamp);
+        if (n <= 0) break;
+        note_arrival(buf, n, stamp, lags, &count, &offset);
+        total += n;
+    }
+    pthread_join(tid, NULL);
+
+    report("direct (Serial.ReceiveStamped)", port, lags, count);
+    free(lags);
+    Serial.Close(port);
+    close(m);
+}
+
+static void run_rx(int messages) {
+    int m = open_master();
+    if (m < 0) return;
+    if (!RS232.Init(ptsname(m), 115200) || !RS232Rx.Start(0)) return;
+
+    WriterArgs args = { m, messages };
+    pthread_t tid;
+    pthread_create(&tid, NULL, writer, &args);
+
+    uint64_t* lags = calloc(messages, sizeof(uint64_t));
+    uint8_t buf[4096];
+    int count = 0, offset = 0, total = 0;
+    while (total < messages * MSG_LEN) {
+        uint64_t stamp;
+        int n = RS232Rx.ReadStamped(buf, sizeof(buf), 1000, &stamp);
+        if (n <= 0) break;
+        note_arrival(buf, n, stamp, lags, &count, &offset);
+        total += n;
+    }
+    pthread_join(tid, NULL);
+
+    report("rx thread (RS232Rx.ReadStamped)", RS232.Port(), lags, count);
+    free(lags);
+    RS232.Close();
+    close(m);
+}
+
+static void run_writes(int messages) {
+    int m = open_master();
+    if (m < 0) return;
+    SerialPort* port = Serial.Open(ptsname(m), 115200);
+    if (!port) return;
+
+    pthread_t tid;
+    pthread_create(&tid, NULL, drain, &m);
+
+    uint8_t msg[64];
+    memset(msg, 0x5A, sizeof(msg));
+    for (int i = 0; i < messages; i++) Serial.SendBytes(port, msg, sizeof(msg));
+
+    SerialLatencyStats_t st;
+    Serial.Latency(port, &st);
+    fprintf(out, "writes (Serial.SendBytes, 64 B)\n");
+    print_row("write_ns", &st.write_ns);
+
+    Serial.Close(port);
+    pthread_join(tid, NULL); // The master reads EOF/EIO once the slave is closed
+    close(m);
+}
+
+int main(int argc, char** argv) {
+    int messages = (argc > 1) ? atoi(argv[1]) : 20000;
+    if (messages <= 0) messages = 20000;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    run_direct(messages);
+    run_rx(messages);
+    run_writes(messages);
+
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Multi-port benchmark over pty pairs (no hardware needed).
+ *
+ * One writer thread pushes data into the master side of N ptys; the
+ * slave sides are opened with Serial.Open and read either by
+ *   manager - one PortManager epoll thread for all ports
+ *   threads - one thread per port calling Serial.Receive
+ * Reported: aggregate MB/s, the slowest and fastest port, and reader CPU.
+ *
+ * Usage: ./bench/bench_ports [ports] [seconds]
+ */
+#define _GNU_SOURCE // posix_openpt, ptsname
+#include "easy_serial.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#define MAX_PORTS 256
+#define CHUNK     4096
+
+typedef struct {
+    int master;
+    SerialPort* port;
+    uint64_t bytes;
+    pthread_t reader;
+} Pty;
+
+static Pty ptys[MAX_PORTS];
+static int nports;
+static volatile bool stop_readers;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_s(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+static bool open_ptys(void) {
+    for (int i = 0; i < nports; i++) {
+        int m = posix_openpt(O_RDWR | O_NOCTTY);
+        if (m < 0 || grantpt(m) < 0 || unlockpt(m) < 0) {
+            perror("posix_openpt");
+            return false;
+        }
+        // Both ends share one termios, so Serial.Open makes the pair raw
+        Pty* p = &ptys[i];
+        p->master = m;
+        p->port = Serial.Open(ptsname(m), 115200);
+        if (!p->port) return false;
+        fcntl(m, F_SETFL, O_NONBLOCK);
+        p->bytes = 0;
+    }
+    return true;
+}
+
+static void close_ptys(void) {
+    for (int i = 0; i < nports; i++) {
+        Serial.Close(ptys[i].port);
+        close(ptys[i].master);
+    }
+}
+
+// Round-robin over every master until time is up
+static void write_all(double seconds) {
+    static uint8_t chunk[CHUNK];
+    memset(chunk, 0x55, sizeof(chunk));
+    double end = now_s() + seconds;
+    while (now_s() < end) {
+        bool any = false;
+        for (int i = 0; i < nports; i++) {
+            if (write(ptys[i].master, chunk, sizeof(chunk)) > 0) any = true;
+        }
+        if (!any) sched_yield(); // Every pty full: let the readers run
+    }
+}
+
+static void on_data(SerialPort* port, const uint8_t* data, int length, void* user) {
+    (void)port;
+    (void)data;
+    ((Pty*)user)->bytes += length;
+}
+
+static void* port_reader(void* arg) {
+    Pty* p = arg;
+    uint8_t buf[65536];
+    while (!stop_readers) {
+        int n = Serial.Receive(p->port, buf, sizeof(buf));
+        if (n > 0) p->bytes += n;
+    }
+    return NULL;
+}
+
+static void report(FILE* out, const char* label, double elapsed, double cpu) {
+    uint64_t total = 0, lo = UINT64_MAX, hi = 0;
+    for (int i = 0; i < nports; i++) {
+        uint64_t b = ptys[i].bytes;
+        total += b;
+        if (b < lo) lo = b;
+        if (b > hi) hi = b;
+    }
+    fprintf(out, "%-8s %8.1f MB/s total   per port %6.2f..%6.2f MB/s   CPU %5.1f%%\n",
+            label, total / elapsed / 1e6, lo / elapsed / 1e6, hi / elapsed / 1e6,
+            cpu * 100 / elapsed);
+    fflush(out);
+}
+
+int main(int argc, char** argv) {
+    nports = (argc > 1) ? atoi(argv[1]) : 16;
+    double seconds = (argc > 2) ? atof(argv[2]) : 2.0;
+    if (nports < 1 || nports > MAX_PORTS) nports = 16;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+    fprintf(out, "%d pty ports, %.1fs per mode\n", nports, seconds);
+
+    // One manager thread
+    if (!open_ptys()) return 1;
+    SerialManager* mgr = PortManager.Create();
+    for (int i = 0; i < nports; i++) PortManager.Add(mgr, ptys[i].port, on_data, &ptys[i]);
+    double c0 = cpu_s(), t0 = now_s();
+    write_all(seconds);
+    usleep(100000);
+    double elapsed = now_s() - t0, cpu = cpu_s() - c0;
+    PortManager.Destroy(mgr);
+    report(out, "manager", elapsed, cpu);
+    close_ptys();
+
+    // Thread per port
+    if (!open_ptys()) return 1;
+    stop_readers = false;
+    for (int i = 0; i < nports; i++) pthread_create(&ptys[i].reader, NULL, port_reader, &ptys[i]);
+    c0 = cpu_s();
+    t0 = now_s();
+    write_all(seconds);
+    usleep(100000);
+    elapsed = now_s() - t0;
+    cpu = cpu_s() - c0;
+    stop_readers = true;
+    for (int i = 0; i < nports; i++) pthread_join(ptys[i].reader, NULL);
+    report(out, "threads", elapsed, cpu);
+    close_ptys();
+
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Transmit throughput through a pty: messages/sec from the caller's side.
+ *
+ *   sync  - Serial.SendBytes, one write() per message
+ *   queue - SerialTx.Send into the queue (retried with sched_yield while
+ *           full), then SerialTx.Drain; the writer thread coalesces
+ *           whatever is pending into one writev()
+ *
+ * A thread drains the master and checks that every byte arrived.
+ * Reported: messages/s, MB/s, messages per write() and caller CPU time.
+ *
+ * Usage: ./bench/bench_tx [messages]
+ */
+#define _GNU_SOURCE // posix_openpt, ptsname, RUSAGE_THREAD
+#include "easy_serial.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+typedef struct {
+    int master;
+    long expected;
+    long received;
+} DrainArgs;
+
+static FILE* out;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double thread_cpu_s(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+static int open_master(void) {
+    int m = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m < 0 || grantpt(m) < 0 || unlockpt(m) < 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+    return m;
+}
+
+static void* drain_master(void* arg) {
+    DrainArgs* a = arg;
+    uint8_t buf[65536];
+    while (a->received < a->expected) {
+        int n = read(a->master, buf, sizeof(buf));
+        if (n <= 0) break;
+        a->received += n;
+    }
+    return NULL;
+}
+
+static void run(const char* name, bool queued, int messages, int len) {
+    int m = open_master();
+    if (m < 0) return;
+    SerialPort* port = Serial.Open(ptsname(m), 3000000);
+    if (!port) return;
+    if (queued && !SerialTx.Start(port, 256 * 1024)) return;
+
+    DrainArgs args = { m, (long)messages * len, 0 };
+    pthread_t tid;
+    pthread_create(&tid, NULL, drain_master, &args);
+
+    uint8_t msg[256];
+    for (int i = 0; i < len; i++) msg[i] = (uint8_t)i;
+
+    double t0 = now_s(), c0 = thread_cpu_s();
+    for (int i = 0; i < messages; i++) {
+        if (!queued) {
+            Serial.SendBytes(port, msg, len);
+            continue;
+        }
+        while (!SerialTx.Send(port, msg, len)) sched_yield();
+    }
+    bool drained = !queued || SerialTx.Drain(port, 10000);
+    double elapsed = now_s() - t0, cpu = thread_cpu_s() - c0;
+    pthread_join(tid, NULL);
+
+    double per_write = 1.0;
+    if (queued) {
+        SerialTxStats_t st;
+        SerialTx.Stats(port, &st);
+        per_write = st.writes ? (double)messages / st.writes : 0;
+    }
+    fprintf(out, "%-6s %5d %12.0f %9.1f %10.1f %10.2f%s\n", name, len, messages / elapsed,
+            (double)messages * len / elapsed / 1e6, per_write, cpu * 1e9 / messages / 1000,
+            (drained && args.received == args.expected) ? "" : "  INCOMPLETE");
+
+    Serial.Close(port);
+    close(m);
+}
+
+int main(int argc, char** argv) {
+    int messages = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (messages <= 0) messages = 200000;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    int lens[] = { 16, 64, 256 };
+    fprintf(out, "%-6s %5s %12s %9s %10s %10s\n", "mode", "len", "msgs/s", "MB/s", "msgs/write", "cpu us/msg");
+    for (int i = 0; i < 3; i++) {
+        run("sync", false, messages, lens[i]);
+        run("queue", true, messages, lens[i]);
+    }
+
+    fclose(out);
+    return 0;
+}
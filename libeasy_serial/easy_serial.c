@@ -1,57 +1,71 @@
-#include "easy_serial.h"
+#include "easy_serial_internal.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>   // File Control
 #include <errno.h>   // Error handling
+#include <poll.h>
 #include <termios.h> // POSIX Terminal Control
 #include <unistd.h>  // UNIX Standard functions
 
-// Internal file descriptor for the open port
-static int serial_fd = -1;
+#define CLOSE_DRAIN_MS 1000   // How long Close waits for a transmit queue
+
+// The port behind the global RS232 instance
+static SerialPort* default_port = NULL;
 
 // --- Helper: Convert integer baud to termios constant ---
+// Anything else is set through termios2/BOTHER after the port is configured.
 static int get_baud_constant(int baud) {
     switch (baud) {
-        case 9600:   return B9600;
-        case 19200:  return B19200;
-        case 38400:  return B38400;
-        case 57600:  return B57600;
-        case 115200: return B115200;
-        default:     return -1;
+        case 1200:    return B1200;
+        case 2400:    return B2400;
+        case 4800:    return B4800;
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 500000:  return B500000;
+        case 921600:  return B921600;
+        case 1000000: return B1000000;
+        case 1500000: return B1500000;
+        case 2000000: return B2000000;
+        case 3000000: return B3000000;
+        case 4000000: return B4000000;
+        default:      return -1;
     }
 }
 
-// --- Implementation Functions ---
-
-static bool Serial_Init(const char* port_name, int baud_rate) {
-    if (serial_fd != -1) {
-        close(serial_fd); // Close if already open
-    }
+// --- Port Implementation (handle based) ---
 
+static SerialPort* Port_Open(const char* port_name, int baud_rate) {
     // Open port: Read/Write, No controlling terminal, No Delay
-    serial_fd = open(port_name, O_RDWR | O_NOCTTY | O_NDELAY);
-    
-    if (serial_fd == -1) {
+    int fd = open(port_name, O_RDWR | O_NOCTTY | O_NDELAY);
+
+    if (fd == -1) {
         perror("RS232 Error: Unable to open port");
-        return false;
+        return NULL;
     }
 
     struct termios options;
-    tcgetattr(serial_fd, &options); // Get current config
+    tcgetattr(fd, &options); // Get current config
 
     // Set Baud Rate
-    int baud_flag = get_baud_constant(baud_rate);
-    if (baud_flag == -1) {
+    if (baud_rate <= 0) {
         fprintf(stderr, "RS232 Error: Unsupported baud rate %d\n", baud_rate);
-        close(serial_fd);
-        return false;
+        close(fd);
+        return NULL;
     }
+    int baud_flag = get_baud_constant(baud_rate);
+    bool custom_baud = (baud_flag == -1);
+    if (custom_baud) baud_flag = B38400; // Placeholder, replaced below
     cfsetispeed(&options, baud_flag);
     cfsetospeed(&options, baud_flag);
 
     // --- RAW MODE CONFIGURATION (Critical for LoRa/Binary) ---
-    
+
     // c_cflag: Control Options
     options.c_cflag |= (CLOCAL | CREAD);  // Enable receiver, ignore modem lines
     options.c_cflag &= ~CSIZE;            // Mask character size bits
@@ -70,68 +84,255 @@ static bool Serial_Init(const char* port_name, int baud_rate) {
     // c_iflag: Input Options
     // Disable software flow control (XON/XOFF)
     options.c_iflag &= ~(IXON | IXOFF | IXANY);
+    // No CR/NL translation, stripping or break handling: binary data must
+    // arrive untouched, and it lets the tty layer copy input in bulk
+    options.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
 
     // Timeout settings (Non-blocking read behavior)
     options.c_cc[VMIN]  = 0;              // Read doesn't block
     options.c_cc[VTIME] = 1;              // 0.1 seconds read timeout
 
     // Apply settings
-    if (tcsetattr(serial_fd, TCSANOW, &options) != 0) {
+    if (tcsetattr(fd, TCSANOW, &options) != 0) {
         perror("RS232 Error: Failed to set attributes");
-        close(serial_fd);
-        return false;
+        close(fd);
+        return NULL;
+    }
+
+    if (custom_baud && !easy_serial_set_custom_baud(fd, baud_rate)) {
+        fprintf(stderr, "RS232 Error: Unsupported baud rate %d\n", baud_rate);
+        close(fd);
+        return NULL;
     }
 
     // Flush old data
-    tcflush(serial_fd, TCIOFLUSH);
-    
+    tcflush(fd, TCIOFLUSH);
+
     // Restore blocking behavior (optional, but good for stability)
-    fcntl(serial_fd, F_SETFL, 0);
+    fcntl(fd, F_SETFL, 0);
+
+    SerialPort* port = calloc(1, sizeof(SerialPort));
+    if (!port) {
+        perror("RS232 Error: Out of memory");
+        close(fd);
+        return NULL;
+    }
+    port->fd = fd;
+    port->baud = baud_rate;
+
+    printf("RS232: Port %s opened at %d baud.\n", port_name, custom_baud ? easy_serial_get_baud(fd) : baud_rate);
+    return port;
+}
+
+// Every write goes through here so its duration is recorded
+static int timed_write(SerialPort* port, const void* data, int length) {
+    uint64_t start = easy_serial_raw_ns();
+    int w = write(port->fd, data, length);
+    easy_serial_hist_record(&port->latency.write_ns, easy_serial_raw_ns() - start);
+    return w;
+}
 
-    printf("RS232: Port %s opened at %d baud.\n", port_name, baud_rate);
+// Loop until everything is written: a tty may take only part of a buffer,
+// and returns EAGAIN when the fd is non-blocking (PortManager)
+static bool write_all(SerialPort* port, const uint8_t* data, int length) {
+    while (length > 0) {
+        int w = timed_write(port, data, length);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) {
+                struct pollfd pfd = { .fd = port->fd, .events = POLLOUT };
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            perror("RS232 Write Error");
+            return false;
+        }
+        data += w;
+        length -= w;
+    }
     return true;
 }
 
-static void Serial_Send(const char* message) {
-    if (serial_fd == -1) return;
-    int len = strlen(message);
-    int w = write(serial_fd, message, len);
-    if (w < 0) perror("RS232 Write Error");
+static void Port_SendBytes(SerialPort* port, const uint8_t* data, int length) {
+    if (!port) return;
+    if (port->tx) {
+        if (!SerialTx.Send(port, data, length)) fprintf(stderr, "RS232 Error: Transmit queue full\n");
+        return;
+    }
+    write_all(port, data, length);
 }
 
-static void Serial_SendBytes(const uint8_t* data, int length) {
-    if (serial_fd == -1) return;
-    int w = write(serial_fd, data, length);
-    if (w < 0) perror("RS232 Write Error");
+static void Port_Send(SerialPort* port, const char* message) {
+    if (!port) return;
+    Port_SendBytes(port, (const uint8_t*)message, strlen(message));
 }
 
-static int Serial_Receive(uint8_t* buffer, int max_len) {
-    if (serial_fd == -1) return -1;
-    
+static int Port_Receive(SerialPort* port, uint8_t* buffer, int max_len) {
+    if (!port) return -1;
+
     // Attempt to read bytes
-    int n = read(serial_fd, buffer, max_len);
+    int n = read(port->fd, buffer, max_len);
     if (n < 0) {
         // If "Resource temporarily unavailable", it's just empty, not a crash
-        if (errno == EAGAIN) return 0; 
+        if (errno == EAGAIN) return 0;
         perror("RS232 Read Error");
         return -1;
     }
+    if (n > 0) easy_serial_hist_record(&port->latency.read_bytes, n);
     return n;
 }
 
+static int Port_ReceiveStamped(SerialPort* port, uint8_t* buffer, int max_len,
+                               int timeout_ms, uint64_t* stamp_ns) {
+    if (!port) return -1;
+
+    struct pollfd pfd = { .fd = port->fd, .events = POLLIN };
+    int r;
+    while ((r = poll(&pfd, 1, timeout_ms)) < 0 && errno == EINTR) {}
+    if (r < 0) {
+        perror("RS232 Error: poll failed");
+        return -1;
+    }
+    if (r == 0) return 0;
+
+    // Stamp before the read so syscall time is not counted as arrival time
+    uint64_t wake = easy_serial_raw_ns();
+    int n = read(port->fd, buffer, max_len);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EINTR) return 0;
+        perror("RS232 Read Error");
+        return -1;
+    }
+    if (n > 0) {
+        easy_serial_hist_record(&port->latency.read_bytes, n);
+        easy_serial_hist_record(&port->latency.wakeup_ns, easy_serial_raw_ns() - wake);
+    }
+    if (stamp_ns) *stamp_ns = wake;
+    return n;
+}
+
+static int Port_Fd(SerialPort* port) {
+    return port ? port->fd : -1;
+}
+
+static int Port_Baud(SerialPort* port) {
+    return port ? easy_serial_get_baud(port->fd) : -1;
+}
+
+static bool Port_SetReadBatching(SerialPort* port, int min_bytes, int timeout_ds) {
+    if (!port) return false;
+    if (min_bytes < 0 || min_bytes > 255 || timeout_ds < 0 || timeout_ds > 255) {
+        fprintf(stderr, "RS232 Error: VMIN/VTIME must be 0-255\n");
+        return false;
+    }
+
+    struct termios options;
+    if (tcgetattr(port->fd, &options) != 0) {
+        perror("RS232 Error: Failed to get attributes");
+        return false;
+    }
+    options.c_cc[VMIN] = (cc_t)min_bytes;
+    options.c_cc[VTIME] = (cc_t)timeout_ds;
+
+    // tcsetattr keeps a termios2/BOTHER rate as long as the speed fields
+    // are left as read
+    if (tcsetattr(port->fd, TCSANOW, &options) != 0) {
+        perror("RS232 Error: Failed to set attributes");
+        return false;
+    }
+    return true;
+}
+
+static bool Port_SetLowLatency(SerialPort* port, bool enable) {
+    return port && easy_serial_set_low_latency(port->fd, enable);
+}
+
+static void Port_Latency(SerialPort* port, SerialLatencyStats_t* stats) {
+    if (!port) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    easy_serial_hist_snapshot(&port->latency.wakeup_ns, &stats->wakeup_ns);
+    easy_serial_hist_snapshot(&port->latency.read_bytes, &stats->read_bytes);
+    easy_serial_hist_snapshot(&port->latency.write_ns, &stats->write_ns);
+}
+
+static void Port_ResetLatency(SerialPort* port) {
+    if (!port) return;
+    easy_serial_hist_reset(&port->latency.wakeup_ns);
+    easy_serial_hist_reset(&port->latency.read_bytes);
+    easy_serial_hist_reset(&port->latency.write_ns);
+}
+
+static void Port_Close(SerialPort* port) {
+    if (!port) return;
+    easy_serial_tx_stop(port, CLOSE_DRAIN_MS);
+    easy_serial_rx_stop(port);
+    if (port->manager) PortManager.Remove(port->manager, port);
+    close(port->fd);
+    free(port);
+    printf("RS232: Port closed.\n");
+}
+
+// --- Default Instance (RS232) ---
+
+static bool Serial_Init(const char* port_name, int baud_rate) {
+    if (default_port) {
+        Port_Close(default_port); // Close if already open
+        default_port = NULL;
+    }
+    default_port = Port_Open(port_name, baud_rate);
+    return default_port != NULL;
+}
+
+static void Serial_Send(const char* message) {
+    Port_Send(default_port, message);
+}
+
+static void Serial_SendBytes(const uint8_t* data, int length) {
+    Port_SendBytes(default_port, data, length);
+}
+
+static int Serial_Receive(uint8_t* buffer, int max_len) {
+    return Port_Receive(default_port, buffer, max_len);
+}
+
 static void Serial_Close(void) {
-    if (serial_fd != -1) {
-        close(serial_fd);
-        serial_fd = -1;
-        printf("RS232: Port closed.\n");
+    if (default_port) {
+        Port_Close(default_port);
+        default_port = NULL;
     }
 }
 
+static SerialPort* Serial_Port(void) {
+    return default_port;
+}
+
+SerialPort* easy_serial_default_port(void) {
+    return default_port;
+}
+
 // Map the functions to the struct instance
 const SerialDriver_t RS232 = {
     .Init = Serial_Init,
     .Send = Serial_Send,
     .SendBytes = Serial_SendBytes, // Used for Hex/LoRa packets
     .Receive = Serial_Receive,
-    .Close = Serial_Close
+    .Close = Serial_Close,
+    .Port = Serial_Port
+};
+
+const SerialPortDriver_t Serial = {
+    .Open = Port_Open,
+    .Send = Port_Send,
+    .SendBytes = Port_SendBytes,
+    .Receive = Port_Receive,
+    .ReceiveStamped = Port_ReceiveStamped,
+    .Fd = Port_Fd,
+    .Baud = Port_Baud,
+    .SetReadBatching = Port_SetReadBatching,
+    .SetLowLatency = Port_SetLowLatency,
+    .Latency = Port_Latency,
+    .ResetLatency = Port_ResetLatency,
+    .Close = Port_Close
 };
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/* Opaque port handle (see the Multi-Port API below). */
+typedef struct SerialPort SerialPort;
+
 /* * This struct defines the "Object" style syntax.
  * You will access everything via the global 'RS232' instance.
  */
@@ -11,7 +14,8 @@ typedef struct {
     /**
      * @brief Initialize the serial port.
      * @param port_name The file path (e.g., "/dev/ttyUSB0" or "/dev/ttyS0")
-     * @param baud_rate The speed (e.g., 9600, 115200)
+     * @param baud_rate The speed (e.g., 9600, 115200, 3000000). Rates without
+     *                  a Bxxx constant (e.g. 250000) are set with termios2.
      * @return true if successful, false if failed (check console for error)
      */
     bool (*Init)(const char* port_name, int baud_rate);
@@ -42,9 +46,389 @@ typedef struct {
      */
     void (*Close)(void);
 
+    /**
+     * @brief The port behind RS232 (for Serial.* and PortManager), or NULL.
+     */
+    SerialPort* (*Port)(void);
+
 } SerialDriver_t;
 
 // The global instance you asked for
 extern const SerialDriver_t RS232;
 
+/* --- Async Receive (background reader thread) ---
+ * A dedicated thread blocks in poll() on the port and copies incoming bytes
+ * into a lock-free single-producer/single-consumer ring. The consumer side
+ * never blocks unless asked to. While it runs, do not call RS232.Receive.
+ */
+
+/* A contiguous run of received bytes inside the ring (no copy). */
+typedef struct {
+    const uint8_t* data;
+    int length;
+} SerialSpan_t;
+
+typedef struct {
+    uint64_t bytes;       // Bytes stored in the ring
+    uint64_t overruns;    // Bytes dropped because the ring was full
+    uint32_t high_water;  // Most bytes ever waiting in the ring
+    uint32_t capacity;    // Ring size in bytes
+} SerialRxStats_t;
+
+typedef struct {
+    /**
+     * @brief Start the reader thread on the port opened with RS232.Init.
+     * @param ring_size Ring size in bytes, rounded up to a power of two
+     *                  (0 = 64 KiB).
+     * @return true if the thread is running.
+     */
+    bool (*Start)(int ring_size);
+
+    /**
+     * @brief Get the oldest contiguous block of received bytes.
+     * The span stays valid until Consume; a block that wraps around the end
+     * of the ring comes back in two Peek calls.
+     * @param timeout_ms 0 = don't wait, -1 = wait forever.
+     * @return Bytes in the span (0 on timeout), -1 if not started.
+     */
+    int (*Peek)(SerialSpan_t* span, int timeout_ms);
+
+    /**
+     * @brief Release the first 'count' bytes returned by Peek.
+     */
+    void (*Consume)(int count);
+
+    /**
+     * @brief Copy up to max_len bytes out of the ring (Peek + Consume).
+     * @return Bytes copied (0 on timeout), -1 if not started.
+     */
+    int (*Read)(uint8_t* buffer, int max_len, int timeout_ms);
+
+    /**
+     * @brief Like Read, but returns bytes from a single read() of the port
+     * together with the time the reader thread woke up for them.
+     * @param stamp_ns CLOCK_MONOTONIC_RAW in nanoseconds.
+     * @return Bytes copied (0 on timeout), -1 if not started.
+     */
+    int (*ReadStamped)(uint8_t* buffer, int max_len, int timeout_ms, uint64_t* stamp_ns);
+
+    /**
+     * @brief Copy the counters. Safe to call from any thread.
+     */
+    void (*Stats)(SerialRxStats_t* stats);
+
+    /**
+     * @brief Stop the reader thread and free the ring.
+     * RS232.Close does this automatically.
+     */
+    void (*Stop)(void);
+
+} SerialAsync_t;
+
+extern const SerialAsync_t RS232Rx;
+
+/* --- Multi-Port API ---
+ * Serial.Open returns an independent port object, so one process can drive
+ * any number of ports. RS232 above is simply the default port.
+ */
+
+/*
+ * Every port keeps HDR-style (log-linear, ~6% resolution) histograms of:
+ *   wakeup_ns  - time from the wakeup that found data (poll/epoll return,
+ *                CLOCK_MONOTONIC_RAW) until the bytes reach the application
+ *   read_bytes - size of each read() from the port
+ *   write_ns   - duration of each write() to the port
+ */
+typedef struct {
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    uint64_t mean;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t p999;
+} SerialHistogram_t;
+
+typedef struct {
+    SerialHistogram_t wakeup_ns;
+    SerialHistogram_t read_bytes;
+    SerialHistogram_t write_ns;
+} SerialLatencyStats_t;
+
+typedef struct {
+    /**
+     * @brief Open and configure a port (raw 8N1, same settings as RS232.Init).
+     * @return The port or NULL on failure (check console for error).
+     */
+    SerialPort* (*Open)(const char* port_name, int baud_rate);
+
+    /**
+     * @brief Send a null-terminated string.
+     */
+    void (*Send)(SerialPort* port, const char* message);
+
+    /**
+     * @brief Send raw binary bytes. Blocks until all of them are written,
+     * unless SerialTx is started on the port (then they are queued).
+     */
+    void (*SendBytes)(SerialPort* port, const uint8_t* data, int length);
+
+    /**
+     * @brief Read data from the port.
+     * @return Number of bytes actually read, -1 on error.
+     */
+    int (*Receive)(SerialPort* port, uint8_t* buffer, int max_len);
+
+    /**
+     * @brief Wait for data, then read it and report when it arrived.
+     * The timestamp is taken right after poll() wakes up, before the read.
+     * @param timeout_ms -1 = wait forever.
+     * @param stamp_ns CLOCK_MONOTONIC_RAW in nanoseconds.
+     * @return Number of bytes read (0 on timeout), -1 on error.
+     */
+    int (*ReceiveStamped)(SerialPort* port, uint8_t* buffer, int max_len,
+                          int timeout_ms, uint64_t* stamp_ns);
+
+    /**
+     * @brief The port's file descriptor (for your own poll/epoll).
+     */
+    int (*Fd)(SerialPort* port);
+
+    /**
+     * @brief The baud rate the driver actually applied, or -1.
+     */
+    int (*Baud)(SerialPort* port);
+
+    /**
+     * @brief Set read batching (VMIN/VTIME, both 0-255).
+     * A blocking read returns once min_bytes have arrived, or timeout_ds
+     * tenths of a second after the last byte. Default is 0/1; e.g. 255/1
+     * makes bulk reads return full buffers instead of a few bytes each.
+     */
+    bool (*SetReadBatching)(SerialPort* port, int min_bytes, int timeout_ds);
+
+    /**
+     * @brief Toggle ASYNC_LOW_LATENCY (TIOCSSERIAL): the driver pushes
+     * received bytes up immediately instead of on its own timer
+     * (e.g. 16 ms on FTDI).
+     * @return false if the driver doesn't support it (ptys, many adapters).
+     */
+    bool (*SetLowLatency)(SerialPort* port, bool enable);
+
+    /**
+     * @brief Snapshot the port's histograms while it keeps running.
+     */
+    void (*Latency)(SerialPort* port, SerialLatencyStats_t* stats);
+
+    /**
+     * @brief Clear the port's histograms.
+     */
+    void (*ResetLatency)(SerialPort* port);
+
+    /**
+     * @brief Close the port, detach it from its manager and free it.
+     */
+    void (*Close)(SerialPort* port);
+
+} SerialPortDriver_t;
+
+extern const SerialPortDriver_t Serial;
+
+/* --- Port Manager ---
+ * One epoll thread services every added port and hands each chunk of
+ * received data to that port's callback.
+ */
+
+/* Opaque manager handle. */
+typedef struct SerialManager SerialManager;
+
+/**
+ * Called on the manager thread with data read from 'port'. 'data' is only
+ * valid during the call. length == 0 means the port hung up or failed; it
+ * has been removed from the manager (but not closed).
+ */
+typedef void (*SerialDataFn)(SerialPort* port, const uint8_t* data, int length, void* user);
+
+typedef struct {
+    /**
+     * @brief Create a manager and start its thread.
+     * @return The manager or NULL on failure.
+     */
+    SerialManager* (*Create)(void);
+
+    /**
+     * @brief Start servicing a port. The port is switched to non-blocking
+     * mode; don't call Serial.Receive on it while it is added.
+     */
+    bool (*Add)(SerialManager* manager, SerialPort* port, SerialDataFn on_data, void* user);
+
+    /**
+     * @brief Stop servicing a port. Safe from any thread, including from
+     * inside a callback. When it returns, no callback for the port runs.
+     */
+    void (*Remove)(SerialManager* manager, SerialPort* port);
+
+    /**
+     * @brief Stop the thread, remove every port (they stay open) and free
+     * the manager. Not from inside a callback.
+     */
+    void (*Destroy)(SerialManager* manager);
+
+} SerialManager_t;
+
+extern const SerialManager_t PortManager;
+
+/* --- Frame Codec (COBS / SLIP / length-prefixed) ---
+ * Finds packet boundaries in a raw byte stream. Received bytes go into the
+ * framer's own buffer (Fill reads the port straight into it) and frames are
+ * decoded in place, so there is no per-frame allocation or copy.
+ */
+
+typedef enum {
+    SERIAL_FRAME_COBS,   // COBS-encoded, terminated by 0x00
+    SERIAL_FRAME_SLIP,   // RFC 1055 SLIP: 0xC0 delimiters, 0xDB escapes
+    SERIAL_FRAME_LENGTH  // 0x7E, 2-byte big-endian length, then the bytes
+} SerialFrameMode_t;
+
+typedef enum {
+    SERIAL_CRC_NONE,
+    SERIAL_CRC16,        // CRC-16/CCITT-FALSE, appended little-endian
+    SERIAL_CRC32         // CRC-32 (IEEE 802.3), appended little-endian
+} SerialCrc_t;
+
+/* Opaque decoder state. One per stream. */
+typedef struct SerialFramer SerialFramer;
+
+typedef struct {
+    uint64_t frames;          // Good frames returned by Next
+    uint64_t crc_errors;      // Frames dropped for a CRC mismatch
+    uint64_t framing_errors;  // Malformed frames dropped (bad encoding/header)
+    uint64_t oversize;        // Frames dropped for exceeding max_frame
+} SerialFrameStats_t;
+
+typedef struct {
+    /**
+     * @brief Create a decoder.
+     * @param max_frame Largest payload accepted, excluding CRC (0 = 4096).
+     * @return The framer or NULL on failure.
+     */
+    SerialFramer* (*Create)(SerialFrameMode_t mode, SerialCrc_t crc, int max_frame);
+
+    /**
+     * @brief Read whatever the port has straight into the framer's buffer.
+     * @return Bytes read, 0 if none, -1 on error.
+     */
+    int (*Fill)(SerialFramer* framer, SerialPort* port);
+
+    /**
+     * @brief Append bytes you already have (e.g. from RS232.Receive).
+     * @return Bytes taken; fewer than length when the buffer is full,
+     *         in which case call Next to make room.
+     */
+    int (*Feed)(SerialFramer* framer, const uint8_t* data, int length);
+
+    /**
+     * @brief Get the next complete, CRC-checked frame (payload only).
+     * The span points into the framer's buffer and stays valid until the
+     * next Fill, Feed or Reset. Bad frames are counted and skipped.
+     * @return 1 if a frame was returned, 0 if more data is needed.
+     */
+    int (*Next)(SerialFramer* framer, SerialSpan_t* frame);
+
+    /**
+     * @brief Encode one payload (plus CRC) into 'out'.
+     * @param out_cap Use MaxEncoded() to size it.
+     * @return Encoded length, or -1 if out_cap is too small.
+     */
+    int (*Encode)(SerialFrameMode_t mode, SerialCrc_t crc,
+                  const uint8_t* payload, int length, uint8_t* out, int out_cap);
+
+    /**
+     * @brief Worst-case encoded size of a payload of 'length' bytes.
+     */
+    int (*MaxEncoded)(SerialFrameMode_t mode, SerialCrc_t crc, int length);
+
+    /**
+     * @brief Table-driven CRCs, exposed for protocols that need them alone.
+     */
+    uint16_t (*Crc16)(const uint8_t* data, int length);
+    uint32_t (*Crc32)(const uint8_t* data, int length);
+
+    /**
+     * @brief Copy the counters.
+     */
+    void (*Stats)(SerialFramer* framer, SerialFrameStats_t* stats);
+
+    /**
+     * @brief Drop buffered bytes (e.g. after reopening the port).
+     */
+    void (*Reset)(SerialFramer* framer);
+
+    /**
+     * @brief Free the framer.
+     */
+    void (*Destroy)(SerialFramer* framer);
+
+} SerialFrameCodec_t;
+
+extern const SerialFrameCodec_t SerialFrame;
+
+/* --- Transmit Queue ---
+ * Send copies messages into a preallocated ring and returns at once; a
+ * writer thread hands everything pending to the driver with one writev()
+ * and retries short writes and EAGAIN. Once started, Serial.Send/SendBytes
+ * (and RS232.Send/SendBytes on the default port) go through the queue too.
+ */
+
+typedef struct {
+    uint64_t messages;    // Messages queued
+    uint64_t bytes;       // Bytes written to the port
+    uint64_t writes;      // writev() calls that wrote something
+    uint64_t partial;     // Short writes (the rest was retried)
+    uint64_t rejected;    // Messages refused because the queue was full
+    uint64_t errors;      // Write errors (queued data is dropped)
+    uint32_t high_water;  // Most bytes ever waiting in the queue
+    uint32_t capacity;    // Queue size in bytes
+} SerialTxStats_t;
+
+typedef struct {
+    /**
+     * @brief Start the writer thread for a port.
+     * @param queue_size Queue size in bytes, rounded up to a power of two
+     *                   (0 = 64 KiB).
+     * @return true if the thread is running.
+     */
+    bool (*Start)(SerialPort* port, int queue_size);
+
+    /**
+     * @brief Queue a message. Never blocks; a message is queued whole or
+     * not at all. Safe from several threads.
+     * @return false if the queue is full (or not started).
+     */
+    bool (*Send)(SerialPort* port, const uint8_t* data, int length);
+
+    /**
+     * @brief Wait until everything queued so far has been written and the
+     * driver has transmitted it (TIOCOUTQ reaches 0).
+     * @param timeout_ms -1 = wait forever.
+     * @return true if drained, false on timeout or write error.
+     */
+    bool (*Drain)(SerialPort* port, int timeout_ms);
+
+    /**
+     * @brief Copy the counters. Safe to call from any thread.
+     */
+    void (*Stats)(SerialPort* port, SerialTxStats_t* stats);
+
+    /**
+     * @brief Stop the writer thread and free the queue. Data still queued
+     * is dropped; call Drain first. Serial.Close drains for up to 1 s.
+     */
+    void (*Stop)(SerialPort* port);
+
+} SerialTxQueue_t;
+
+extern const SerialTxQueue_t SerialTx;
+
 #endif
\ No newline at end of file
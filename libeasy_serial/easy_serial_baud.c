@@ -0,0 +1,52 @@
+// termios2 lives in the kernel headers, which clash with glibc's
+// <termios.h>; keeping it in its own file avoids the conflict.
+#include <stdio.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <asm/termbits.h>
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+
+bool easy_serial_set_custom_baud(int fd, int baud) {
+    struct termios2 tio;
+    if (ioctl(fd, TCGETS2, &tio) < 0) {
+        perror("RS232 Error: TCGETS2 failed");
+        return false;
+    }
+
+    // BOTHER: take the rate from c_ispeed/c_ospeed instead of a Bxxx code
+    tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tio.c_ispeed = baud;
+    tio.c_ospeed = baud;
+
+    if (ioctl(fd, TCSETS2, &tio) < 0) {
+        perror("RS232 Error: Custom baud rate rejected");
+        return false;
+    }
+    return true;
+}
+
+int easy_serial_get_baud(int fd) {
+    struct termios2 tio;
+    if (ioctl(fd, TCGETS2, &tio) < 0) return -1;
+    return (int)tio.c_ospeed;
+}
+
+bool easy_serial_set_low_latency(int fd, bool enable) {
+    struct serial_struct ss;
+    if (ioctl(fd, TIOCGSERIAL, &ss) < 0) {
+        // Not a UART driver (pty, some USB adapters): nothing to tune
+        if (errno != ENOTTY && errno != EINVAL) perror("RS232 Error: TIOCGSERIAL failed");
+        return false;
+    }
+
+    if (enable) ss.flags |= ASYNC_LOW_LATENCY;
+    else ss.flags &= ~ASYNC_LOW_LATENCY;
+
+    if (ioctl(fd, TIOCSSERIAL, &ss) < 0) {
+        perror("RS232 Error: TIOCSSERIAL failed");
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
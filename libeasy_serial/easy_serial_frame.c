@@ -0,0 +1,466 @@
+#include "easy_serial_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define FRAME_DEFAULT_MAX   4096
+#define FRAME_LENGTH_MAX    65535
+
+#define SLIP_END            0xC0
+#define SLIP_ESC            0xDB
+#define SLIP_ESC_END        0xDC
+#define SLIP_ESC_ESC        0xDD
+#define LENGTH_SYNC         0x7E
+#define LENGTH_HEADER       3
+
+// --- Internal Storage ---
+
+// Raw bytes live in buf[head, tail). Delimited modes resume the delimiter
+// search at 'scan', so every byte is looked at once. Frames are decoded in
+// place: the output never gets ahead of the input.
+struct SerialFramer {
+    SerialFrameMode_t mode;
+    SerialCrc_t crc;
+    int crc_len;
+    int max_frame;
+    int max_encoded;
+    bool skipping;             // Dropping the rest of an oversize frame
+
+    uint8_t* buf;
+    int cap;
+    int head;
+    int tail;
+    int scan;
+
+    SerialFrameStats_t stats;
+};
+
+// --- CRC Tables ---
+
+static uint16_t crc16_table[4][256];   // Slicing-by-4
+static uint32_t crc32_table[8][256];   // Slicing-by-8
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+static void build_crc_tables(void) {
+    for (int i = 0; i < 256; i++) {
+        uint16_t c16 = (uint16_t)(i << 8);
+        uint32_t c32 = (uint32_t)i;
+        for (int k = 0; k < 8; k++) {
+            c16 = (c16 & 0x8000) ? (uint16_t)((c16 << 1) ^ 0x1021) : (uint16_t)(c16 << 1);
+            c32 = (c32 & 1) ? (c32 >> 1) ^ 0xEDB88320u : c32 >> 1;
+        }
+        crc16_table[0][i] = c16;
+        crc32_table[0][i] = c32;
+    }
+    for (int i = 0; i < 256; i++) {
+        for (int t = 1; t < 4; t++) {
+            uint16_t prev = crc16_table[t - 1][i];
+            crc16_table[t][i] = (uint16_t)((prev << 8) ^ crc16_table[0][prev >> 8]);
+        }
+        for (int t = 1; t < 8; t++) {
+            uint32_t prev = crc32_table[t - 1][i];
+            crc32_table[t][i] = (prev >> 8) ^ crc32_table[0][prev & 0xFF];
+        }
+    }
+}
+
+static uint16_t crc16(const uint8_t* p, int n) {
+    uint16_t crc = 0xFFFF;
+    // Four bytes per step; the register only overlaps the first two
+    while (n >= 4) {
+        crc = crc16_table[3][p[0] ^ (crc >> 8)] ^ crc16_table[2][p[1] ^ (crc & 0xFF)] ^
+              crc16_table[1][p[2]] ^ crc16_table[0][p[3]];
+        p += 4;
+        n -= 4;
+    }
+    while (n--) crc = (uint16_t)((crc << 8) ^ crc16_table[0][(crc >> 8) ^ *p++]);
+    return crc;
+}
+
+static uint32_t crc32(const uint8_t* p, int n) {
+    uint32_t crc = 0xFFFFFFFFu;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Eight bytes per step through eight tables
+    while (n >= 8) {
+        uint32_t one, two;
+        memcpy(&one, p, 4);
+        memcpy(&two, p + 4, 4);
+        one ^= crc;
+        crc = crc32_table[7][one & 0xFF] ^ crc32_table[6][(one >> 8) & 0xFF] ^
+              crc32_table[5][(one >> 16) & 0xFF] ^ crc32_table[4][one >> 24] ^
+              crc32_table[3][two & 0xFF] ^ crc32_table[2][(two >> 8) & 0xFF] ^
+              crc32_table[1][(two >> 16) & 0xFF] ^ crc32_table[0][two >> 24];
+        p += 8;
+        n -= 8;
+    }
+#endif
+    while (n--) crc = (crc >> 8) ^ crc32_table[0][(crc ^ *p++) & 0xFF];
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static int crc_size(SerialCrc_t crc) {
+    return (crc == SERIAL_CRC16) ? 2 : (crc == SERIAL_CRC32) ? 4 : 0;
+}
+
+// Writes the CRC of p[0..n) little-endian into out, returns its size
+static int crc_bytes(SerialCrc_t crc, const uint8_t* p, int n, uint8_t* out) {
+    if (crc == SERIAL_CRC16) {
+        uint16_t c = crc16(p, n);
+        out[0] = (uint8_t)c;
+        out[1] = (uint8_t)(c >> 8);
+        return 2;
+    }
+    if (crc == SERIAL_CRC32) {
+        uint32_t c = crc32(p, n);
+        for (int i = 0; i < 4; i++) out[i] = (uint8_t)(c >> (8 * i));
+        return 4;
+    }
+    return 0;
+}
+
+// --- Decoders (in place) ---
+
+// Returns the decoded length or -1 if the encoding is invalid
+static int cobs_decode(uint8_t* p, int n) {
+    uint8_t* in = p;
+    uint8_t* end = p + n;
+    uint8_t* out = p;
+
+    while (in < end) {
+        int code = *in++;
+        if (code == 0 || code - 1 > end - in) return -1;
+        memmove(out, in, code - 1);
+        out += code - 1;
+        in += code - 1;
+        if (code != 0xFF && in < end) *out++ = 0;
+    }
+    return (int)(out - p);
+}
+
+static int slip_decode(uint8_t* p, int n) {
+    uint8_t* in = p;
+    uint8_t* end = p + n;
+    uint8_t* out = p;
+
+    while (in < end) {
+        uint8_t* esc = memchr(in, SLIP_ESC, end - in);
+        int run = (int)((esc ? esc : end) - in);
+        memmove(out, in, run);
+        out += run;
+        in += run;
+        if (!esc) break;
+
+        if (++in == end) return -1;
+        if (*in == SLIP_ESC_END) *out++ = SLIP_END;
+        else if (*in == SLIP_ESC_ESC) *out++ = SLIP_ESC;
+        else return -1;
+        in++;
+    }
+    return (int)(out - p);
+}
+
+// Checks and strips the trailing CRC; returns the payload length or -1
+static int check_crc(SerialFramer* f, const uint8_t* p, int n) {
+    if (f->crc_len == 0) return n;
+    if (n < f->crc_len) {
+        f->stats.framing_errors++;
+        return -1;
+    }
+    uint8_t expect[4];
+    crc_bytes(f->crc, p, n - f->crc_len, expect);
+    if (memcmp(expect, p + n - f->crc_len, f->crc_len) != 0) {
+        f->stats.crc_errors++;
+        return -1;
+    }
+    return n - f->crc_len;
+}
+
+static int next_delimited(SerialFramer* f, SerialSpan_t* frame) {
+    uint8_t delim = (f->mode == SERIAL_FRAME_COBS) ? 0x00 : SLIP_END;
+
+    for (;;) {
+        if (f->scan >= f->tail) return 0;
+        uint8_t* d = memchr(f->buf + f->scan, delim, f->tail - f->scan);
+        if (!d) {
+            f->scan = f->tail;
+            // No delimiter within the largest legal frame: drop what we have
+            // and ignore everything up to the next delimiter
+            if (f->tail - f->head > f->max_encoded) {
+                if (!f->skipping) f->stats.oversize++;
+                f->skipping = true;
+                f->head = f->tail;
+            }
+            return 0;
+        }
+
+        int start = f->head;
+        int end = (int)(d - f->buf);
+        f->head = f->scan = end + 1;
+
+        if (f->skipping) {
+            f->skipping = false;
+            continue;
+        }
+        if (end == start) continue; // Back-to-back delimiters (SLIP sends a leading END)
+        if (end - start > f->max_encoded) {
+            f->stats.oversize++;
+            continue;
+        }
+
+        int n = (f->mode == SERIAL_FRAME_COBS) ? cobs_decode(f->buf + start, end - start)
+                                               : slip_decode(f->buf + start, end - start);
+        if (n < 0) {
+            f->stats.framing_errors++;
+            continue;
+        }
+        n = check_crc(f, f->buf + start, n);
+        if (n < 0) continue;
+        if (n > f->max_frame) {
+            f->stats.oversize++;
+            continue;
+        }
+
+        frame->data = f->buf + start;
+        frame->length = n;
+        f->stats.frames++;
+        return 1;
+    }
+}
+
+static int next_length(SerialFramer* f, SerialSpan_t* frame) {
+    for (;;) {
+        int avail = f->tail - f->head;
+        if (avail < LENGTH_HEADER) return 0;
+
+        uint8_t* h = f->buf + f->head;
+        if (h[0] != LENGTH_SYNC) {
+            // Lost sync: jump to the next candidate header
+            uint8_t* s = memchr(h + 1, LENGTH_SYNC, avail - 1);
+            f->head = s ? (int)(s - f->buf) : f->tail;
+            f->stats.framing_errors++;
+            continue;
+        }
+
+        int len = (h[1] << 8) | h[2];
+        if (len < f->crc_len || len - f->crc_len > f->max_frame) {
+            f->stats.oversize++;
+            f->head++; // Probably a false sync byte; resync past it
+            continue;
+        }
+        if (avail < LENGTH_HEADER + len) return 0;
+
+        int n = check_crc(f, h + LENGTH_HEADER, len);
+        if (n < 0) {
+            f->head++;
+            continue;
+        }
+        frame->data = h + LENGTH_HEADER;
+        frame->length = n;
+        f->head += LENGTH_HEADER + len;
+        f->stats.frames++;
+        return 1;
+    }
+}
+
+// Move the unread bytes to the front when the end of the buffer is reached
+static int make_room(SerialFramer* f) {
+    if (f->tail == f->cap && f->head > 0) {
+        memmove(f->buf, f->buf + f->head, f->tail - f->head);
+        f->tail -= f->head;
+        f->scan -= f->head;
+        f->head = 0;
+    }
+    return f->cap - f->tail;
+}
+
+// --- Encoders ---
+
+typedef struct {
+    uint8_t* out;
+    uint8_t* code_ptr;
+    uint8_t code;
+} CobsWriter;
+
+static void cobs_put(CobsWriter* w, const uint8_t* p, int n) {
+    for (int i = 0; i < n; i++) {
+        if (p[i] == 0) {
+            *w->code_ptr = w->code;
+            w->code_ptr = w->out++;
+            w->code = 1;
+            continue;
+        }
+        *w->out++ = p[i];
+        if (++w->code == 0xFF) {
+            *w->code_ptr = w->code;
+            w->code_ptr = w->out++;
+            w->code = 1;
+        }
+    }
+}
+
+static uint8_t* slip_put(uint8_t* out, const uint8_t* p, int n) {
+    for (int i = 0; i < n; i++) {
+        if (p[i] == SLIP_END) {
+            *out++ = SLIP_ESC;
+            *out++ = SLIP_ESC_END;
+        } else if (p[i] == SLIP_ESC) {
+            *out++ = SLIP_ESC;
+            *out++ = SLIP_ESC_ESC;
+        } else {
+            *out++ = p[i];
+        }
+    }
+    return out;
+}
+
+// --- Implementation ---
+
+static int Frame_MaxEncoded(SerialFrameMode_t mode, SerialCrc_t crc, int length) {
+    int n = length + crc_size(crc);
+    switch (mode) {
+        case SERIAL_FRAME_COBS: return n + n / 254 + 2;   // Code bytes + delimiter
+        case SERIAL_FRAME_SLIP: return 2 * n + 2;         // Every byte escaped + two ENDs
+        default:                return n + LENGTH_HEADER;
+    }
+}
+
+static SerialFramer* Frame_Create(SerialFrameMode_t mode, SerialCrc_t crc, int max_frame) {
+    pthread_once(&crc_once, build_crc_tables);
+
+    SerialFramer* f = calloc(1, sizeof(SerialFramer));
+    if (!f) {
+        perror("RS232 Error: Out of memory");
+        return NULL;
+    }
+    f->mode = mode;
+    f->crc = crc;
+    f->crc_len = crc_size(crc);
+    f->max_frame = (max_frame > 0) ? max_frame : FRAME_DEFAULT_MAX;
+    if (mode == SERIAL_FRAME_LENGTH && f->max_frame > FRAME_LENGTH_MAX - f->crc_len) {
+        f->max_frame = FRAME_LENGTH_MAX - f->crc_len;
+    }
+    f->max_encoded = Frame_MaxEncoded(mode, crc, f->max_frame);
+
+    // Two worst-case frames: one being decoded, the next arriving behind it
+    f->cap = 2 * f->max_encoded + 4096;
+    f->buf = malloc(f->cap);
+    if (!f->buf) {
+        perror("RS232 Error: Out of memory");
+        free(f);
+        return NULL;
+    }
+    return f;
+}
+
+static int Frame_Fill(SerialFramer* f, SerialPort* port) {
+    if (!f || !port) return -1;
+    int room = make_room(f);
+    if (room == 0) return 0; // Call Next first
+
+    int n = read(port->fd, f->buf + f->tail, room);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EINTR) return 0;
+        perror("RS232 Read Error");
+        return -1;
+    }
+    f->tail += n;
+    return n;
+}
+
+static int Frame_Feed(SerialFramer* f, const uint8_t* data, int length) {
+    if (!f || length <= 0) return 0;
+    int room = make_room(f);
+    if (length > room) length = room;
+    memcpy(f->buf + f->tail, data, length);
+    f->tail += length;
+    return length;
+}
+
+static int Frame_Next(SerialFramer* f, SerialSpan_t* frame) {
+    if (!f) return 0;
+    int r = (f->mode == SERIAL_FRAME_LENGTH) ? next_length(f, frame) : next_delimited(f, frame);
+
+    // Everything consumed: start over at the front, no memmove needed later
+    if (f->head == f->tail) f->head = f->tail = f->scan = 0;
+    return r;
+}
+
+static int Frame_Encode(SerialFrameMode_t mode, SerialCrc_t crc,
+                        const uint8_t* payload, int length, uint8_t* out, int out_cap) {
+    if (length < 0 || out_cap < Frame_MaxEncoded(mode, crc, length)) return -1;
+    if (mode == SERIAL_FRAME_LENGTH && length + crc_size(crc) > FRAME_LENGTH_MAX) return -1;
+
+    pthread_once(&crc_once, build_crc_tables);
+    uint8_t tail[4];
+    int tail_len = crc_bytes(crc, payload, length, tail);
+
+    if (mode == SERIAL_FRAME_COBS) {
+        CobsWriter w = { out + 1, out, 1 };
+        cobs_put(&w, payload, length);
+        cobs_put(&w, tail, tail_len);
+        *w.code_ptr = w.code;
+        *w.out++ = 0x00;
+        return (int)(w.out - out);
+    }
+
+    if (mode == SERIAL_FRAME_SLIP) {
+        uint8_t* p = out;
+        *p++ = SLIP_END; // Flushes any line noise before the frame
+        p = slip_put(p, payload, length);
+        p = slip_put(p, tail, tail_len);
+        *p++ = SLIP_END;
+        return (int)(p - out);
+    }
+
+    int len = length + tail_len;
+    out[0] = LENGTH_SYNC;
+    out[1] = (uint8_t)(len >> 8);
+    out[2] = (uint8_t)len;
+    memcpy(out + LENGTH_HEADER, payload, length);
+    memcpy(out + LENGTH_HEADER + length, tail, tail_len);
+    return LENGTH_HEADER + len;
+}
+
+static uint16_t Frame_Crc16(const uint8_t* data, int length) {
+    pthread_once(&crc_once, build_crc_tables);
+    return crc16(data, length);
+}
+
+static uint32_t Frame_Crc32(const uint8_t* data, int length) {
+    pthread_once(&crc_once, build_crc_tables);
+    return crc32(data, length);
+}
+
+static void Frame_Stats(SerialFramer* f, SerialFrameStats_t* stats) {
+    if (f) *stats = f->stats;
+}
+
+static void Frame_Reset(SerialFramer* f) {
+    if (!f) return;
+    f->head = f->tail = f->scan = 0;
+    f->skipping = false;
+}
+
+static void Frame_Destroy(SerialFramer* f) {
+    if (!f) return;
+    free(f->buf);
+    free(f);
+}
+
+// Map the functions to the struct instance
+const SerialFrameCodec_t SerialFrame = {
+    .Create = Frame_Create,
+    .Fill = Frame_Fill,
+    .Feed = Frame_Feed,
+    .Next = Frame_Next,
+    .Encode = Frame_Encode,
+    .MaxEncoded = Frame_MaxEncoded,
+    .Crc16 = Frame_Crc16,
+    .Crc32 = Frame_Crc32,
+    .Stats = Frame_Stats,
+    .Reset = Frame_Reset,
+    .Destroy = Frame_Destroy
+};
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef EASY_SERIAL_INTERNAL_H
+#define EASY_SERIAL_INTERNAL_H
+
+/*
+ * Helpers shared between the library's source files.
+ * Not installed; applications only need easy_serial.h.
+ */
+
+#include "easy_serial.h"
+
+typedef struct SerialRx SerialRx;
+typedef struct TxQueue TxQueue;
+typedef struct PortEntry PortEntry;
+
+// Log-linear histogram: exact below 32, then 16 buckets per power of two
+// (about 6% wide). Recorded with relaxed atomics from any thread.
+#define HIST_LINEAR     32
+#define HIST_SUB        16
+#define HIST_BUCKETS    (HIST_LINEAR + (64 - 5) * HIST_SUB)
+
+typedef struct {
+    uint64_t buckets[HIST_BUCKETS];
+    uint64_t sum;
+    uint64_t max;
+    uint64_t min_inv;          // ~min, so a zeroed histogram needs no setup
+} SerialHist;
+
+typedef struct {
+    SerialHist wakeup_ns;      // Wakeup (poll/epoll return) to bytes handed over
+    SerialHist read_bytes;     // Size of each read() from the port
+    SerialHist write_ns;       // Duration of each write() to the port
+} SerialLatency;
+
+// One open port. RS232 is a single static instance of this.
+struct SerialPort {
+    int fd;
+    int baud;
+    SerialRx* rx;              // Background reader (RS232Rx), NULL if stopped
+    TxQueue* tx;               // Transmit queue (SerialTx), NULL if stopped
+    SerialManager* manager;    // Manager servicing the port, NULL if none
+    PortEntry* entry;          // The port's registration with 'manager'
+    SerialLatency latency;
+};
+
+/**
+ * @brief The port behind the RS232 instance, or NULL if none is open.
+ */
+SerialPort* easy_serial_default_port(void);
+
+/**
+ * @brief Set any baud rate with termios2/BOTHER (e.g. 250000, 3000000).
+ */
+bool easy_serial_set_custom_baud(int fd, int baud);
+
+/**
+ * @brief The output baud rate the driver actually uses, or -1.
+ */
+int easy_serial_get_baud(int fd);
+
+/**
+ * @brief Toggle ASYNC_LOW_LATENCY (TIOCSSERIAL).
+ * @return false if the driver does not support it.
+ */
+bool easy_serial_set_low_latency(int fd, bool enable);
+
+/**
+ * @brief CLOCK_MONOTONIC_RAW in nanoseconds (what receive timestamps use).
+ */
+uint64_t easy_serial_raw_ns(void);
+
+/**
+ * @brief Add one sample to a histogram.
+ */
+void easy_serial_hist_record(SerialHist* h, uint64_t value);
+
+/**
+ * @brief Summarise a histogram that may still be recording.
+ */
+void easy_serial_hist_snapshot(SerialHist* h, SerialHistogram_t* out);
+
+/**
+ * @brief Zero a histogram (samples racing with this may survive).
+ */
+void easy_serial_hist_reset(SerialHist* h);
+
+/**
+ * @brief Stop the port's background reader, if it has one.
+ */
+void easy_serial_rx_stop(SerialPort* port);
+
+/**
+ * @brief Stop the port's transmit queue, if it has one, after waiting up
+ * to drain_ms for queued data to go out.
+ */
+void easy_serial_tx_stop(SerialPort* port, int drain_ms);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "easy_serial_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define MANAGER_MAX_EVENTS  64
+#define MANAGER_READ_CHUNK  65536
+
+// --- Internal Storage ---
+
+struct PortEntry {
+    SerialPort* port;
+    SerialDataFn on_data;
+    void* user;
+    int saved_flags;            // fcntl flags to restore on Remove
+    bool removed;
+    PortEntry* prev;            // Live entries, for Destroy
+    PortEntry* next;            // Live list, then the graveyard once removed
+};
+
+struct SerialManager {
+    int epoll_fd;
+    int stop_fd;
+    pthread_t thread;
+
+    // Held while a batch of events is dispatched, so Remove from another
+    // thread can't free an entry the manager thread is about to use
+    pthread_mutex_t lock;
+    PortEntry* ports;
+    PortEntry* graveyard;       // Removed during a batch, freed after it
+
+    uint8_t read_buf[MANAGER_READ_CHUNK];
+};
+
+// --- Helpers ---
+
+static bool on_manager_thread(SerialManager* m) {
+    return pthread_equal(pthread_self(), m->thread);
+}
+
+// Callbacks run with the lock already held by the manager thread
+static void lock(SerialManager* m) {
+    if (!on_manager_thread(m)) pthread_mutex_lock(&m->lock);
+}
+
+static void unlock(SerialManager* m) {
+    if (!on_manager_thread(m)) pthread_mutex_unlock(&m->lock);
+}
+
+// Caller holds m->lock (the manager thread does during a batch)
+static void detach(SerialManager* m, PortEntry* e) {
+    if (e->removed) return;
+    e->removed = true;
+    epoll_ctl(m->epoll_fd, EPOLL_CTL_DEL, e->port->fd, NULL);
+    fcntl(e->port->fd, F_SETFL, e->saved_flags);
+    e->port->manager = NULL;
+    e->port->entry = NULL;
+
+    if (e->prev) e->prev->next = e->next;
+    else m->ports = e->next;
+    if (e->next) e->next->prev = e->prev;
+
+    e->next = m->graveyard;
+    m->graveyard = e;
+}
+
+static void free_graveyard(SerialManager* m) {
+    while (m->graveyard) {
+        PortEntry* e = m->graveyard;
+        m->graveyard = e->next;
+        free(e);
+    }
+}
+
+static void* manager_thread(void* arg) {
+    SerialManager* m = arg;
+    struct epoll_event events[MANAGER_MAX_EVENTS];
+
+    for (;;) {
+        int n = epoll_wait(m->epoll_fd, events, MANAGER_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("RS232 Error: epoll_wait failed");
+            break;
+        }
+
+        uint64_t wake = easy_serial_raw_ns();
+        pthread_mutex_lock(&m->lock);
+        bool stop = false;
+        for (int i = 0; i < n; i++) {
+            PortEntry* e = events[i].data.ptr;
+            if (!e) {
+                stop = true;
+                continue;
+            }
+            if (e->removed) continue; // Removed by an earlier callback in this batch
+
+            // Level-triggered: one read per wakeup keeps ports fair
+            int r = read(e->port->fd, m->read_buf, sizeof(m->read_buf));
+            if (r > 0) {
+                SerialLatency* lat = &e->port->latency;
+                easy_serial_hist_record(&lat->read_bytes, r);
+                easy_serial_hist_record(&lat->wakeup_ns, easy_serial_raw_ns() - wake);
+                e->on_data(e->port, m->read_buf, r, e->user);
+            } else if ((r < 0 && errno != EAGAIN && errno != EINTR) ||
+                       (r == 0 && (events[i].events & (EPOLLHUP | EPOLLERR)))) {
+                if (r < 0) perror("RS232 Read Error");
+                SerialPort* port = e->port;
+                SerialDataFn fn = e->on_data;
+                void* user = e->user;
+                detach(m, e);
+                fn(port, NULL, 0, user);
+            }
+        }
+        free_graveyard(m);
+        pthread_mutex_unlock(&m->lock);
+
+        if (stop) break;
+    }
+    return NULL;
+}
+
+// --- Implementation ---
+
+static SerialManager* Manager_Create(void) {
+    SerialManager* m = calloc(1, sizeof(SerialManager));
+    if (!m) {
+        perror("RS232 Error: Out of memory");
+        return NULL;
+    }
+
+    m->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    m->stop_fd = eventfd(0, EFD_CLOEXEC);
+    pthread_mutex_init(&m->lock, NULL);
+
+    // data.ptr == NULL marks the stop event
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = NULL };
+    if (m->epoll_fd < 0 || m->stop_fd < 0 ||
+        epoll_ctl(m->epoll_fd, EPOLL_CTL_ADD, m->stop_fd, &ev) < 0 ||
+        pthread_create(&m->thread, NULL, manager_thread, m) != 0) {
+        perror("RS232 Error: Unable to start port manager");
+        if (m->epoll_fd >= 0) close(m->epoll_fd);
+        if (m->stop_fd >= 0) close(m->stop_fd);
+        pthread_mutex_destroy(&m->lock);
+        free(m);
+        return NULL;
+    }
+    return m;
+}
+
+static bool Manager_Add(SerialManager* m, SerialPort* port, SerialDataFn on_data, void* user) {
+    if (!m || !port || !on_data) return false;
+    if (port->manager) {
+        fprintf(stderr, "RS232 Error: Port already has a manager\n");
+        return false;
+    }
+
+    PortEntry* e = calloc(1, sizeof(PortEntry));
+    if (!e) return false;
+    e->port = port;
+    e->on_data = on_data;
+    e->user = user;
+    e->saved_flags = fcntl(port->fd, F_GETFL, 0);
+    fcntl(port->fd, F_SETFL, e->saved_flags | O_NONBLOCK);
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = e };
+    lock(m);
+    if (epoll_ctl(m->epoll_fd, EPOLL_CTL_ADD, port->fd, &ev) < 0) {
+        unlock(m);
+        perror("RS232 Error: Unable to add port");
+        fcntl(port->fd, F_SETFL, e->saved_flags);
+        free(e);
+        return false;
+    }
+    port->manager = m;
+    port->entry = e;
+    e->next = m->ports;
+    if (m->ports) m->ports->prev = e;
+    m->ports = e;
+    unlock(m);
+    return true;
+}
+
+static void Manager_Remove(SerialManager* m, SerialPort* port) {
+    if (!m || !port || port->manager != m) return;
+
+    // Inside a callback the entry may still be in the current batch, so
+    // the manager thread frees it once the batch is done
+    lock(m);
+    detach(m, port->entry);
+    if (!on_manager_thread(m)) free_graveyard(m);
+    unlock(m);
+}
+
+static void Manager_Destroy(SerialManager* m) {
+    if (!m) return;
+
+    uint64_t one = 1;
+    if (write(m->stop_fd, &one, sizeof(one)) < 0) perror("RS232 Error: Unable to stop port manager");
+    pthread_join(m->thread, NULL);
+
+    while (m->ports) detach(m, m->ports);
+    free_graveyard(m);
+
+    close(m->stop_fd);
+    close(m->epoll_fd);
+    pthread_mutex_destroy(&m->lock);
+    free(m);
+}
+
+// Map the functions to the struct instance
+const SerialManager_t PortManager = {
+    .Create = Manager_Create,
+    .Add = Manager_Add,
+    .Remove = Manager_Remove,
+    .Destroy = Manager_Destroy
+};
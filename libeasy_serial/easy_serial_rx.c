@@ -0,0 +1,363 @@
+#define _GNU_SOURCE
+#include "easy_serial_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+
+#define RX_DEFAULT_RING  (64 * 1024)
+#define RX_MIN_RING      256
+#define RX_MAX_RING      (1 << 30)
+#define RX_SCRATCH       4096
+#define RX_STAMPS        1024   // Chunk timestamps kept (power of two)
+
+// --- Internal Storage ---
+
+// Bytes from ring position 'start' on arrived with the wakeup at 'ns'
+typedef struct {
+    uint64_t start;
+    uint64_t ns;
+} RxStamp;
+
+// Single-producer/single-consumer ring. 'head' and 'tail' count bytes ever
+// written/read, so used = head - tail with no wrap ambiguity. Each side keeps
+// its own cache line and a cached copy of the other side's index, so the
+// shared lines are only touched when the cached view runs out.
+struct SerialRx {
+    // Producer (reader thread)
+    _Alignas(64) uint64_t head;
+    uint64_t tail_cache;
+    uint64_t stamp_head;
+
+    // Consumer (application thread)
+    _Alignas(64) uint64_t tail;
+    uint64_t head_cache;
+    uint64_t stamp_tail;    // Entry covering 'tail'; kept until the next one is reached
+
+    // Wakeup for bounded waits: futex word bumped only while someone waits
+    _Alignas(64) uint32_t seq;
+    int waiting;
+
+    _Alignas(64) uint8_t* buf;
+    uint32_t size;
+    uint32_t mask;
+
+    int fd;
+    int stop_fd;
+    pthread_t thread;
+    bool alive;             // Cleared when the reader thread exits
+
+    SerialRxStats_t stats;
+    SerialLatency* latency; // The port's histograms
+
+    // A second SPSC queue marking where each read() starts in the ring.
+    // When it is full, new chunks share the previous chunk's timestamp.
+    RxStamp stamps[RX_STAMPS];
+};
+
+// --- Helpers ---
+
+// RS232Rx always works on the default port
+static SerialRx* current_rx(void) {
+    SerialPort* port = easy_serial_default_port();
+    return port ? port->rx : NULL;
+}
+
+static void futex_wait(uint32_t* addr, uint32_t expected, int timeout_ms) {
+    struct timespec ts = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000L };
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, timeout_ms < 0 ? NULL : &ts, NULL, 0);
+}
+
+static void futex_wake(uint32_t* addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+static int64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Called by the producer after publishing new bytes (or on exit)
+static void wake_consumer(SerialRx* r) {
+    // Pairs with the store to 'waiting' in wait_for_data (Dekker style):
+    // either we see the waiter, or it sees the new head before sleeping
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&r->waiting, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&r->seq, 1, __ATOMIC_RELEASE);
+        futex_wake(&r->seq);
+    }
+}
+
+static void* reader_thread(void* arg) {
+    SerialRx* r = arg;
+    uint8_t scratch[RX_SCRATCH];
+    struct pollfd pfd[2] = {
+        { .fd = r->fd, .events = POLLIN },
+        { .fd = r->stop_fd, .events = POLLIN }
+    };
+
+    for (;;) {
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("RS232 Error: poll failed");
+            break;
+        }
+        if (pfd[1].revents) break;
+        if (pfd[0].revents & POLLNVAL) break;
+        if (!(pfd[0].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+        uint64_t wake = easy_serial_raw_ns();
+
+        uint64_t head = r->head;
+        uint64_t used = head - r->tail_cache;
+        if (used >= r->size) {
+            r->tail_cache = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+            used = head - r->tail_cache;
+        }
+
+        int n;
+        if (used >= r->size) {
+            // Ring full: keep draining the tty so the kernel buffer does not
+            // overflow too, and count what we had to throw away
+            n = read(r->fd, scratch, sizeof(scratch));
+            if (n > 0) __atomic_fetch_add(&r->stats.overruns, n, __ATOMIC_RELAXED);
+        } else {
+            // Read straight into the ring, up to the free space or its end
+            uint32_t off = (uint32_t)(head & r->mask);
+            uint64_t room = r->size - used;
+            if (room > r->size - off) room = r->size - off;
+
+            n = read(r->fd, r->buf + off, room);
+            if (n > 0) {
+                // The stamp must be visible before the bytes it describes
+                uint64_t sh = r->stamp_head;
+                if (sh - __atomic_load_n(&r->stamp_tail, __ATOMIC_ACQUIRE) < RX_STAMPS) {
+                    r->stamps[sh & (RX_STAMPS - 1)] = (RxStamp){ head, wake };
+                    __atomic_store_n(&r->stamp_head, sh + 1, __ATOMIC_RELEASE);
+                }
+                easy_serial_hist_record(&r->latency->read_bytes, n);
+                __atomic_store_n(&r->head, head + n, __ATOMIC_RELEASE);
+                __atomic_fetch_add(&r->stats.bytes, n, __ATOMIC_RELAXED);
+                if (used + n > r->stats.high_water) {
+                    __atomic_store_n(&r->stats.high_water, (uint32_t)(used + n), __ATOMIC_RELAXED);
+                }
+                wake_consumer(r);
+            }
+        }
+
+        if (n < 0 && errno != EAGAIN && errno != EINTR) {
+            perror("RS232 Read Error");
+            break;
+        }
+        if (n == 0 && (pfd[0].revents & (POLLHUP | POLLERR))) break; // Device gone
+    }
+
+    __atomic_store_n(&r->alive, false, __ATOMIC_RELEASE);
+    wake_consumer(r);
+    return NULL;
+}
+
+// Timestamp of the chunk holding ring position 'pos' (0 if none), and
+// where that chunk ends. Drops entries the consumer has moved past.
+static uint64_t stamp_at(SerialRx* r, uint64_t pos, uint64_t* chunk_end) {
+    uint64_t sh = __atomic_load_n(&r->stamp_head, __ATOMIC_ACQUIRE);
+    uint64_t st = r->stamp_tail;
+
+    while (st + 1 < sh && r->stamps[(st + 1) & (RX_STAMPS - 1)].start <= pos) st++;
+    if (st != r->stamp_tail) __atomic_store_n(&r->stamp_tail, st, __ATOMIC_RELEASE);
+
+    *chunk_end = (st + 1 < sh) ? r->stamps[(st + 1) & (RX_STAMPS - 1)].start : UINT64_MAX;
+    return (st < sh) ? r->stamps[st & (RX_STAMPS - 1)].ns : 0;
+}
+
+// Bytes available to the consumer, waiting up to timeout_ms for some
+static uint64_t wait_for_data(SerialRx* r, int timeout_ms) {
+    int64_t deadline = (timeout_ms > 0) ? now_ms() + timeout_ms : 0;
+
+    for (;;) {
+        uint64_t avail = r->head_cache - r->tail;
+        if (avail) return avail;
+        r->head_cache = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+        avail = r->head_cache - r->tail;
+        if (avail || timeout_ms == 0 || !__atomic_load_n(&r->alive, __ATOMIC_ACQUIRE)) return avail;
+
+        int wait = -1;
+        if (timeout_ms > 0) {
+            int64_t left = deadline - now_ms();
+            if (left <= 0) return 0;
+            wait = (int)left;
+        }
+
+        uint32_t seen = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&r->waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) == r->tail &&
+            __atomic_load_n(&r->alive, __ATOMIC_ACQUIRE)) {
+            futex_wait(&r->seq, seen, wait);
+        }
+        __atomic_store_n(&r->waiting, 0, __ATOMIC_RELAXED);
+    }
+}
+
+// --- Implementation ---
+
+static bool Rx_Start(int ring_size) {
+    SerialPort* port = easy_serial_default_port();
+    if (!port) {
+        fprintf(stderr, "RS232 Error: Port not open\n");
+        return false;
+    }
+    if (port->rx) return true;
+
+    uint32_t size = RX_MIN_RING;
+    if (ring_size <= 0) ring_size = RX_DEFAULT_RING;
+    if (ring_size > RX_MAX_RING) ring_size = RX_MAX_RING;
+    while (size < (uint32_t)ring_size) size <<= 1;
+
+    SerialRx* r = aligned_alloc(64, sizeof(SerialRx));
+    if (!r) {
+        perror("RS232 Error: Unable to start reader");
+        return false;
+    }
+    memset(r, 0, sizeof(*r));
+    r->buf = malloc(size);
+    r->stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (!r->buf || r->stop_fd < 0) {
+        perror("RS232 Error: Unable to start reader");
+        free(r->buf);
+        if (r->stop_fd >= 0) close(r->stop_fd);
+        free(r);
+        return false;
+    }
+    r->size = size;
+    r->mask = size - 1;
+    r->fd = port->fd;
+    r->stats.capacity = size;
+    r->latency = &port->latency;
+    r->alive = true;
+
+    if (pthread_create(&r->thread, NULL, reader_thread, r) != 0) {
+        fprintf(stderr, "RS232 Error: Unable to create reader thread\n");
+        free(r->buf);
+        close(r->stop_fd);
+        free(r);
+        return false;
+    }
+    port->rx = r;
+    printf("RS232: Async receive started (%u byte ring).\n", size);
+    return true;
+}
+
+static int Rx_Peek(SerialSpan_t* span, int timeout_ms) {
+    SerialRx* r = current_rx();
+    if (!r) return -1;
+
+    uint64_t avail = wait_for_data(r, timeout_ms);
+    if (avail == 0) {
+        span->data = NULL;
+        span->length = 0;
+        return __atomic_load_n(&r->alive, __ATOMIC_ACQUIRE) ? 0 : -1;
+    }
+
+    uint32_t off = (uint32_t)(r->tail & r->mask);
+    if (avail > r->size - off) avail = r->size - off;
+    span->data = r->buf + off;
+    span->length = (int)avail;
+    return span->length;
+}
+
+static void Rx_Consume(int count) {
+    SerialRx* r = current_rx();
+    if (!r || count <= 0) return;
+    uint64_t avail = r->head_cache - r->tail;
+    if ((uint64_t)count > avail) count = (int)avail;
+    if (count == 0) return;
+
+    // One sample per hand-over, for the oldest byte in it
+    uint64_t end;
+    uint64_t stamp = stamp_at(r, r->tail, &end);
+    if (stamp) easy_serial_hist_record(&r->latency->wakeup_ns, easy_serial_raw_ns() - stamp);
+    __atomic_store_n(&r->tail, r->tail + count, __ATOMIC_RELEASE);
+}
+
+static int Rx_Read(uint8_t* buffer, int max_len, int timeout_ms) {
+    SerialSpan_t span;
+    int total = 0;
+
+    // Two spans at most: up to the end of the ring, then from its start
+    while (total < max_len) {
+        int n = Rx_Peek(&span, total ? 0 : timeout_ms);
+        if (n <= 0) return total ? total : n;
+        if (n > max_len - total) n = max_len - total;
+        memcpy(buffer + total, span.data, n);
+        Rx_Consume(n);
+        total += n;
+    }
+    return total;
+}
+
+static int Rx_ReadStamped(uint8_t* buffer, int max_len, int timeout_ms, uint64_t* stamp_ns) {
+    SerialRx* r = current_rx();
+    SerialSpan_t span;
+
+    int n = Rx_Peek(&span, timeout_ms);
+    if (n <= 0) return n;
+
+    // Stop at the end of the chunk so every byte returned shares the stamp
+    uint64_t end;
+    uint64_t stamp = stamp_at(r, r->tail, &end);
+    if (end - r->tail < (uint64_t)n) n = (int)(end - r->tail);
+    if (n > max_len) n = max_len;
+
+    memcpy(buffer, span.data, n);
+    Rx_Consume(n);
+    if (stamp_ns) *stamp_ns = stamp;
+    return n;
+}
+
+static void Rx_Stats(SerialRxStats_t* stats) {
+    SerialRx* r = current_rx();
+    memset(stats, 0, sizeof(*stats));
+    if (!r) return;
+    stats->bytes = __atomic_load_n(&r->stats.bytes, __ATOMIC_RELAXED);
+    stats->overruns = __atomic_load_n(&r->stats.overruns, __ATOMIC_RELAXED);
+    stats->high_water = __atomic_load_n(&r->stats.high_water, __ATOMIC_RELAXED);
+    stats->capacity = r->stats.capacity;
+}
+
+void easy_serial_rx_stop(SerialPort* port) {
+    if (!port || !port->rx) return;
+    SerialRx* r = port->rx;
+
+    uint64_t one = 1;
+    if (write(r->stop_fd, &one, sizeof(one)) < 0) perror("RS232 Error: Unable to stop reader");
+    pthread_join(r->thread, NULL);
+
+    close(r->stop_fd);
+    free(r->buf);
+    free(r);
+    port->rx = NULL;
+    printf("RS232: Async receive stopped.\n");
+}
+
+static void Rx_Stop(void) {
+    easy_serial_rx_stop(easy_serial_default_port());
+}
+
+// Map the functions to the struct instance
+const SerialAsync_t RS232Rx = {
+    .Start = Rx_Start,
+    .Peek = Rx_Peek,
+    .Consume = Rx_Consume,
+    .Read = Rx_Read,
+    .ReadStamped = Rx_ReadStamped,
+    .Stats = Rx_Stats,
+    .Stop = Rx_Stop
+};
\ No newline at end of file
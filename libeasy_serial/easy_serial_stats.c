@@ -0,0 +1,81 @@
+#include "easy_serial_internal.h"
+#include <string.h>
+#include <time.h>
+
+// --- Helpers ---
+
+static int bucket_of(uint64_t v) {
+    if (v < HIST_LINEAR) return (int)v;
+    int msb = 63 - __builtin_clzll(v);          // >= 5
+    int shift = msb - 4;                        // Keep the top 5 bits
+    return HIST_LINEAR + (msb - 5) * HIST_SUB + (int)((v >> shift) - HIST_SUB);
+}
+
+// Largest value that lands in bucket 'idx'
+static uint64_t bucket_top(int idx) {
+    if (idx < HIST_LINEAR) return (uint64_t)idx;
+    int k = idx - HIST_LINEAR;
+    int shift = k / HIST_SUB + 1;
+    uint64_t top = (uint64_t)(k % HIST_SUB + HIST_SUB);
+    return ((top + 1) << shift) - 1;            // Wraps to UINT64_MAX for the last one
+}
+
+static void store_max(uint64_t* p, uint64_t v) {
+    uint64_t cur = __atomic_load_n(p, __ATOMIC_RELAXED);
+    while (v > cur && !__atomic_compare_exchange_n(p, &cur, v, true,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+}
+
+// --- Implementation ---
+
+uint64_t easy_serial_raw_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void easy_serial_hist_record(SerialHist* h, uint64_t value) {
+    __atomic_fetch_add(&h->buckets[bucket_of(value)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->sum, value, __ATOMIC_RELAXED);
+    store_max(&h->max, value);
+    store_max(&h->min_inv, ~value);
+}
+
+void easy_serial_hist_snapshot(SerialHist* h, SerialHistogram_t* out) {
+    static const double quantiles[4] = { 0.50, 0.90, 0.99, 0.999 };
+    uint64_t* results[4] = { &out->p50, &out->p90, &out->p99, &out->p999 };
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total = 0;
+
+    memset(out, 0, sizeof(*out));
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        counts[i] = __atomic_load_n(&h->buckets[i], __ATOMIC_RELAXED);
+        total += counts[i];
+    }
+    if (total == 0) return;
+
+    out->count = total;
+    out->max = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+    out->min = ~__atomic_load_n(&h->min_inv, __ATOMIC_RELAXED);
+    out->mean = __atomic_load_n(&h->sum, __ATOMIC_RELAXED) / total;
+
+    // One pass over the buckets for all quantiles
+    uint64_t seen = 0;
+    int q = 0;
+    for (int i = 0; i < HIST_BUCKETS && q < 4; i++) {
+        seen += counts[i];
+        while (q < 4 && seen >= (uint64_t)(quantiles[q] * total + 0.999999)) {
+            uint64_t v = bucket_top(i);
+            if (v > out->max) v = out->max;
+            if (v < out->min) v = out->min;
+            *results[q++] = v;
+        }
+    }
+}
+
+void easy_serial_hist_reset(SerialHist* h) {
+    for (int i = 0; i < HIST_BUCKETS; i++) __atomic_store_n(&h->buckets[i], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->sum, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->max, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->min_inv, 0, __ATOMIC_RELAXED);
+}
\ No newline at end of file
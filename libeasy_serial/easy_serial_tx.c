@@ -0,0 +1,328 @@
+#define _GNU_SOURCE
+#include "easy_serial_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#define TX_DEFAULT_QUEUE  (64 * 1024)
+#define TX_MIN_QUEUE      256
+#define TX_MAX_QUEUE      (1 << 30)
+#define TX_OUTQ_POLL_NS   1000000L     // TIOCOUTQ re-check interval in Drain
+
+// --- Internal Storage ---
+
+// Byte ring like the receive side, but with many producers: Send takes
+// 'send_lock' to reserve and fill space, the writer thread only moves 'tail'.
+// Everything between tail and head goes out in one writev() (two iovecs when
+// it wraps), so messages queued while a write is in progress are coalesced.
+struct TxQueue {
+    // Producers
+    _Alignas(64) uint64_t head;
+    uint64_t tail_cache;
+    pthread_mutex_t send_lock;
+
+    // Writer thread
+    _Alignas(64) uint64_t tail;
+
+    // Wakeups: 'work' for the writer, 'progress' for Drain callers.
+    // Each futex word is only bumped while someone waits on it.
+    _Alignas(64) uint32_t work_seq;
+    int writer_waiting;
+    uint32_t progress_seq;
+    int drainers;
+    bool stop;
+
+    _Alignas(64) uint8_t* buf;
+    uint32_t size;
+    uint32_t mask;
+
+    int fd;
+    SerialLatency* latency;    // The port's histograms
+    pthread_t thread;
+
+    SerialTxStats_t stats;
+};
+
+// --- Helpers ---
+
+static void futex_wait(uint32_t* addr, uint32_t expected, int timeout_ms) {
+    struct timespec ts = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000L };
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, timeout_ms < 0 ? NULL : &ts, NULL, 0);
+}
+
+static void futex_wake(uint32_t* addr, int count) {
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+static int64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void count(uint64_t* counter, uint64_t n) {
+    __atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+}
+
+// Called by Send after publishing a message (Dekker style, see the rx side)
+static void wake_writer(TxQueue* q) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&q->writer_waiting, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&q->work_seq, 1, __ATOMIC_RELEASE);
+        futex_wake(&q->work_seq, 1);
+    }
+}
+
+// Called by the writer after moving 'tail'
+static void wake_drainers(TxQueue* q) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&q->drainers, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&q->progress_seq, 1, __ATOMIC_RELEASE);
+        futex_wake(&q->progress_seq, INT_MAX);
+    }
+}
+
+static void wait_for_work(TxQueue* q) {
+    uint32_t seen = __atomic_load_n(&q->work_seq, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&q->writer_waiting, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&q->head, __ATOMIC_ACQUIRE) == q->tail &&
+        !__atomic_load_n(&q->stop, __ATOMIC_ACQUIRE)) {
+        futex_wait(&q->work_seq, seen, -1);
+    }
+    __atomic_store_n(&q->writer_waiting, 0, __ATOMIC_RELAXED);
+}
+
+static void* writer_thread(void* arg) {
+    TxQueue* q = arg;
+
+    for (;;) {
+        uint64_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+        uint64_t tail = q->tail;
+        if (head == tail) {
+            if (__atomic_load_n(&q->stop, __ATOMIC_ACQUIRE)) break;
+            wait_for_work(q);
+            continue;
+        }
+
+        // Everything pending, in at most two pieces
+        uint64_t pending = head - tail;
+        uint32_t off = (uint32_t)(tail & q->mask);
+        struct iovec iov[2];
+        int iovcnt = 1;
+        iov[0].iov_base = q->buf + off;
+        iov[0].iov_len = (pending > q->size - off) ? q->size - off : pending;
+        if (pending > iov[0].iov_len) {
+            iov[1].iov_base = q->buf;
+            iov[1].iov_len = pending - iov[0].iov_len;
+            iovcnt = 2;
+        }
+
+        uint64_t start = easy_serial_raw_ns();
+        ssize_t n = writev(q->fd, iov, iovcnt);
+        easy_serial_hist_record(&q->latency->write_ns, easy_serial_raw_ns() - start);
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) {
+                // Non-blocking fd (e.g. added to a PortManager): wait for room
+                struct pollfd pfd = { .fd = q->fd, .events = POLLOUT };
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            // Drop what is queued so Drain callers see the failure instead of
+            // waiting for bytes that will never go out
+            perror("RS232 Write Error");
+            count(&q->stats.errors, 1);
+            n = (ssize_t)pending;
+        } else {
+            count(&q->stats.writes, 1);
+            count(&q->stats.bytes, n);
+            if ((uint64_t)n < pending) count(&q->stats.partial, 1);
+        }
+
+        __atomic_store_n(&q->tail, tail + n, __ATOMIC_RELEASE);
+        wake_drainers(q);
+    }
+    return NULL;
+}
+
+// --- Implementation ---
+
+static bool Tx_Start(SerialPort* port, int queue_size) {
+    if (!port) {
+        fprintf(stderr, "RS232 Error: Port not open\n");
+        return false;
+    }
+    if (port->tx) return true;
+
+    uint32_t size = TX_MIN_QUEUE;
+    if (queue_size <= 0) queue_size = TX_DEFAULT_QUEUE;
+    if (queue_size > TX_MAX_QUEUE) queue_size = TX_MAX_QUEUE;
+    while (size < (uint32_t)queue_size) size <<= 1;
+
+    TxQueue* q = aligned_alloc(64, sizeof(TxQueue));
+    if (!q) {
+        perror("RS232 Error: Unable to start writer");
+        return false;
+    }
+    memset(q, 0, sizeof(*q));
+    q->buf = malloc(size);
+    if (!q->buf) {
+        perror("RS232 Error: Unable to start writer");
+        free(q);
+        return false;
+    }
+    pthread_mutex_init(&q->send_lock, NULL);
+    q->size = size;
+    q->mask = size - 1;
+    q->fd = port->fd;
+    q->latency = &port->latency;
+    q->stats.capacity = size;
+
+    if (pthread_create(&q->thread, NULL, writer_thread, q) != 0) {
+        fprintf(stderr, "RS232 Error: Unable to create writer thread\n");
+        pthread_mutex_destroy(&q->send_lock);
+        free(q->buf);
+        free(q);
+        return false;
+    }
+    port->tx = q;
+    printf("RS232: Async transmit started (%u byte queue).\n", size);
+    return true;
+}
+
+static bool Tx_Send(SerialPort* port, const uint8_t* data, int length) {
+    if (!port || !port->tx || length < 0) return false;
+    if (length == 0) return true;
+    TxQueue* q = port->tx;
+
+    if ((uint32_t)length > q->size) {
+        count(&q->stats.rejected, 1);
+        return false;
+    }
+
+    pthread_mutex_lock(&q->send_lock);
+    uint64_t head = q->head;
+    if (q->size - (head - q->tail_cache) < (uint64_t)length) {
+        q->tail_cache = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+        if (q->size - (head - q->tail_cache) < (uint64_t)length) {
+            pthread_mutex_unlock(&q->send_lock);
+            count(&q->stats.rejected, 1);
+            return false;
+        }
+    }
+
+    uint32_t off = (uint32_t)(head & q->mask);
+    uint32_t first = (uint32_t)length < q->size - off ? (uint32_t)length : q->size - off;
+    memcpy(q->buf + off, data, first);
+    memcpy(q->buf, data + first, length - first);
+    __atomic_store_n(&q->head, head + length, __ATOMIC_RELEASE);
+
+    uint64_t used = head + length - q->tail_cache;
+    if (used > q->stats.high_water) {
+        __atomic_store_n(&q->stats.high_water, (uint32_t)used, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&q->send_lock);
+
+    count(&q->stats.messages, 1);
+    wake_writer(q);
+    return true;
+}
+
+static bool Tx_Drain(SerialPort* port, int timeout_ms) {
+    if (!port || !port->tx) return false;
+    TxQueue* q = port->tx;
+    int64_t deadline = (timeout_ms >= 0) ? now_ms() + timeout_ms : INT64_MAX;
+    uint64_t errors = __atomic_load_n(&q->stats.errors, __ATOMIC_RELAXED);
+
+    // 1. Everything queued so far handed to the driver
+    uint64_t target = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    while (__atomic_load_n(&q->tail, __ATOMIC_ACQUIRE) < target) {
+        int wait = -1;
+        if (timeout_ms >= 0) {
+            int64_t left = deadline - now_ms();
+            if (left <= 0) return false;
+            wait = (int)left;
+        }
+
+        uint32_t seen = __atomic_load_n(&q->progress_seq, __ATOMIC_ACQUIRE);
+        __atomic_fetch_add(&q->drainers, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&q->tail, __ATOMIC_ACQUIRE) < target) {
+            futex_wait(&q->progress_seq, seen, wait);
+        }
+        __atomic_fetch_sub(&q->drainers, 1, __ATOMIC_RELAXED);
+    }
+    if (__atomic_load_n(&q->stats.errors, __ATOMIC_RELAXED) != errors) return false;
+
+    // 2. The driver's own buffer sent down the wire. tcdrain() would do this
+    //    but cannot time out.
+    int outq = 0;
+    struct timespec pause = { 0, TX_OUTQ_POLL_NS };
+    while (ioctl(q->fd, TIOCOUTQ, &outq) == 0 && outq > 0) {
+        if (now_ms() >= deadline) return false;
+        nanosleep(&pause, NULL);
+    }
+    return true;
+}
+
+static void Tx_Stats(SerialPort* port, SerialTxStats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!port || !port->tx) return;
+    TxQueue* q = port->tx;
+    stats->messages = __atomic_load_n(&q->stats.messages, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n(&q->stats.bytes, __ATOMIC_RELAXED);
+    stats->writes = __atomic_load_n(&q->stats.writes, __ATOMIC_RELAXED);
+    stats->partial = __atomic_load_n(&q->stats.partial, __ATOMIC_RELAXED);
+    stats->rejected = __atomic_load_n(&q->stats.rejected, __ATOMIC_RELAXED);
+    stats->errors = __atomic_load_n(&q->stats.errors, __ATOMIC_RELAXED);
+    stats->high_water = __atomic_load_n(&q->stats.high_water, __ATOMIC_RELAXED);
+    stats->capacity = q->stats.capacity;
+}
+
+void easy_serial_tx_stop(SerialPort* port, int drain_ms) {
+    if (!port || !port->tx) return;
+    TxQueue* q = port->tx;
+
+    if (drain_ms > 0 && !Tx_Drain(port, drain_ms)) {
+        fprintf(stderr, "RS232 Error: Transmit queue not drained, dropping the rest\n");
+    }
+
+    __atomic_store_n(&q->stop, true, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&q->work_seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&q->work_seq, 1);
+    // A writev() or poll() stuck on a stalled port (e.g. flow control)
+    // would never return; both are cancellation points.
+    pthread_cancel(q->thread);
+    pthread_join(q->thread, NULL);
+
+    pthread_mutex_destroy(&q->send_lock);
+    free(q->buf);
+    free(q);
+    port->tx = NULL;
+    printf("RS232: Async transmit stopped.\n");
+}
+
+static void Tx_Stop(SerialPort* port) {
+    easy_serial_tx_stop(port, 0);
+}
+
+// Map the functions to the struct instance
+const SerialTxQueue_t SerialTx = {
+    .Start = Tx_Start,
+    .Send = Tx_Send,
+    .Drain = Tx_Drain,
+    .Stats = Tx_Stats,
+    .Stop = Tx_Stop
+};
\ No newline at end of file
@@ -0,0 +1,331 @@
+/*
+ * Serial-to-TCP bridge over a pty and loopback.
+ *
+ * The pty slave plays the serial port; the benchmark writes "device" data
+ * into the master and reads what clients send back from it.
+ *
+ *   fanout  - a counting byte pattern is streamed into the master while
+ *             1, 4 and 16 clients read; the device stays at most 1 MiB
+ *             ahead of the slowest client, so nothing may be dropped.
+ *             Reported: MB/s from the port and whether every client got
+ *             every byte in order, for splice (BRIDGE_AUTO) and the shared
+ *             ring (BRIDGE_COPY)
+ *   slow    - one client never reads: it must lose data (dropped) while a
+ *             normal client still receives everything. Then the port
+ *             trickles 16-byte chunks to a client that never reads: it
+ *             should keep about the default 64 KiB backlog in either mode
+ *   upload  - one client sends to the port, the master checks the bytes
+ *
+ * Usage: ./bench/bench_bridge [megabytes]
+ */
+#define _GNU_SOURCE // posix_openpt, ptsname
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT       19011
+#define MAX_CLIENT 16
+#define PATTERN    251   // Prime, so the pattern never lines up with buffer sizes
+
+#define WINDOW     (1 << 20)  // Most bytes the device runs ahead of the slowest client
+
+typedef struct {
+    int master;
+    long bytes;
+    bool paced;        // Wait for 'slowest' to catch up (lossless runs)
+} DeviceArgs;
+
+static FILE* out;
+static long slowest;   // Bytes received by the slowest reading client
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Returns the master; *slave gets the raw "serial port" end
+static int open_pty(int* slave) {
+    int m = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m < 0 || grantpt(m) < 0 || unlockpt(m) < 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+    *slave = open(ptsname(m), O_RDWR | O_NOCTTY);
+    struct termios t;
+    tcgetattr(*slave, &t);
+    cfmakeraw(&t);
+    tcsetattr(*slave, TCSANOW, &t);
+    return m;
+}
+
+static void* device_writer(void* arg) {
+    DeviceArgs* a = arg;
+    static uint8_t block[PATTERN * 64];
+    for (int i = 0; i < (int)sizeof(block); i++) block[i] = (uint8_t)(i % PATTERN);
+
+    long sent = 0;
+    while (sent < a->bytes) {
+        if (a->paced && sent - __atomic_load_n(&slowest, __ATOMIC_ACQUIRE) > WINDOW) {
+            sched_yield();
+            continue;
+        }
+        // Start where the pattern left off
+        long len = a->bytes - sent;
+        if (len > (long)sizeof(block) - PATTERN) len = sizeof(block) - PATTERN;
+        ssize_t n = write(a->master, block + sent % PATTERN, len);
+        if (n <= 0) break;
+        sent += n;
+    }
+    return NULL;
+}
+
+static int connect_clients(int count, int* fds) {
+    for (int i = 0; i < count; i++) {
+        fds[i] = Socket.Connect("127.0.0.1", PORT);
+        if (fds[i] < 0) return -1;
+    }
+    return 0;
+}
+
+static void wait_clients(EasyBridge* b, uint32_t count) {
+    EasyBridgeStats_t st;
+    do {
+        usleep(1000);
+        Bridge.Stats(b, &st);
+    } while (st.clients < count);
+}
+
+// Reads every client until 'bytes' arrived on each (or a 2 s stall);
+// returns the number of clients that got the whole pattern in order
+static int read_clients(int* fds, int count, long bytes) {
+    struct pollfd pfd[MAX_CLIENT];
+    long got[MAX_CLIENT] = { 0 };
+    bool ok[MAX_CLIENT];
+    static uint8_t buf[65536];
+    int done = 0;
+
+    __atomic_store_n(&slowest, 0, __ATOMIC_RELEASE);
+    for (int i = 0; i < count; i++) {
+        pfd[i].fd = fds[i];
+        pfd[i].events = POLLIN;
+        ok[i] = true;
+    }
+    while (done < count) {
+        if (poll(pfd, count, 2000) <= 0) break;
+        for (int i = 0; i < count; i++) {
+            if (!(pfd[i].revents & POLLIN)) continue;
+            ssize_t n = recv(fds[i], buf, sizeof(buf), MSG_DONTWAIT);
+            if (n <= 0) continue;
+            for (ssize_t k = 0; k < n; k++) {
+                if (buf[k] != (uint8_t)((got[i] + k) % PATTERN)) ok[i] = false;
+            }
+            got[i] += n;
+            if (got[i] >= bytes) {
+                pfd[i].fd = -1;
+                done++;
+            }
+        }
+        long low = bytes;
+        for (int i = 0; i < count; i++) low = (got[i] < low) ? got[i] : low;
+        __atomic_store_n(&slowest, low, __ATOMIC_RELEASE);
+    }
+
+    int complete = 0;
+    for (int i = 0; i < count; i++) complete += (ok[i] && got[i] == bytes);
+    return complete;
+}
+
+static void run_fanout(EasyBridgeMode_t mode, int clients, long bytes) {
+    int slave, m = open_pty(&slave);
+    if (m < 0) return;
+    EasyBridge* b = Bridge.Start(slave, PORT, mode, 4 << 20);
+    if (!b) return;
+
+    int fds[MAX_CLIENT];
+    if (connect_clients(clients, fds) < 0) return;
+    wait_clients(b, clients);
+
+    DeviceArgs args = { m, bytes, true };
+    pthread_t tid;
+    double t0 = now_s();
+    pthread_create(&tid, NULL, device_writer, &args);
+    int complete = read_clients(fds, clients, bytes);
+    double elapsed = now_s() - t0;
+    pthread_join(tid, NULL);
+
+    EasyBridgeStats_t st;
+    Bridge.Stats(b, &st);
+    fprintf(out, "%-7s %7d %10.1f %12.1f %9d/%-3d %10llu\n", st.spliced ? "splice" : "copy",
+            clients, bytes / elapsed / 1e6, (double)st.client_out / elapsed / 1e6,
+            complete, clients, (unsigned long long)st.dropped);
+
+    for (int i = 0; i < clients; i++) close(fds[i]);
+    Bridge.Stop(b);
+    close(slave);
+    close(m);
+}
+
+static void run_slow(EasyBridgeMode_t mode, long bytes) {
+    int slave, m = open_pty(&slave);
+    if (m < 0) return;
+    EasyBridge* b = Bridge.Start(slave, PORT, mode, 256 * 1024);
+    if (!b) return;
+
+    int fds[2];
+    if (connect_clients(2, fds) < 0) return;
+    int small = 4096;
+    setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &small, sizeof(small)); // The one that never reads
+    wait_clients(b, 2);
+
+    DeviceArgs args = { m, bytes, false };
+    pthread_t tid;
+    pthread_create(&tid, NULL, device_writer, &args);
+    int complete = read_clients(fds, 1, bytes);
+    pthread_join(tid, NULL);
+
+    EasyBridgeStats_t st;
+    Bridge.Stats(b, &st);
+    fprintf(out, "%-7s fast client %s, slow client dropped %llu bytes\n", st.spliced ? "splice" : "copy",
+            complete ? "complete" : "INCOMPLETE", (unsigned long long)st.dropped);
+
+    close(fds[0]);
+    close(fds[1]);
+    Bridge.Stop(b);
+    close(slave);
+    close(m);
+}
+
+// 16-byte serial reads: each would take a whole pipe slot if tee'd one by one.
+// The client is a socketpair with small buffers, so what it gets once it
+// finally reads is almost all backlog the bridge kept for it.
+static void run_slow_small(EasyBridgeMode_t mode) {
+    int slave, m = open_pty(&slave);
+    if (m < 0) return;
+    EasyBridge* b = Bridge.Start(slave, 0, mode, 0);
+    if (!b) return;
+
+    int sv[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    int small = 4096;
+    setsockopt(sv[1], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+    Bridge.AddClient(b, sv[1]);
+    wait_clients(b, 1);
+
+    uint8_t chunk[16];
+    for (long sent = 0; sent < 256 * 1024; sent += sizeof(chunk)) {
+        for (int k = 0; k < (int)sizeof(chunk); k++) chunk[k] = (uint8_t)((sent + k) % PATTERN);
+        if (write(m, chunk, sizeof(chunk)) != (ssize_t)sizeof(chunk)) break;
+        usleep(10); // Let the bridge read each chunk on its own
+    }
+    usleep(100000);
+
+    static uint8_t buf[65536];
+    long kept = 0;
+    struct pollfd pfd = { .fd = sv[0], .events = POLLIN };
+    while (poll(&pfd, 1, 200) > 0) {
+        ssize_t n = recv(sv[0], buf, sizeof(buf), MSG_DONTWAIT);
+        if (n <= 0) break;
+        kept += n;
+    }
+
+    EasyBridgeStats_t st;
+    Bridge.Stats(b, &st);
+    fprintf(out, "%-7s 16-byte reads, stalled client kept %ld bytes, dropped %llu\n",
+            st.spliced ? "splice" : "copy", kept, (unsigned long long)st.dropped);
+
+    close(sv[0]);
+    Bridge.Stop(b);
+    close(slave);
+    close(m);
+}
+
+static void run_upload(EasyBridgeMode_t mode, long bytes) {
+    int slave, m = open_pty(&slave);
+    if (m < 0) return;
+    EasyBridge* b = Bridge.Start(slave, 0, mode, 0);
+    if (!b) return;
+
+    int sv[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sv); // AddClient takes any connected socket
+    Bridge.AddClient(b, sv[1]);
+
+    static uint8_t block[PATTERN * 64];
+    for (int i = 0; i < (int)sizeof(block); i++) block[i] = (uint8_t)(i % PATTERN);
+
+    double t0 = now_s();
+    long sent = 0, got = 0;
+    bool ok = true;
+    static uint8_t buf[65536];
+    fcntl(sv[0], F_SETFL, O_NONBLOCK);
+    while (got < bytes) {
+        if (sent < bytes) {
+            long len = bytes - sent;
+            if (len > (long)sizeof(block) - PATTERN) len = sizeof(block) - PATTERN;
+            ssize_t n = send(sv[0], block + sent % PATTERN, len, MSG_NOSIGNAL);
+            if (n > 0) sent += n;
+        }
+        struct pollfd pfd = { .fd = m, .events = POLLIN };
+        if (poll(&pfd, 1, sent < bytes ? 0 : 2000) < 0) break;
+        if (!(pfd.revents & POLLIN)) {
+            if (sent >= bytes) break;
+            continue;
+        }
+        ssize_t n = read(m, buf, sizeof(buf));
+        if (n <= 0) break;
+        for (ssize_t k = 0; k < n; k++) {
+            if (buf[k] != (uint8_t)((got + k) % PATTERN)) ok = false;
+        }
+        got += n;
+    }
+    double elapsed = now_s() - t0;
+
+    EasyBridgeStats_t st;
+    Bridge.Stats(b, &st);
+    fprintf(out, "%-7s upload %.1f MB/s, %s\n", mode == BRIDGE_COPY ? "copy" : "splice",
+            got / elapsed / 1e6, (ok && got == bytes && st.serial_out == (uint64_t)bytes) ? "intact" : "CORRUPT");
+
+    close(sv[0]);
+    Bridge.Stop(b);
+    close(slave);
+    close(m);
+}
+
+int main(int argc, char** argv) {
+    int mb = (argc > 1) ? atoi(argv[1]) : 64;
+    if (mb <= 0) mb = 64;
+    long bytes = (long)mb << 20;
+
+    // The library logs to stdout; keep our results separate
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    freopen("/dev/null", "w", stdout);
+
+    fprintf(out, "%-7s %7s %10s %12s %13s %10s\n", "mode", "clients", "port MB/s", "clients MB/s", "complete", "dropped");
+    int counts[] = { 1, 4, 16 };
+    for (int i = 0; i < 3; i++) {
+        run_fanout(BRIDGE_AUTO, counts[i], bytes);
+        run_fanout(BRIDGE_COPY, counts[i], bytes);
+    }
+
+    fprintf(out, "\n");
+    run_slow(BRIDGE_AUTO, bytes);
+    run_slow(BRIDGE_COPY, bytes);
+    run_slow_small(BRIDGE_AUTO);
+    run_slow_small(BRIDGE_COPY);
+
+    fprintf(out, "\n");
+    run_upload(BRIDGE_AUTO, bytes / 4);
+    run_upload(BRIDGE_COPY, bytes / 4);
+
+    fclose(out);
+    return 0;
+}
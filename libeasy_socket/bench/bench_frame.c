@@ -0,0 +1,139 @@
+/*
+ * Loopback benchmark: hand-rolled length-prefix reassembly vs. Channel.
+ *
+ * A sender thread pushes length-prefixed messages with Channel.Send.
+ * The receiver either reads header + payload with read() and mallocs a copy
+ * of every message (the usual application code), or uses Channel.Read.
+ * read() syscalls are taken from /proc/thread-self/io.
+ *
+ * Usage: ./bench/bench_frame [messages] [payload_bytes]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+
+#define PORT 19004
+
+typedef struct {
+    int fd;
+    long count;
+    uint32_t size;
+} SenderArgs;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long read_syscalls(void) {
+    long syscr = -1;
+    char line[128];
+    FILE* f = fopen("/proc/thread-self/io", "r");
+    if (!f) return -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "syscr: %ld", &syscr) == 1) break;
+    }
+    fclose(f);
+    return syscr;
+}
+
+static void* sender(void* arg) {
+    SenderArgs* a = arg;
+    uint8_t* payload = malloc(a->size);
+    for (uint32_t i = 0; i < a->size; i++) payload[i] = (uint8_t)i; // NULs included
+
+    EasyChannel* ch = Channel.Open(a->fd, FRAME_LENGTH_PREFIX, 0, 0);
+    for (long i = 0; i < a->count; i++) Channel.Send(ch, payload, a->size);
+    Channel.Close(ch);
+    free(payload);
+    return NULL;
+}
+
+static bool read_full(int fd, void* buf, size_t len) {
+    size_t got = 0;
+    while (got < len) {
+        ssize_t n = read(fd, (char*)buf + got, len - got);
+        if (n <= 0) return false;
+        got += n;
+    }
+    return true;
+}
+
+// The pattern applications use today on top of Socket.Receive
+static long receive_naive(int fd, long count, uint64_t* checksum) {
+    long msgs = 0;
+    for (long i = 0; i < count; i++) {
+        uint32_t len;
+        if (!read_full(fd, &len, sizeof(len))) break;
+        len = ntohl(len);
+        uint8_t* msg = malloc(len);
+        if (!read_full(fd, msg, len)) { free(msg); break; }
+        *checksum += msg[len - 1];
+        free(msg);
+        msgs++;
+    }
+    return msgs;
+}
+
+static long receive_channel(int fd, long count, uint64_t* checksum) {
+    EasyChannel* ch = Channel.Open(fd, FRAME_LENGTH_PREFIX, 0, 0);
+    EasyMessage_t msg;
+    long msgs = 0;
+    while (msgs < count && Channel.Read(ch, &msg) == 1) {
+        *checksum += msg.data[msg.len - 1];
+        msgs++;
+    }
+    Channel.Close(ch);
+    return msgs;
+}
+
+static void run(FILE* out, const char* label, int server_fd, long count, uint32_t size,
+                long (*receive)(int, long, uint64_t*)) {
+    SenderArgs args = { Socket.Connect("127.0.0.1", PORT), count, size };
+    int fd = Socket.Accept(server_fd);
+    if (args.fd < 0 || fd < 0) return;
+
+    pthread_t tid;
+    pthread_create(&tid, NULL, sender, &args);
+
+    uint64_t checksum = 0;
+    long sys0 = read_syscalls();
+    double t0 = now_s();
+    long msgs = receive(fd, count, &checksum);
+    double elapsed = now_s() - t0;
+    long sys1 = read_syscalls();
+
+    pthread_join(tid, NULL);
+    close(args.fd);
+    close(fd);
+
+    fprintf(out, "%-8s %9ld msgs  %11.0f msg/s  %8.1f MB/s  %6.3f read()/msg\n",
+            label, msgs, msgs / elapsed, msgs * (double)size / elapsed / 1e6,
+            (sys0 < 0 || msgs == 0) ? 0.0 : (double)(sys1 - sys0 - 1) / msgs);
+}
+
+int main(int argc, char** argv) {
+    long count = (argc > 1) ? atol(argv[1]) : 1000000;
+    uint32_t size = (argc > 2) ? (uint32_t)atoi(argv[2]) : 100;
+    if (size == 0) size = 1;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    int server_fd = Socket.StartServer(PORT);
+    if (server_fd < 0) return 1;
+
+    fprintf(out, "%ld messages of %u bytes\n", count, size);
+    run(out, "naive", server_fd, count, size, receive_naive);
+    run(out, "channel", server_fd, count, size, receive_channel);
+
+    close(server_fd);
+    fclose(out);
+    return 0;
+}
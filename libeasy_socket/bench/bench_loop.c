@@ -0,0 +1,169 @@
+/*
+ * Loopback benchmark: blocking Socket.Accept loop vs. EventLoop.
+ *
+ * Every client thread runs short request/response transactions
+ * (connect, send 64 bytes, read the echo, close). One extra client is
+ * "slow": it waits between connect and send, which is what stalls a
+ * one-connection-at-a-time server.
+ *
+ * Usage: ./bench/bench_loop [clients] [transactions_per_client]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT_BLOCKING 19001
+#define PORT_LOOP     19002
+#define MSG_LEN       64
+#define SLOW_DELAY_US 2000
+
+typedef struct {
+    int port;
+    int count;
+    bool slow;
+    double* latencies_us;
+} ClientArgs;
+
+static volatile bool stop_servers = false;
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// --- Servers ---
+
+static void* blocking_server(void* arg) {
+    int server_fd = *(int*)arg;
+    char buf[MSG_LEN];
+
+    while (!stop_servers) {
+        int fd = Socket.Accept(server_fd);
+        if (fd < 0) continue;
+        int got = 0;
+        while (got < MSG_LEN) {
+            int n = Socket.Receive(fd, buf + got, MSG_LEN - got);
+            if (n <= 0) break;
+            got += n;
+        }
+        if (got == MSG_LEN) send(fd, buf, MSG_LEN, MSG_NOSIGNAL);
+        close(fd);
+    }
+    return NULL;
+}
+
+static void echo_read(EasyLoop* loop, int fd, const char* data, int len, void* user) {
+    (void)user;
+    EventLoop.Send(loop, fd, data, len);
+}
+
+static const EasyLoopCallbacks_t echo_cb = { .on_read = echo_read };
+
+static void* loop_server(void* arg) {
+    EasyLoop* loop = arg;
+    while (!stop_servers) EventLoop.Poll(loop, 50);
+    return NULL;
+}
+
+// --- Clients ---
+
+static void* client(void* arg) {
+    ClientArgs* a = arg;
+    char msg[MSG_LEN], reply[MSG_LEN];
+    memset(msg, 'x', sizeof(msg));
+
+    for (int i = 0; i < a->count; i++) {
+        double t0 = now_us();
+        int fd = Socket.Connect("127.0.0.1", a->port);
+        if (fd < 0) { a->latencies_us[i] = -1; continue; }
+
+        if (a->slow) usleep(SLOW_DELAY_US);
+        send(fd, msg, MSG_LEN, MSG_NOSIGNAL);
+
+        int got = 0;
+        while (got < MSG_LEN) {
+            ssize_t n = recv(fd, reply + got, MSG_LEN - got, 0);
+            if (n <= 0) break;
+            got += n;
+        }
+        close(fd);
+        a->latencies_us[i] = now_us() - t0;
+    }
+    return NULL;
+}
+
+static void run_clients(FILE* out, const char* label, int port, int clients, int per_client) {
+    pthread_t threads[clients + 1];
+    ClientArgs args[clients + 1];
+    double* lat = calloc((size_t)clients * per_client, sizeof(double));
+    double* slow_lat = calloc(per_client, sizeof(double));
+
+    double t0 = now_us();
+    for (int i = 0; i <= clients; i++) {
+        bool slow = (i == clients);
+        args[i] = (ClientArgs){ port, per_client, slow,
+                                slow ? slow_lat : lat + (size_t)i * per_client };
+        pthread_create(&threads[i], NULL, client, &args[i]);
+    }
+    for (int i = 0; i < clients; i++) pthread_join(threads[i], NULL);
+    double elapsed = now_us() - t0;
+    pthread_join(threads[clients], NULL);
+
+    int total = clients * per_client, ok = 0;
+    for (int i = 0; i < total; i++) if (lat[i] >= 0) lat[ok++] = lat[i];
+    qsort(lat, ok, sizeof(double), cmp_double);
+
+    fprintf(out, "%-10s %8d conns  %10.0f conn/s  p50 %8.1f us  p99 %8.1f us\n",
+            label, ok, ok / (elapsed / 1e6),
+            ok ? lat[ok / 2] : 0.0, ok ? lat[(int)(ok * 0.99)] : 0.0);
+
+    free(lat);
+    free(slow_lat);
+}
+
+int main(int argc, char** argv) {
+    int clients = (argc > 1) ? atoi(argv[1]) : 8;
+    int per_client = (argc > 2) ? atoi(argv[2]) : 500;
+
+    // The library logs every accept/close; keep the report readable
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    fprintf(out, "%d fast clients + 1 slow client (%d us stall), %d transactions each\n",
+            clients, SLOW_DELAY_US, per_client);
+
+    // 1. Blocking Accept loop
+    int server_fd = Socket.StartServer(PORT_BLOCKING);
+    if (server_fd < 0) return 1;
+    pthread_t srv;
+    pthread_create(&srv, NULL, blocking_server, &server_fd);
+    run_clients(out, "blocking", PORT_BLOCKING, clients, per_client);
+    stop_servers = true;
+    shutdown(server_fd, SHUT_RDWR); // Kick the server out of accept()
+    pthread_join(srv, NULL);
+    close(server_fd);
+
+    // 2. Event loop
+    stop_servers = false;
+    EasyLoop* loop = EventLoop.Create(0);
+    if (!loop || EventLoop.Listen(loop, PORT_LOOP, 0, &echo_cb, NULL) < 0) return 1;
+    pthread_create(&srv, NULL, loop_server, loop);
+    run_clients(out, "epoll", PORT_LOOP, clients, per_client);
+    stop_servers = true;
+    pthread_join(srv, NULL);
+    EventLoop.Destroy(loop);
+
+    fclose(out);
+    return 0;
+}
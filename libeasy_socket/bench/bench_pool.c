@@ -0,0 +1,137 @@
+/*
+ * Loopback benchmark: request/response with a fresh connection per
+ * transaction (Socket.Connect + close) vs. checkout from a Pool.
+ *
+ * An EventLoop echo server answers 64-byte requests; client threads run
+ * one request per transaction. Reported: transactions/sec, mean latency
+ * and the pool counters.
+ *
+ * Usage: ./bench/bench_pool [threads] [seconds]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT    19009
+#define MSG_LEN 64
+
+typedef struct {
+    EasyPool* pool;     // NULL = connect per transaction
+    double seconds;
+    long ops;
+} ClientArgs;
+
+static volatile bool stop_server = false;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void echo_read(EasyLoop* loop, int fd, const char* data, int len, void* user) {
+    (void)user;
+    EventLoop.Send(loop, fd, data, len);
+}
+
+static const EasyLoopCallbacks_t echo_cb = { .on_read = echo_read };
+
+static void* server(void* arg) {
+    EasyLoop* loop = arg;
+    while (!stop_server) EventLoop.Poll(loop, 50);
+    return NULL;
+}
+
+static bool transact(int fd, char* msg) {
+    if (send(fd, msg, MSG_LEN, MSG_NOSIGNAL) != MSG_LEN) return false;
+    int got = 0;
+    while (got < MSG_LEN) {
+        ssize_t n = recv(fd, msg + got, MSG_LEN - got, 0);
+        if (n <= 0) return false;
+        got += n;
+    }
+    return true;
+}
+
+static void* client(void* arg) {
+    ClientArgs* a = arg;
+    char msg[MSG_LEN];
+    memset(msg, 'x', sizeof(msg));
+
+    double end = now_s() + a->seconds;
+    while (now_s() < end) {
+        if (a->pool) {
+            int fd = Pool.Get(a->pool, "127.0.0.1", PORT);
+            if (fd < 0) continue;
+            bool ok = transact(fd, msg);
+            Pool.Put(a->pool, fd, ok);
+            if (ok) a->ops++;
+        } else {
+            int fd = Socket.Connect("127.0.0.1", PORT);
+            if (fd < 0) continue;
+            if (transact(fd, msg)) a->ops++;
+            close(fd);
+        }
+    }
+    return NULL;
+}
+
+static void run(FILE* out, const char* label, EasyPool* pool, int threads, double seconds) {
+    pthread_t tid[threads];
+    ClientArgs args[threads];
+
+    for (int i = 0; i < threads; i++) {
+        args[i] = (ClientArgs){ pool, seconds, 0 };
+        pthread_create(&tid[i], NULL, client, &args[i]);
+    }
+    long total = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tid[i], NULL);
+        total += args[i].ops;
+    }
+
+    fprintf(out, "%-8s %10.0f txn/s   %8.2f us/txn per thread\n",
+            label, total / seconds, total ? seconds * threads * 1e6 / total : 0.0);
+    if (pool) {
+        EasyPoolStats_t st;
+        Pool.Stats(pool, &st);
+        fprintf(out, "         reused %lu  connected %lu  discarded %lu  failed %lu\n",
+                (unsigned long)st.reused, (unsigned long)st.connected,
+                (unsigned long)st.discarded, (unsigned long)st.failed);
+    }
+    fflush(out);
+}
+
+int main(int argc, char** argv) {
+    int threads = (argc > 1) ? atoi(argv[1]) : 4;
+    double seconds = (argc > 2) ? atof(argv[2]) : 2.0;
+    if (threads < 1) threads = 4;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+    fprintf(out, "%d client threads, %.1fs per mode\n", threads, seconds);
+
+    EasyLoop* loop = EventLoop.Create(0);
+    if (!loop || EventLoop.Listen(loop, PORT, 0, &echo_cb, NULL) < 0) return 1;
+    pthread_t srv;
+    pthread_create(&srv, NULL, server, loop);
+
+    run(out, "connect", NULL, threads, seconds);
+    usleep(200000); // Let the server reap the closed connections
+
+    EasyPool* pool = Pool.Create(threads, 1000, 0);
+    run(out, "pool", pool, threads, seconds);
+    Pool.Destroy(pool);
+
+    stop_server = true;
+    pthread_join(srv, NULL);
+    EventLoop.Destroy(loop);
+
+    fclose(out);
+    return 0;
+}
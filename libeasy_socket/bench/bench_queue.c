@@ -0,0 +1,127 @@
+/*
+ * Loopback benchmark: one Socket.Send per message vs. SendQueue batching.
+ *
+ *   send   - Socket.Send for every message (one send() each)
+ *   queue  - SendQueue.Push, automatic batch flushes, Flush at the end
+ *   cork   - SendQueue corked around bursts of 32 messages
+ *
+ * Finally a non-blocking queue pushes at a peer that never reads, to show
+ * the high watermark capping queued memory.
+ *
+ * Usage: ./bench/bench_queue [messages] [message_bytes]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT  19005
+#define BURST 32
+
+typedef struct {
+    int fd;
+    long bytes;
+} DrainArgs;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* drain(void* arg) {
+    DrainArgs* a = arg;
+    char buf[65536];
+    ssize_t n;
+    while ((n = read(a->fd, buf, sizeof(buf))) > 0) a->bytes += n;
+    return NULL;
+}
+
+static void run(FILE* out, const char* label, int server_fd, long count, const char* msg, int mode) {
+    int fd = Socket.Connect("127.0.0.1", PORT);
+    DrainArgs drain_args = { Socket.Accept(server_fd), 0 };
+    pthread_t tid;
+    pthread_create(&tid, NULL, drain, &drain_args);
+
+    size_t len = strlen(msg);
+    EasySendQueue* q = SendQueue.Create(fd, 0, 0);
+    EasySendStats_t st = {0};
+
+    double t0 = now_s();
+    if (mode == 0) {
+        for (long i = 0; i < count; i++) Socket.Send(fd, msg);
+        st.syscalls = count;
+        st.bytes = count * len;
+    } else {
+        for (long i = 0; i < count; i++) {
+            if (mode == 2 && i % BURST == 0) SendQueue.Cork(q, true);
+            SendQueue.Push(q, msg, len);
+            if (mode == 2 && i % BURST == BURST - 1) SendQueue.Cork(q, false);
+        }
+        SendQueue.Cork(q, false);
+        SendQueue.Flush(q);
+        SendQueue.Stats(q, &st);
+    }
+    double elapsed = now_s() - t0;
+
+    shutdown(fd, SHUT_WR);
+    pthread_join(tid, NULL);
+    close(drain_args.fd);
+    close(fd);
+    SendQueue.Destroy(q);
+
+    fprintf(out, "%-6s %9ld msgs  %7.4f syscalls/msg  %11.0f msg/s  %8.1f MB/s  (peer got %ld B)\n",
+            label, count, (double)st.syscalls / count, count / elapsed,
+            st.bytes / elapsed / 1e6, drain_args.bytes);
+}
+
+static void backpressure(FILE* out, int server_fd, const char* msg) {
+    int fd = Socket.Connect("127.0.0.1", PORT);
+    int peer = Socket.Accept(server_fd); // Never read from
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    EasySendQueue* q = SendQueue.Create(fd, 64 * 1024, 256 * 1024);
+    long accepted = 0;
+    while (accepted < 10000000 && SendQueue.Push(q, msg, strlen(msg))) accepted++;
+
+    EasySendStats_t st;
+    SendQueue.Stats(q, &st);
+    fprintf(out, "backpressure: refused after %ld msgs, %llu B in kernel, %llu B queued (high=256 KiB)\n",
+            accepted, (unsigned long long)st.bytes, (unsigned long long)st.pending);
+
+    SendQueue.Destroy(q);
+    close(peer);
+    close(fd);
+}
+
+int main(int argc, char** argv) {
+    long count = (argc > 1) ? atol(argv[1]) : 1000000;
+    int size = (argc > 2) ? atoi(argv[2]) : 40;
+    if (size < 1) size = 1;
+
+    char* msg = malloc(size + 1);
+    memset(msg, 't', size);
+    msg[size] = '\0';
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    int server_fd = Socket.StartServer(PORT);
+    if (server_fd < 0) return 1;
+
+    fprintf(out, "%ld messages of %d bytes\n", count, size);
+    run(out, "send", server_fd, count, msg, 0);
+    run(out, "queue", server_fd, count, msg, 1);
+    run(out, "cork", server_fd, count, msg, 2);
+    backpressure(out, server_fd, msg);
+
+    close(server_fd);
+    free(msg);
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Loopback benchmark: Shards accept and echo throughput vs. worker count.
+ *
+ * For 1, 2, 4 ... max_workers workers:
+ *   accept - client threads open, ping and close connections back to back
+ *   echo   - client threads ping-pong 64-byte messages on persistent connections
+ *
+ * Usage: ./bench/bench_shard [max_workers] [client_threads] [seconds]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT    19003
+#define MSG_LEN 64
+
+typedef struct {
+    bool persistent;
+    double seconds;
+    long ops;
+} ClientArgs;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void echo_read(EasyLoop* loop, int fd, const char* data, int len, void* user) {
+    (void)user;
+    EventLoop.Send(loop, fd, data, len);
+}
+
+static const EasyLoopCallbacks_t echo_cb = { .on_read = echo_read };
+
+static bool ping(int fd) {
+    char msg[MSG_LEN];
+    memset(msg, 'x', sizeof(msg));
+    if (send(fd, msg, MSG_LEN, MSG_NOSIGNAL) != MSG_LEN) return false;
+
+    int got = 0;
+    while (got < MSG_LEN) {
+        ssize_t n = recv(fd, msg + got, MSG_LEN - got, 0);
+        if (n <= 0) return false;
+        got += n;
+    }
+    return true;
+}
+
+static void* client(void* arg) {
+    ClientArgs* a = arg;
+    double end = now_s() + a->seconds;
+    int fd = -1;
+
+    while (now_s() < end) {
+        if (fd < 0) fd = Socket.Connect("127.0.0.1", PORT);
+        if (fd < 0) continue;
+        if (ping(fd)) a->ops++;
+        if (!a->persistent) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd >= 0) close(fd);
+    return NULL;
+}
+
+static double run(int threads, bool persistent, double seconds) {
+    pthread_t tid[threads];
+    ClientArgs args[threads];
+
+    for (int i = 0; i < threads; i++) {
+        args[i] = (ClientArgs){ persistent, seconds, 0 };
+        pthread_create(&tid[i], NULL, client, &args[i]);
+    }
+    long total = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tid[i], NULL);
+        total += args[i].ops;
+    }
+    return total / seconds;
+}
+
+int main(int argc, char** argv) {
+    int cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int max_workers = (argc > 1) ? atoi(argv[1]) : (cpus > 1 ? cpus : 2);
+    int threads = (argc > 2) ? atoi(argv[2]) : 8;
+    double seconds = (argc > 3) ? atof(argv[3]) : 2.0;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    fprintf(out, "%d online CPUs, %d client threads, %.1fs per run\n", cpus, threads, seconds);
+    fprintf(out, "%-8s %14s %14s\n", "workers", "accept conn/s", "echo msg/s");
+
+    for (int workers = 1; workers <= max_workers; workers *= 2) {
+        EasyShards* shards = Shards.Start(PORT, workers, 0, &echo_cb, NULL);
+        if (!shards) return 1;
+
+        double accepts = run(threads, false, seconds);
+        double echoes = run(threads, true, seconds);
+        fprintf(out, "%-8d %14.0f %14.0f\n", workers, accepts, echoes);
+        fflush(out);
+
+        Shards.Stop(shards);
+    }
+
+    fclose(out);
+    return 0;
+}
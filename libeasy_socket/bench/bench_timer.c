@@ -0,0 +1,204 @@
+/*
+ * Benchmark: per-connection deadlines on a hierarchical timer wheel vs. a
+ * binary min-heap (the usual alternative).
+ *
+ *   arm     - one idle timer per connection
+ *   re-arm  - push a random connection's deadline back (what every read does)
+ *   cancel  - disarm every timer (connections closing)
+ *   fire    - Timers.Poll on an EventLoop until every short timer has run;
+ *             reports how late callbacks ran
+ *   periodic - callbacks that re-arm themselves (1 ms and 0 ms); every
+ *             period must come back on time, not a wheel rotation late
+ *
+ * Usage: ./bench/bench_timer [connections] [rearms]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    EasyTimer idle;
+    int heap_pos;            // Index in the heap, -1 if not armed
+    uint64_t heap_deadline;
+    double due;              // For the firing test
+} Conn;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t rng = 12345;
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// --- Baseline: indexed binary heap ---
+
+static Conn** heap;
+static int heap_len;
+
+static void heap_swap(int a, int b) {
+    Conn* t = heap[a];
+    heap[a] = heap[b];
+    heap[b] = t;
+    heap[a]->heap_pos = a;
+    heap[b]->heap_pos = b;
+}
+
+static void heap_fix(int i) {
+    while (i > 0 && heap[(i - 1) / 2]->heap_deadline > heap[i]->heap_deadline) {
+        heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < heap_len && heap[l]->heap_deadline < heap[m]->heap_deadline) m = l;
+        if (r < heap_len && heap[r]->heap_deadline < heap[m]->heap_deadline) m = r;
+        if (m == i) break;
+        heap_swap(i, m);
+        i = m;
+    }
+}
+
+static void heap_start(Conn* c, uint64_t deadline) {
+    c->heap_deadline = deadline;
+    if (c->heap_pos < 0) {
+        c->heap_pos = heap_len;
+        heap[heap_len++] = c;
+    }
+    heap_fix(c->heap_pos);
+}
+
+static void heap_cancel(Conn* c) {
+    int i = c->heap_pos;
+    if (i < 0) return;
+    heap_swap(i, --heap_len);
+    c->heap_pos = -1;
+    if (i < heap_len) heap_fix(i);
+}
+
+// --- Firing test ---
+
+static double late_max, late_sum;
+static int late_count;
+
+static void on_expire(EasyTimer* timer, void* user) {
+    (void)timer;
+    Conn* c = user;
+    double late = now_s() - c->due;
+    if (late > late_max) late_max = late;
+    late_sum += late;
+    late_count++;
+}
+
+// --- Periodic test: a timer re-arming itself from its callback ---
+
+typedef struct {
+    EasyTimerWheel* wheel;
+    int period_ms;
+    int runs;
+    double last;
+    double gap_max;
+} Periodic;
+
+static void on_periodic(EasyTimer* timer, void* user) {
+    Periodic* p = user;
+    double now = now_s();
+    if (p->runs > 0 && now - p->last > p->gap_max) p->gap_max = now - p->last;
+    p->last = now;
+    p->runs++;
+    Timers.Start(p->wheel, timer, p->period_ms, on_periodic, p);
+}
+
+int main(int argc, char** argv) {
+    int conns = (argc > 1) ? atoi(argv[1]) : 100000;
+    long rearms = (argc > 2) ? atol(argv[2]) : 5000000;
+    if (conns < 1) conns = 100000;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+    fprintf(out, "%d connections, %ld re-arms\n", conns, rearms);
+
+    Conn* c = calloc(conns, sizeof(Conn));
+    heap = calloc(conns, sizeof(Conn*));
+    uint32_t* pick = malloc(rearms * sizeof(uint32_t));
+    int* delay = malloc(rearms * sizeof(int));
+    for (long i = 0; i < rearms; i++) {
+        pick[i] = next_rand() % conns;
+        delay[i] = 1000 + next_rand() % 59000;   // 1-60 s idle timeouts
+    }
+
+    // Wheel
+    EasyTimerWheel* wheel = Timers.Create(1);
+    double t0 = now_s();
+    for (int i = 0; i < conns; i++) Timers.Start(wheel, &c[i].idle, delay[i % rearms], NULL, &c[i]);
+    double t1 = now_s();
+    for (long i = 0; i < rearms; i++) Timers.Start(wheel, &c[pick[i]].idle, delay[i], NULL, &c[pick[i]]);
+    double t2 = now_s();
+    for (int i = 0; i < conns; i++) Timers.Cancel(wheel, &c[i].idle);
+    double t3 = now_s();
+    fprintf(out, "wheel   arm %6.1f ns   re-arm %6.1f ns   cancel %6.1f ns\n",
+            (t1 - t0) * 1e9 / conns, (t2 - t1) * 1e9 / rearms, (t3 - t2) * 1e9 / conns);
+
+    // Heap
+    uint64_t base = 0;
+    for (int i = 0; i < conns; i++) c[i].heap_pos = -1;
+    t0 = now_s();
+    for (int i = 0; i < conns; i++) heap_start(&c[i], base + delay[i % rearms]);
+    t1 = now_s();
+    for (long i = 0; i < rearms; i++) heap_start(&c[pick[i]], base + (uint64_t)i / 1000 + delay[i]);
+    t2 = now_s();
+    for (int i = 0; i < conns; i++) heap_cancel(&c[i]);
+    t3 = now_s();
+    fprintf(out, "heap    arm %6.1f ns   re-arm %6.1f ns   cancel %6.1f ns\n",
+            (t1 - t0) * 1e9 / conns, (t2 - t1) * 1e9 / rearms, (t3 - t2) * 1e9 / conns);
+    fflush(out);
+
+    // Expiry through an event loop: every connection times out within 1 s
+    EasyLoop* loop = EventLoop.Create(0);
+    double start = now_s();
+    for (int i = 0; i < conns; i++) {
+        int ms = next_rand() % 1000;
+        c[i].due = start + ms / 1e3;
+        Timers.Start(wheel, &c[i].idle, ms, on_expire, &c[i]);
+    }
+    int wakeups = 0;
+    while (late_count < conns && now_s() - start < 5.0) {
+        if (Timers.Poll(wheel, &EventLoop, loop, 1000) < 0) break;
+        wakeups++;
+    }
+    fprintf(out, "fired %d/%d in %d wakeups   late avg %.2f ms  max %.2f ms\n",
+            late_count, conns, wakeups,
+            late_count ? late_sum * 1e3 / late_count : 0.0, late_max * 1e3);
+
+    // Re-arming from the callback: 1 ms and 0 ms periods for 300 ms each
+    for (int period = 1; period >= 0; period--) {
+        Periodic p = { wheel, period, 0, 0, 0 };
+        EasyTimer timer = {0};
+        Timers.Start(wheel, &timer, period, on_periodic, &p);
+        start = now_s();
+        while (now_s() - start < 0.3) {
+            if (Timers.Poll(wheel, &EventLoop, loop, 1000) < 0) break;
+        }
+        Timers.Cancel(wheel, &timer);
+        fprintf(out, "periodic %d ms   %d runs in 300 ms   longest gap %.2f ms\n",
+                period, p.runs, p.gap_max * 1e3);
+    }
+
+    EventLoop.Destroy(loop);
+    Timers.Destroy(wheel);
+    free(c);
+    free(heap);
+    free(pick);
+    free(delay);
+    fclose(out);
+    return 0;
+}
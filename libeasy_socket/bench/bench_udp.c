@@ -0,0 +1,115 @@
+/*
+ * Loopback benchmark: UDP packets/sec, single vs. batched calls.
+ *
+ *   single - UDP.Send / UDP.Receive, one syscall per packet
+ *   batch  - UDP.SendBatch / UDP.ReceiveBatch (sendmmsg / recvmmsg, 64 slots)
+ *   gso    - UDP.SendSegmented (UDP_SEGMENT) into ReceiveBatch with UDP_GRO
+ *
+ * Usage: ./bench/bench_udp [payload_bytes] [seconds]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT  19008
+#define BATCH 64
+
+typedef struct {
+    int fd;
+    int mode;
+    volatile bool stop;
+    long packets;
+} RecvArgs;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* receiver(void* arg) {
+    RecvArgs* a = arg;
+    static uint8_t pool[BATCH][65536];
+    EasyDatagram_t slots[BATCH];
+    for (int i = 0; i < BATCH; i++) slots[i] = (EasyDatagram_t){ .data = pool[i], .cap = sizeof(pool[i]) };
+
+    while (!a->stop) {
+        if (a->mode == 0) {
+            if (UDP.Receive(a->fd, pool[0], sizeof(pool[0]), NULL) > 0) a->packets++;
+            continue;
+        }
+        int n = UDP.ReceiveBatch(a->fd, slots, BATCH, 100);
+        for (int i = 0; i < n; i++) {
+            // A GRO slot carries several original datagrams
+            a->packets += slots[i].segment_size ? (slots[i].len + slots[i].segment_size - 1) / slots[i].segment_size : 1;
+        }
+    }
+    return NULL;
+}
+
+static void run(FILE* out, const char* label, int mode, int payload, double seconds) {
+    int rx = UDP.Bind(PORT, 8 * 1024 * 1024);
+    if (rx < 0) return;
+    struct timeval tv = { 0, 100000 }; // Lets the single-packet receiver notice 'stop'
+    setsockopt(rx, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (mode == 2) UDP.EnableGro(rx);
+
+    int tx = UDP.Connect("127.0.0.1", PORT);
+    RecvArgs args = { rx, mode, false, 0 };
+    pthread_t tid;
+    pthread_create(&tid, NULL, receiver, &args);
+
+    uint8_t* data = calloc(BATCH, payload);
+    EasyDatagram_t slots[BATCH];
+    for (int i = 0; i < BATCH; i++) slots[i] = (EasyDatagram_t){ .data = data + i * payload, .len = payload };
+
+    long sent = 0;
+    double t0 = now_s(), end = t0 + seconds;
+    while (now_s() < end) {
+        for (int k = 0; k < 16; k++) {
+            if (mode == 0) {
+                for (int i = 0; i < BATCH; i++) sent += UDP.Send(tx, data, payload);
+            } else if (mode == 1) {
+                int n = UDP.SendBatch(tx, slots, BATCH);
+                if (n > 0) sent += n;
+            } else {
+                if (UDP.SendSegmented(tx, data, payload * BATCH, payload)) sent += BATCH;
+            }
+        }
+    }
+    double elapsed = now_s() - t0;
+
+    usleep(200000);
+    args.stop = true;
+    pthread_join(tid, NULL);
+
+    fprintf(out, "%-7s sent %10.0f pkt/s   received %10.0f pkt/s\n",
+            label, sent / elapsed, args.packets / elapsed);
+    fflush(out);
+
+    free(data);
+    UDP.Close(tx);
+    UDP.Close(rx);
+}
+
+int main(int argc, char** argv) {
+    int payload = (argc > 1) ? atoi(argv[1]) : 64;
+    double seconds = (argc > 2) ? atof(argv[2]) : 2.0;
+    if (payload < 1 || payload > 1400) payload = 64;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+    fprintf(out, "%d-byte datagrams, %.1fs per mode\n", payload, seconds);
+
+    run(out, "single", 0, payload, seconds);
+    run(out, "batch", 1, payload, seconds);
+    run(out, "gso", 2, payload, seconds);
+
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Same-host IPC benchmark: loopback TCP vs. AF_UNIX stream vs. seqpacket.
+ *
+ *   latency    - 64-byte ping-pong round trips
+ *   throughput - 64 KiB writes into a receiver that discards them
+ *   fd passing - UnixSocket.SendFd / ReceiveFd round trips (unix only)
+ *
+ * Usage: ./bench/bench_unix [round_trips] [seconds]
+ */
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#define PORT      19010
+#define PATH      "/tmp/easy_bench_unix.sock"
+#define PING_LEN  64
+#define BLOCK_LEN 65536
+
+enum { MODE_TCP, MODE_STREAM, MODE_SEQPACKET };
+enum { TEST_ECHO, TEST_SINK, TEST_FD };
+
+typedef struct {
+    int server_fd;
+    int mode;
+    int test;
+} ServerArgs;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int recv_full(int fd, char* buf, int len) {
+    int got = 0;
+    while (got < len) {
+        ssize_t n = recv(fd, buf + got, len - got, 0);
+        if (n <= 0) return -1;
+        got += n;
+    }
+    return got;
+}
+
+static void* server(void* arg) {
+    ServerArgs* a = arg;
+    static char buf[BLOCK_LEN];
+    int fd = (a->mode == MODE_TCP) ? Socket.Accept(a->server_fd) : UnixSocket.Accept(a->server_fd);
+    if (fd < 0) return NULL;
+
+    for (;;) {
+        if (a->test == TEST_ECHO) {
+            if (recv_full(fd, buf, PING_LEN) < 0 || send(fd, buf, PING_LEN, MSG_NOSIGNAL) != PING_LEN) break;
+        } else if (a->test == TEST_SINK) {
+            if (recv(fd, buf, sizeof(buf), 0) <= 0) break;
+        } else {
+            int passed;
+            if (UnixSocket.ReceiveFd(fd, buf, PING_LEN, &passed) <= 0) break;
+            if (passed >= 0) close(passed);
+            if (send(fd, buf, 1, MSG_NOSIGNAL) != 1) break;
+        }
+    }
+    close(fd);
+    return NULL;
+}
+
+static int open_pair(int mode, int test, pthread_t* tid, ServerArgs* args) {
+    int server_fd = (mode == MODE_TCP) ? Socket.StartServer(PORT)
+                  : UnixSocket.StartServer(PATH, mode == MODE_SEQPACKET ? UNIX_SEQPACKET : UNIX_STREAM);
+    if (server_fd < 0) return -1;
+
+    *args = (ServerArgs){ server_fd, mode, test };
+    pthread_create(tid, NULL, server, args);
+
+    int fd = (mode == MODE_TCP) ? Socket.Connect("127.0.0.1", PORT)
+           : UnixSocket.Connect(PATH, mode == MODE_SEQPACKET ? UNIX_SEQPACKET : UNIX_STREAM);
+    if (fd < 0) {
+        pthread_cancel(*tid);
+        return -1;
+    }
+    return fd;
+}
+
+static void close_pair(int fd, pthread_t tid, ServerArgs* args) {
+    close(fd);
+    pthread_join(tid, NULL);
+    if (args->mode == MODE_TCP) Socket.Close(args->server_fd);
+    else UnixSocket.Close(args->server_fd);
+}
+
+static void run(FILE* out, const char* label, int mode, int round_trips, double seconds) {
+    pthread_t tid;
+    ServerArgs args;
+    char ping[PING_LEN];
+    memset(ping, 'p', sizeof(ping));
+
+    // Latency
+    int fd = open_pair(mode, TEST_ECHO, &tid, &args);
+    if (fd < 0) return;
+    double t0 = now_s();
+    for (int i = 0; i < round_trips; i++) {
+        if (send(fd, ping, PING_LEN, MSG_NOSIGNAL) != PING_LEN || recv_full(fd, ping, PING_LEN) < 0) break;
+    }
+    double rtt = (now_s() - t0) * 1e6 / round_trips;
+    close_pair(fd, tid, &args);
+
+    // Throughput
+    static char block[BLOCK_LEN];
+    fd = open_pair(mode, TEST_SINK, &tid, &args);
+    if (fd < 0) return;
+    long bytes = 0;
+    t0 = now_s();
+    double end = t0 + seconds;
+    while (now_s() < end) {
+        for (int k = 0; k < 16; k++) {
+            ssize_t w = send(fd, block, BLOCK_LEN, MSG_NOSIGNAL);
+            if (w <= 0) break;
+            bytes += w;
+        }
+    }
+    double mbps = bytes / (now_s() - t0) / 1e6;
+    close_pair(fd, tid, &args);
+
+    fprintf(out, "%-10s  rtt %6.2f us   throughput %8.0f MB/s", label, rtt, mbps);
+
+    // Descriptor passing
+    if (mode != MODE_TCP) {
+        int null_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        fd = open_pair(mode, TEST_FD, &tid, &args);
+        if (fd < 0) return;
+        t0 = now_s();
+        for (int i = 0; i < round_trips; i++) {
+            if (!UnixSocket.SendFd(fd, null_fd, "f", 1) || recv_full(fd, ping, 1) < 0) break;
+        }
+        fprintf(out, "   fd pass %6.2f us", (now_s() - t0) * 1e6 / round_trips);
+        close_pair(fd, tid, &args);
+        close(null_fd);
+    }
+    fprintf(out, "\n");
+    fflush(out);
+}
+
+int main(int argc, char** argv) {
+    int round_trips = (argc > 1) ? atoi(argv[1]) : 100000;
+    double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+    if (round_trips < 1) round_trips = 100000;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+    fprintf(out, "%d round trips, %.1fs throughput per transport\n", round_trips, seconds);
+
+    run(out, "tcp", MODE_TCP, round_trips, seconds);
+    run(out, "unix", MODE_STREAM, round_trips, seconds);
+    run(out, "seqpacket", MODE_SEQPACKET, round_trips, seconds);
+
+    fclose(out);
+    return 0;
+}
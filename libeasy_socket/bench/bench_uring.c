@@ -0,0 +1,203 @@
+/*
+ * Loopback benchmark: blocking vs. EventLoop (epoll) vs. UringLoop (io_uring).
+ *
+ * Client threads ping-pong 64-byte messages on persistent connections.
+ *   blocking - Socket.Accept, then one thread per connection doing
+ *              Socket.Receive / send (the only way the blocking API scales)
+ *   epoll    - EventLoop echo server on one thread
+ *   uring    - UringLoop echo server on one thread
+ * Reported: messages/sec and server CPU time per message.
+ *
+ * Usage: ./bench/bench_uring [connections] [seconds]
+ */
+#define _GNU_SOURCE // RUSAGE_THREAD
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#define PORT    19007
+#define MSG_LEN 64
+
+typedef struct {
+    double seconds;
+    long ops;
+} ClientArgs;
+
+static volatile bool stop_server = false;
+static double server_cpu = 0;
+static pthread_mutex_t cpu_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double thread_cpu_s(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+static void add_server_cpu(double cpu) {
+    pthread_mutex_lock(&cpu_lock);
+    server_cpu += cpu;
+    pthread_mutex_unlock(&cpu_lock);
+}
+
+// --- Blocking server: thread per connection ---
+
+static void* blocking_conn(void* arg) {
+    int fd = (int)(intptr_t)arg;
+    char buf[4096];
+    double cpu0 = thread_cpu_s();
+    int n;
+    while ((n = Socket.Receive(fd, buf, sizeof(buf))) > 0) {
+        if (send(fd, buf, n, MSG_NOSIGNAL) != n) break;
+    }
+    close(fd);
+    add_server_cpu(thread_cpu_s() - cpu0);
+    return NULL;
+}
+
+static void* blocking_server(void* arg) {
+    int server_fd = *(int*)arg;
+    while (!stop_server) {
+        int fd = Socket.Accept(server_fd);
+        if (fd < 0) continue;
+        pthread_t tid;
+        pthread_create(&tid, NULL, blocking_conn, (void*)(intptr_t)fd);
+        pthread_detach(tid);
+    }
+    return NULL;
+}
+
+// --- Loop servers ---
+
+typedef struct {
+    const EasyEventLoop_t* engine;
+    EasyLoop* loop;
+} LoopArgs;
+
+static const EasyEventLoop_t* current_engine;
+
+static void echo_read(EasyLoop* loop, int fd, const char* data, int len, void* user) {
+    (void)user;
+    current_engine->Send(loop, fd, data, len);
+}
+
+static const EasyLoopCallbacks_t echo_cb = { .on_read = echo_read };
+
+static void* loop_server(void* arg) {
+    LoopArgs* a = arg;
+    double cpu0 = thread_cpu_s();
+    while (!stop_server) a->engine->Poll(a->loop, 50);
+    add_server_cpu(thread_cpu_s() - cpu0);
+    return NULL;
+}
+
+// --- Clients ---
+
+static void* client(void* arg) {
+    ClientArgs* a = arg;
+    char msg[MSG_LEN];
+    memset(msg, 'x', sizeof(msg));
+
+    int fd = Socket.Connect("127.0.0.1", PORT);
+    if (fd < 0) return NULL;
+
+    double end = now_s() + a->seconds;
+    while (now_s() < end) {
+        if (send(fd, msg, MSG_LEN, MSG_NOSIGNAL) != MSG_LEN) break;
+        int got = 0;
+        while (got < MSG_LEN) {
+            ssize_t n = recv(fd, msg + got, MSG_LEN - got, 0);
+            if (n <= 0) goto out;
+            got += n;
+        }
+        a->ops++;
+    }
+out:
+    close(fd);
+    return NULL;
+}
+
+static long run_clients(int conns, double seconds) {
+    pthread_t tid[conns];
+    ClientArgs args[conns];
+
+    for (int i = 0; i < conns; i++) {
+        args[i] = (ClientArgs){ seconds, 0 };
+        pthread_create(&tid[i], NULL, client, &args[i]);
+    }
+    long total = 0;
+    for (int i = 0; i < conns; i++) {
+        pthread_join(tid[i], NULL);
+        total += args[i].ops;
+    }
+    return total;
+}
+
+static void report(FILE* out, const char* label, long total, double seconds) {
+    pthread_mutex_lock(&cpu_lock);
+    double cpu = server_cpu;
+    server_cpu = 0;
+    pthread_mutex_unlock(&cpu_lock);
+
+    fprintf(out, "%-9s %11.0f msg/s   server CPU %6.2f us/msg\n",
+            label, total / seconds, total ? cpu * 1e6 / total : 0.0);
+    fflush(out);
+}
+
+static void run_loop(FILE* out, const char* label, const EasyEventLoop_t* engine, int conns, double seconds) {
+    LoopArgs args = { engine, engine->Create(0) };
+    if (!args.loop || engine->Listen(args.loop, PORT, 0, &echo_cb, NULL) < 0) return;
+    current_engine = engine;
+
+    stop_server = false;
+    pthread_t srv;
+    pthread_create(&srv, NULL, loop_server, &args);
+    long total = run_clients(conns, seconds);
+    stop_server = true;
+    pthread_join(srv, NULL);
+    report(out, label, total, seconds);
+
+    engine->Destroy(args.loop);
+}
+
+int main(int argc, char** argv) {
+    int conns = (argc > 1) ? atoi(argv[1]) : 32;
+    double seconds = (argc > 2) ? atof(argv[2]) : 2.0;
+
+    FILE* out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+    fprintf(out, "%d connections, %.1fs per engine\n", conns, seconds);
+
+    int server_fd = Socket.StartServer(PORT);
+    if (server_fd < 0) return 1;
+    // StartServer's backlog of 3 drops handshakes when every client connects
+    // at once; raise it so this measures the I/O model, not SYN retries
+    listen(server_fd, SOMAXCONN);
+    pthread_t srv;
+    pthread_create(&srv, NULL, blocking_server, &server_fd);
+    long total = run_clients(conns, seconds);
+    usleep(100000); // Let the per-connection threads exit and add their CPU time
+    report(out, "blocking", total, seconds);
+    stop_server = true;
+    shutdown(server_fd, SHUT_RDWR);
+    pthread_join(srv, NULL);
+    close(server_fd);
+
+    run_loop(out, "epoll", &EventLoop, conns, seconds);
+    run_loop(out, "io_uring", &UringLoop, conns, seconds);
+
+    fclose(out);
+    return 0;
+}
@@ -20,7 +20,9 @@ static int Socket_StartServer(int port) {
     }
 
     // 2. Set Socket Options (Prevents "Address already in use" error on restart)
-    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR | SO_REUSEPORT, &opt, sizeof(opt))) {
+    // (These are option numbers, not flags: each one needs its own call)
+    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) ||
+        setsockopt(server_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt))) {
         perror("EasySocket: setsockopt failed");
         close(server_fd);
         return -1;
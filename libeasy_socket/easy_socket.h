@@ -2,7 +2,9 @@
 #define EASY_SOCKET_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <netinet/in.h>
 
 typedef struct {
     /**
@@ -49,4 +51,669 @@ typedef struct {
 
 extern const EasySocket_t Socket;
 
+/* ------------------------------------------------------------------ */
+/*  Event Loop (Reactor)                                               */
+/* ------------------------------------------------------------------ */
+
+/* Opaque loop handle. One loop is driven by one thread. */
+typedef struct EasyLoop EasyLoop;
+
+/*
+ * Callbacks shared by a listener and every connection it accepts.
+ * Any callback may be NULL. 'user' is the pointer given to Listen/Watch.
+ */
+typedef struct {
+    /** A new client was accepted. Return false to drop it. */
+    bool (*on_accept)(EasyLoop* loop, int fd, void* user);
+
+    /** Data arrived. 'data' is only valid for the duration of the call. */
+    void (*on_read)(EasyLoop* loop, int fd, const char* data, int len, void* user);
+
+    /** The socket became writable and nothing from EventLoop.Send is pending. */
+    void (*on_write)(EasyLoop* loop, int fd, void* user);
+
+    /** The connection is about to be closed (peer hangup, error or CloseConn). */
+    void (*on_close)(EasyLoop* loop, int fd, void* user);
+} EasyLoopCallbacks_t;
+
+typedef struct {
+    /**
+     * @brief Create an edge-triggered epoll loop.
+     * @param max_events Events fetched per wakeup (0 = default of 256).
+     * @return The loop or NULL on failure.
+     */
+    EasyLoop* (*Create)(int max_events);
+
+    /**
+     * @brief Open a non-blocking listener and register it with the loop.
+     * @param port The port to listen on.
+     * @param backlog listen() backlog (0 = SOMAXCONN).
+     * @return The listening fd or -1 on failure.
+     */
+    int (*Listen)(EasyLoop* loop, int port, int backlog,
+                  const EasyLoopCallbacks_t* cb, void* user);
+
+    /**
+     * @brief Register an already connected socket (e.g. from Socket.Connect).
+     * The fd is switched to non-blocking mode.
+     */
+    bool (*Watch)(EasyLoop* loop, int fd, const EasyLoopCallbacks_t* cb, void* user);
+
+    /**
+     * @brief Send bytes on a watched connection without blocking.
+     * Whatever the kernel does not take immediately is buffered and flushed
+     * when the socket becomes writable.
+     * @return false if the connection is unknown or has failed.
+     */
+    bool (*Send)(EasyLoop* loop, int fd, const void* data, int len);
+
+    /**
+     * @brief Wait for events once and dispatch them.
+     * @param timeout_ms -1 blocks, 0 returns immediately.
+     * @return Number of events handled, or -1 on error.
+     */
+    int (*Poll)(EasyLoop* loop, int timeout_ms);
+
+    /**
+     * @brief Dispatch events until Stop is called.
+     */
+    void (*Run)(EasyLoop* loop);
+
+    /**
+     * @brief Make Run return after the current wakeup. Safe from callbacks.
+     */
+    void (*Stop)(EasyLoop* loop);
+
+    /**
+     * @brief Close a connection (or listener) owned by the loop.
+     */
+    void (*CloseConn)(EasyLoop* loop, int fd);
+
+    /**
+     * @brief Close every fd owned by the loop and free it.
+     */
+    void (*Destroy)(EasyLoop* loop);
+
+} EasyEventLoop_t;
+
+extern const EasyEventLoop_t EventLoop;
+
+/*
+ * Same interface, backed by io_uring: one multishot accept per listener,
+ * one multishot recv per connection using a registered buffer ring, and all
+ * work queued during a wakeup submitted with a single io_uring_enter().
+ * Watch only accepts sockets. If io_uring is missing at build time or
+ * refused by the kernel, Create returns an epoll loop and every call is
+ * forwarded to EventLoop.
+ */
+extern const EasyEventLoop_t UringLoop;
+
+/* ------------------------------------------------------------------ */
+/*  Sharded Server (SO_REUSEPORT, one loop per core)                   */
+/* ------------------------------------------------------------------ */
+
+/* Opaque handle for a group of worker threads. */
+typedef struct EasyShards EasyShards;
+
+typedef struct {
+    /**
+     * @brief Start N workers, each with its own SO_REUSEPORT listener and
+     * EventLoop, pinned to a CPU. The kernel spreads new connections across
+     * the listeners, so there is no shared accept lock.
+     * Callbacks run on the worker that owns the connection.
+     * @param port The port to listen on.
+     * @param workers Number of workers (0 = one per online CPU).
+     * @param backlog listen() backlog per worker (0 = SOMAXCONN).
+     * @return The group or NULL on failure.
+     */
+    EasyShards* (*Start)(int port, int workers, int backlog,
+                         const EasyLoopCallbacks_t* cb, void* user);
+
+    /**
+     * @brief Number of workers actually started.
+     */
+    int (*Workers)(EasyShards* shards);
+
+    /**
+     * @brief Stop every worker, close its connections and free the group.
+     */
+    void (*Stop)(EasyShards* shards);
+
+} EasyShardedServer_t;
+
+extern const EasyShardedServer_t Shards;
+
+/* ------------------------------------------------------------------ */
+/*  Framed Channel (whole messages over a stream socket)               */
+/* ------------------------------------------------------------------ */
+
+/* Opaque per-connection channel handle. */
+typedef struct EasyChannel EasyChannel;
+
+typedef enum {
+    FRAME_LENGTH_PREFIX, // 4-byte big-endian length, then payload
+    FRAME_DELIMITER      // payload terminated by a single delimiter byte
+} EasyFrameMode_t;
+
+/* A received message. Points into the channel's buffer (no copy); valid
+ * until the next Read/Feed/Close on the same channel. */
+typedef struct {
+    const uint8_t* data;
+    uint32_t len;
+} EasyMessage_t;
+
+typedef struct {
+    /**
+     * @brief Wrap a connected socket in a framed channel.
+     * @param fd Connected stream socket (blocking or non-blocking), or -1 for
+     *           a receive-only channel that is filled with Feed.
+     * @param mode Framing used in both directions.
+     * @param delimiter Delimiter byte for FRAME_DELIMITER (e.g. '\n').
+     * @param max_message Largest accepted message in bytes (0 = 16 MiB).
+     * @return The channel or NULL on failure.
+     */
+    EasyChannel* (*Open)(int fd, EasyFrameMode_t mode, char delimiter, uint32_t max_message);
+
+    /**
+     * @brief Get the next whole message.
+     * Returns a message already buffered if there is one; otherwise does a
+     * single read() for as much as fits, which usually brings in many
+     * messages at once.
+     * @return 1 if msg was filled, 0 if no full message yet (non-blocking fd),
+     *         -1 on close, error or an oversized message.
+     */
+    int (*Read)(EasyChannel* ch, EasyMessage_t* msg);
+
+    /**
+     * @brief Append bytes that were read elsewhere (e.g. EventLoop on_read).
+     * Follow with Read until it returns 0. Use a channel opened with fd -1
+     * so Read never touches the socket the loop is draining.
+     * @return false if out of memory.
+     */
+    bool (*Feed)(EasyChannel* ch, const void* data, int len);
+
+    /**
+     * @brief Send one message; header/delimiter and payload go out in one
+     * gathered write (sendmsg with an iovec pair). Blocks until it is all sent.
+     * Binary payloads (including NUL bytes) are fine.
+     */
+    bool (*Send)(EasyChannel* ch, const void* data, uint32_t len);
+
+    /**
+     * @brief Free the channel. Does not close the fd.
+     */
+    void (*Close)(EasyChannel* ch);
+
+} EasyFramedChannel_t;
+
+extern const EasyFramedChannel_t Channel;
+
+/* ------------------------------------------------------------------ */
+/*  Send Queue (batched scatter/gather output)                         */
+/* ------------------------------------------------------------------ */
+
+/* Opaque per-fd outbound queue. */
+typedef struct EasySendQueue EasySendQueue;
+
+typedef struct {
+    uint64_t messages;  // Buffers pushed
+    uint64_t bytes;     // Bytes handed to the kernel
+    uint64_t syscalls;  // sendmsg() and TCP_CORK setsockopt() calls made
+    uint64_t pending;   // Bytes still queued
+} EasySendStats_t;
+
+typedef struct {
+    /**
+     * @brief Create an outbound queue for a connected socket.
+     * Pushes above 'high_watermark' queued bytes are refused until the
+     * queue drains below 'low_watermark' (0/0 = 256 KiB / 64 KiB).
+     * @return The queue or NULL on failure.
+     */
+    EasySendQueue* (*Create)(int fd, size_t low_watermark, size_t high_watermark);
+
+    /**
+     * @brief Queue a copy of 'data'. Small pushes are packed together so
+     * one sendmsg() carries many messages. Flushes automatically once a
+     * full batch is queued, unless the queue is corked.
+     * @return false if the high watermark was hit (nothing queued) or on error.
+     */
+    bool (*Push)(EasySendQueue* q, const void* data, size_t len);
+
+    /**
+     * @brief Queue 'data' without copying. 'release' (if set) is called
+     * with 'ctx' once the kernel has taken every byte or the queue is destroyed.
+     */
+    bool (*PushRef)(EasySendQueue* q, const void* data, size_t len,
+                    void (*release)(void* ctx), void* ctx);
+
+    /**
+     * @brief Write as much as possible with gathered sendmsg() calls.
+     * On a non-blocking socket, stops at EAGAIN; call again when writable.
+     * @return false on a socket error.
+     */
+    bool (*Flush)(EasySendQueue* q);
+
+    /**
+     * @brief Cork (true) holds output back (TCP_CORK / MSG_MORE) so several
+     * pushes leave as full segments. Uncork (false) flushes and releases it.
+     */
+    bool (*Cork)(EasySendQueue* q, bool on);
+
+    /**
+     * @brief true while the queue accepts pushes (below the watermark band).
+     */
+    bool (*Writable)(EasySendQueue* q);
+
+    /**
+     * @brief Copy the counters.
+     */
+    void (*Stats)(EasySendQueue* q, EasySendStats_t* stats);
+
+    /**
+     * @brief Free the queue (unsent data is dropped). Does not close the fd.
+     */
+    void (*Destroy)(EasySendQueue* q);
+
+} EasySendQueue_t;
+
+extern const EasySendQueue_t SendQueue;
+
+/* ------------------------------------------------------------------ */
+/*  Zero-Copy Transmission (sendfile / MSG_ZEROCOPY)                   */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    uint64_t zerocopy_sends;  // sendmsg(MSG_ZEROCOPY) calls completed
+    uint64_t copied_sends;    // ...of which the kernel copied anyway (e.g. loopback)
+    uint64_t fallback_sends;  // Plain send() calls (below threshold or unsupported)
+} EasyZeroCopyStats_t;
+
+typedef struct {
+    /**
+     * @brief Send part of an open file without copying it through user space.
+     * @param fd Connected socket (blocking or non-blocking).
+     * @param file_fd File opened for reading.
+     * @param offset Starting offset in the file.
+     * @param len Bytes to send (0 = up to end of file).
+     * @return Bytes sent, or -1 on error.
+     */
+    int64_t (*SendFile)(int fd, int file_fd, int64_t offset, int64_t len);
+
+    /**
+     * @brief Same as SendFile, but opens and closes 'path' itself.
+     */
+    int64_t (*SendPath)(int fd, const char* path, int64_t offset, int64_t len);
+
+    /**
+     * @brief Send a large buffer with MSG_ZEROCOPY: the kernel transmits
+     * straight from 'buf'. Returns once every completion has been read from
+     * the socket error queue, so 'buf' may be reused afterwards.
+     * Buffers below 'threshold' bytes (0 = 32 KiB), or sockets without
+     * SO_ZEROCOPY support, use a regular send().
+     * @return Bytes sent, or -1 on error.
+     */
+    int64_t (*SendBuffer)(int fd, const void* buf, size_t len, size_t threshold);
+
+    /**
+     * @brief Process-wide counters for SendBuffer.
+     */
+    void (*Stats)(EasyZeroCopyStats_t* stats);
+
+} EasyZeroCopy_t;
+
+extern const EasyZeroCopy_t ZeroCopy;
+
+/* ------------------------------------------------------------------ */
+/*  UDP Datagrams (single and recvmmsg/sendmmsg batches)               */
+/* ------------------------------------------------------------------ */
+
+/* One preallocated packet slot for the batch calls. */
+typedef struct {
+    uint8_t* data;              // Caller-owned buffer
+    uint32_t cap;               // Size of 'data'
+    uint32_t len;               // Bytes received / bytes to send
+    uint16_t segment_size;      // Receive with GRO: size of each coalesced segment (0 = single)
+    struct sockaddr_in addr;    // Source (receive) / destination (send on unconnected socket)
+} EasyDatagram_t;
+
+typedef struct {
+    /**
+     * @brief Open a UDP socket bound to a local port (0.0.0.0).
+     * @param port Local port (0 = any).
+     * @param rcvbuf Receive buffer size in bytes (0 = system default).
+     * @return The fd or -1 on failure.
+     */
+    int (*Bind)(int port, int rcvbuf);
+
+    /**
+     * @brief Open a UDP socket with a fixed peer, so Send needs no address.
+     * @return The fd or -1 on failure.
+     */
+    int (*Connect)(const char* ip, int port);
+
+    /**
+     * @brief Send one datagram on a connected socket.
+     */
+    bool (*Send)(int fd, const void* data, int len);
+
+    /**
+     * @brief Send one datagram to ip:port.
+     */
+    bool (*SendTo)(int fd, const char* ip, int port, const void* data, int len);
+
+    /**
+     * @brief Receive one datagram (blocking unless the fd is non-blocking).
+     * @param from Filled with the source address if not NULL.
+     * @return Bytes received, 0 if nothing is waiting (non-blocking), -1 on error.
+     */
+    int (*Receive)(int fd, void* buffer, int max_len, struct sockaddr_in* from);
+
+    /**
+     * @brief Receive up to 'count' datagrams with as few recvmmsg() calls as
+     * possible, filling the caller's slots in place.
+     * @param timeout_ms Wait for the first packet: -1 = forever, 0 = don't wait.
+     * @return Number of slots filled, or -1 on error.
+     */
+    int (*ReceiveBatch)(int fd, EasyDatagram_t* slots, int count, int timeout_ms);
+
+    /**
+     * @brief Send 'count' slots with sendmmsg(). 'addr' is used unless the
+     * socket is connected (set addr.sin_family = 0 to skip it).
+     * @return Number of datagrams sent, or -1 on error.
+     */
+    int (*SendBatch)(int fd, const EasyDatagram_t* slots, int count);
+
+    /**
+     * @brief UDP GSO: send 'len' bytes as datagrams of 'segment_size' bytes
+     * with one syscall (UDP_SEGMENT). Falls back to SendBatch-style sends
+     * if the kernel lacks GSO. The socket must be connected.
+     */
+    bool (*SendSegmented)(int fd, const void* data, int len, int segment_size);
+
+    /**
+     * @brief Ask the kernel to coalesce received datagrams (UDP_GRO).
+     * ReceiveBatch then reports the segment size of each slot.
+     */
+    bool (*EnableGro)(int fd);
+
+    /**
+     * @brief Close a UDP socket.
+     */
+    void (*Close)(int fd);
+
+} EasyUdp_t;
+
+extern const EasyUdp_t UDP;
+
+/* ------------------------------------------------------------------ */
+/*  Client Connection Pool                                             */
+/* ------------------------------------------------------------------ */
+
+/* Opaque pool handle. Safe to share between threads. */
+typedef struct EasyPool EasyPool;
+
+typedef struct {
+    uint64_t reused;     // Get served from an idle socket
+    uint64_t connected;  // Get had to open a new connection
+    uint64_t discarded;  // Idle sockets dropped (peer closed, stray data, too old)
+    uint64_t failed;     // Connects that failed or timed out
+} EasyPoolStats_t;
+
+typedef struct {
+    /**
+     * @brief Create a pool of client connections keyed by ip:port.
+     * @param max_idle Idle sockets kept per ip:port (0 = 16, max 64).
+     * @param connect_timeout_ms Limit for a new connect (0 = 3000).
+     * @param idle_timeout_ms Idle sockets older than this are closed (0 = 60000).
+     * @return The pool or NULL on failure.
+     */
+    EasyPool* (*Create)(int max_idle, int connect_timeout_ms, int idle_timeout_ms);
+
+    /**
+     * @brief Check out a blocking socket to ip:port.
+     * Reuses an idle socket if one passes a readability check (a readable
+     * idle socket means the peer closed it or sent stray data), otherwise
+     * connects without blocking past the timeout. New sockets get
+     * TCP_NODELAY and TCP keepalive. The fast path takes no lock.
+     * @return The fd or -1 on failure.
+     */
+    int (*Get)(EasyPool* pool, const char* ip, int port);
+
+    /**
+     * @brief Return a socket obtained from Get.
+     * @param reusable false if the exchange failed or left unread data;
+     *                 the socket is then closed instead of pooled.
+     */
+    void (*Put)(EasyPool* pool, int fd, bool reusable);
+
+    /**
+     * @brief Copy the counters.
+     */
+    void (*Stats)(EasyPool* pool, EasyPoolStats_t* stats);
+
+    /**
+     * @brief Close every idle socket and free the pool.
+     * No other thread may use the pool during or after this call.
+     */
+    void (*Destroy)(EasyPool* pool);
+
+} EasyConnPool_t;
+
+extern const EasyConnPool_t Pool;
+
+/* ------------------------------------------------------------------ */
+/*  Timer Wheel (idle / read / write deadlines)                        */
+/* ------------------------------------------------------------------ */
+
+/* Opaque wheel handle. Not thread-safe: use it from the loop's thread. */
+typedef struct EasyTimerWheel EasyTimerWheel;
+
+typedef struct EasyTimer EasyTimer;
+typedef void (*EasyTimerFn)(EasyTimer* timer, void* user);
+
+/* One deadline, usually embedded in the caller's per-connection struct.
+ * Zero-initialise it and only touch it through Timers. */
+struct EasyTimer {
+    EasyTimer* next;
+    EasyTimer** pprev;   // NULL while not armed
+    uint64_t expires;    // In wheel ticks
+    uint32_t slot;
+    EasyTimerFn fn;
+    void* user;
+};
+
+typedef struct {
+    /**
+     * @brief Create a hierarchical timing wheel (256 + 4 x 64 slots).
+     * Start and Cancel are O(1) no matter how many timers are armed.
+     * @param tick_ms Resolution (0 = 10 ms). Deadlines are rounded up to it.
+     * @return The wheel or NULL on failure.
+     */
+    EasyTimerWheel* (*Create)(int tick_ms);
+
+    /**
+     * @brief Arm a timer, or re-arm it if already pending (e.g. push an idle
+     * deadline back on every read).
+     * @param delay_ms Time from now; fn runs once from Advance/Poll.
+     */
+    void (*Start)(EasyTimerWheel* wheel, EasyTimer* timer, int delay_ms,
+                  EasyTimerFn fn, void* user);
+
+    /**
+     * @brief Disarm a timer. Harmless if it is not pending.
+     */
+    void (*Cancel)(EasyTimerWheel* wheel, EasyTimer* timer);
+
+    /**
+     * @brief true while the timer is armed.
+     */
+    bool (*Pending)(const EasyTimer* timer);
+
+    /**
+     * @brief Timeout to pass to poll()/epoll_wait() so the next deadline is
+     * not missed.
+     * @param max_ms Upper bound (-1 = none).
+     * @return Milliseconds, or max_ms if nothing fires sooner.
+     */
+    int (*NextTimeout)(EasyTimerWheel* wheel, int max_ms);
+
+    /**
+     * @brief Run the callbacks of every expired timer. Callbacks may Start or
+     * Cancel any timer, including their own.
+     * @return Number of callbacks run.
+     */
+    int (*Advance)(EasyTimerWheel* wheel);
+
+    /**
+     * @brief engine->Poll with the timeout cut to the next deadline, then
+     * Advance. Drop-in replacement for EventLoop.Poll / UringLoop.Poll.
+     * @return Events plus timers handled, or -1 on error.
+     */
+    int (*Poll)(EasyTimerWheel* wheel, const EasyEventLoop_t* engine,
+                EasyLoop* loop, int max_ms);
+
+    /**
+     * @brief Free the wheel. Pending timers are dropped without running.
+     */
+    void (*Destroy)(EasyTimerWheel* wheel);
+
+} EasyTimers_t;
+
+extern const EasyTimers_t Timers;
+
+/* ------------------------------------------------------------------ */
+/*  Unix Domain Sockets (same-host IPC, fd passing)                    */
+/* ------------------------------------------------------------------ */
+
+typedef enum {
+    UNIX_STREAM,    // Byte stream, like TCP
+    UNIX_SEQPACKET  // Connected, reliable, message boundaries preserved
+} EasyUnixType_t;
+
+typedef struct {
+    /**
+     * @brief Start an AF_UNIX server.
+     * A stale socket file left at 'path' is removed first. A path starting
+     * with '@' uses the Linux abstract namespace (no file at all).
+     * @return The server_fd or -1 on failure.
+     */
+    int (*StartServer)(const char* path, EasyUnixType_t type);
+
+    /**
+     * @brief Accept a new client. Blocks until a client connects.
+     * @return The client_fd or -1 on failure.
+     */
+    int (*Accept)(int server_fd);
+
+    /**
+     * @brief Connect to an AF_UNIX server.
+     * @return The connection_fd or -1 on failure.
+     */
+    int (*Connect)(const char* path, EasyUnixType_t type);
+
+    /**
+     * @brief Send len bytes. On a stream socket every byte is written; on a
+     * seqpacket socket this is one message.
+     */
+    bool (*Send)(int fd, const void* data, int len);
+
+    /**
+     * @brief Receive data (one whole message on seqpacket).
+     * @return Number of bytes read, 0 if closed, -1 if error.
+     */
+    int (*Receive)(int fd, void* buffer, int max_len);
+
+    /**
+     * @brief Send a file descriptor (SCM_RIGHTS) along with a message.
+     * The receiver gets its own fd for the same open file/socket/tty.
+     * @param data Payload sent with it; at least one byte is always sent.
+     */
+    bool (*SendFd)(int fd, int fd_to_pass, const void* data, int len);
+
+    /**
+     * @brief Receive a message and the fd attached to it, if any.
+     * @param received_fd Set to the new fd (close-on-exec) or -1.
+     * @return Number of bytes read, 0 if closed, -1 if error.
+     */
+    int (*ReceiveFd)(int fd, void* buffer, int max_len, int* received_fd);
+
+    /**
+     * @brief Close a socket. For a server bound to a path, the socket
+     * file is removed as well.
+     */
+    void (*Close)(int fd);
+
+} EasyUnixSocket_t;
+
+extern const EasyUnixSocket_t UnixSocket;
+
+/* ------------------------------------------------------------------ */
+/*  Serial Bridge (serial port <-> TCP clients)                        */
+/* ------------------------------------------------------------------ */
+
+/*
+ * One thread pumps a serial fd (e.g. Serial.Fd(port) from libeasy_serial)
+ * to every connected client and client data back to the serial fd.
+ * Serial data goes through kernel pipes with splice()/tee(), so it is never
+ * copied to user space and every client shares the same pages. Where the
+ * serial driver does not support splice, one read() fills a shared ring and
+ * each client sends straight from it.
+ *
+ * Each client has its own buffer (client_buffer bytes). A client that falls
+ * further behind than that loses the oldest data instead of slowing the
+ * serial port or the other clients; stats.dropped counts the lost bytes.
+ * With splice, a client that has a backlog gets further data through the
+ * shared ring, so small serial reads do not use up its pipe long before
+ * client_buffer bytes are queued.
+ */
+
+/* Opaque bridge handle. */
+typedef struct EasyBridge EasyBridge;
+
+typedef enum {
+    BRIDGE_AUTO,    // splice where the kernel allows it, else copy
+    BRIDGE_COPY     // Always the shared ring (read/send)
+} EasyBridgeMode_t;
+
+typedef struct {
+    uint64_t serial_in;     // Bytes read from the serial fd
+    uint64_t serial_out;    // Bytes written to the serial fd
+    uint64_t client_out;    // Bytes sent to clients (all of them)
+    uint64_t dropped;       // Bytes slow clients missed
+    uint32_t clients;       // Connected now
+    uint32_t accepted;      // Connected since Start
+    bool spliced;           // Serial data currently goes through splice
+} EasyBridgeStats_t;
+
+typedef struct {
+    /**
+     * @brief Start bridging. The serial fd is switched to non-blocking mode
+     * until Stop; it is not closed.
+     * @param port TCP port to accept clients on (0 = none, use AddClient).
+     * @param client_buffer Per-client backlog in bytes (0 = 64 KiB).
+     * @return The bridge or NULL on failure.
+     */
+    EasyBridge* (*Start)(int serial_fd, int port, EasyBridgeMode_t mode, int client_buffer);
+
+    /**
+     * @brief Hand an already connected socket to the bridge, which then
+     * owns it. Safe from any thread.
+     */
+    bool (*AddClient)(EasyBridge* bridge, int fd);
+
+    /**
+     * @brief Copy the counters. Safe from any thread.
+     */
+    void (*Stats)(EasyBridge* bridge, EasyBridgeStats_t* stats);
+
+    /**
+     * @brief Stop the thread, close the listener and every client, and
+     * restore the serial fd's flags.
+     */
+    void (*Stop)(EasyBridge* bridge);
+
+} EasyBridge_t;
+
+extern const EasyBridge_t Bridge;
+
 #endif
\ No newline at end of file
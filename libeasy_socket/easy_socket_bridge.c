@@ -0,0 +1,616 @@
+#define _GNU_SOURCE // splice, tee, accept4, F_SETPIPE_SZ
+#include "easy_socket_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#define BRIDGE_CHUNK          (64 * 1024)   // Most moved per splice/read
+#define BRIDGE_DEFAULT_BUFFER (64 * 1024)
+#define BRIDGE_MAX_EVENTS     64
+#define BRIDGE_BACKLOG        16
+
+// --- Internal Storage ---
+
+enum { CONN_SERIAL, CONN_LISTEN, CONN_CTL, CONN_CLIENT };
+
+// Everything registered with epoll. Serial and client fds are edge-triggered;
+// 'readable'/'writable' remember the last edge until we hit EAGAIN.
+typedef struct BridgeConn {
+    int kind;
+    int fd;
+    bool readable;
+    bool writable;
+    bool dead;                  // Closed at the end of this round
+
+    int pipe[2];                // splice: data waiting for this client
+    uint32_t queued;            // splice: bytes in 'pipe', sent before the ring
+    uint64_t pos;               // Next ring byte this client needs
+
+    struct BridgeConn* next;
+} BridgeConn;
+
+// Sockets handed over with AddClient, adopted by the bridge thread
+typedef struct PendingClient {
+    int fd;
+    struct PendingClient* next;
+} PendingClient;
+
+struct EasyBridge {
+    int epoll_fd;
+    BridgeConn serial;
+    BridgeConn listener;
+    BridgeConn ctl;             // eventfd: stop / new clients
+    int serial_flags;           // Restored on Stop
+    bool serial_gone;
+
+    BridgeConn* clients;
+    uint32_t client_buffer;
+
+    // Serial -> clients
+    bool splice_in;
+    int in_pipe[2];
+    int null_fd;                // Sink for data no client could take
+    uint8_t* ring;              // Copy mode and lagging splice clients, allocated on first use
+    uint32_t ring_mask;
+    uint64_t ring_head;
+
+    // Clients -> serial
+    bool splice_out;
+    int out_pipe[2];
+    uint8_t out_buf[BRIDGE_CHUNK];
+    uint32_t out_off;
+    uint32_t out_pending;       // Bytes in out_pipe (splice) or out_buf (copy)
+
+    pthread_mutex_t lock;
+    PendingClient* pending;
+    bool stop;
+    pthread_t thread;
+
+    EasyBridgeStats_t stats;
+};
+
+// --- Helpers ---
+
+static void count(uint64_t* counter, uint64_t n) {
+    __atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+}
+
+static bool watch(EasyBridge* b, BridgeConn* c, uint32_t events) {
+    struct epoll_event ev = { .events = events, .data.ptr = c };
+    if (epoll_ctl(b->epoll_fd, EPOLL_CTL_ADD, c->fd, &ev) < 0) {
+        perror("EasySocket: epoll_ctl failed");
+        return false;
+    }
+    return true;
+}
+
+static void close_pipe(int p[2]) {
+    if (p[0] >= 0) close(p[0]);
+    if (p[1] >= 0) close(p[1]);
+    p[0] = p[1] = -1;
+}
+
+static void add_client(EasyBridge* b, int fd) {
+    BridgeConn* c = calloc(1, sizeof(BridgeConn));
+    if (!c) {
+        perror("EasySocket: Out of memory");
+        close(fd);
+        return;
+    }
+    c->kind = CONN_CLIENT;
+    c->fd = fd;
+    c->pipe[0] = c->pipe[1] = -1;
+    c->pos = b->ring_head; // New clients get data from now on
+
+    int on = 1;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    if (b->splice_in) {
+        if (pipe2(c->pipe, O_NONBLOCK | O_CLOEXEC) < 0) {
+            perror("EasySocket: pipe failed");
+            close(fd);
+            free(c);
+            return;
+        }
+        fcntl(c->pipe[1], F_SETPIPE_SZ, (int)b->client_buffer); // Best effort
+    }
+    if (!watch(b, c, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET)) {
+        close_pipe(c->pipe);
+        close(fd);
+        free(c);
+        return;
+    }
+
+    c->next = b->clients;
+    b->clients = c;
+    __atomic_fetch_add(&b->stats.clients, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&b->stats.accepted, 1, __ATOMIC_RELAXED);
+}
+
+static void reap_clients(EasyBridge* b) {
+    BridgeConn** link = &b->clients;
+    while (*link) {
+        BridgeConn* c = *link;
+        if (!c->dead) {
+            link = &c->next;
+            continue;
+        }
+        *link = c->next;
+        close(c->fd); // Also removes it from epoll
+        close_pipe(c->pipe);
+        free(c);
+        __atomic_fetch_sub(&b->stats.clients, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void serial_gone(EasyBridge* b, const char* why) {
+    if (why) perror(why);
+    epoll_ctl(b->epoll_fd, EPOLL_CTL_DEL, b->serial.fd, NULL);
+    b->serial.readable = b->serial.writable = false;
+    b->serial_gone = true;
+    fprintf(stderr, "EasySocket: Bridge serial port closed\n");
+}
+
+static bool alloc_ring(EasyBridge* b) {
+    if (b->ring) return true;
+    uint32_t size = 1;
+    while (size < b->client_buffer) size <<= 1;
+    b->ring = malloc(size);
+    if (!b->ring) {
+        perror("EasySocket: Out of memory");
+        return false;
+    }
+    b->ring_mask = size - 1;
+    return true;
+}
+
+// The serial driver has no splice support: move to the shared ring.
+// Nothing was ever spliced, so the client pipes are empty.
+static bool switch_to_copy(EasyBridge* b) {
+    if (!alloc_ring(b)) return false;
+    b->splice_in = false;
+    __atomic_store_n(&b->stats.spliced, false, __ATOMIC_RELAXED);
+    for (BridgeConn* c = b->clients; c; c = c->next) {
+        close_pipe(c->pipe);
+        c->pos = b->ring_head;
+    }
+    return true;
+}
+
+// --- Serial -> clients ---
+
+// The pipe first (older data), then anything waiting in the ring
+static void flush_client(EasyBridge* b, BridgeConn* c) {
+    while (c->writable && !c->dead) {
+        ssize_t n;
+        bool from_pipe = c->queued > 0;
+        if (from_pipe) {
+            n = splice(c->pipe[0], NULL, c->fd, NULL, c->queued, SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+        } else {
+            if (c->pos == b->ring_head) return;
+            uint32_t off = (uint32_t)(c->pos & b->ring_mask);
+            uint64_t len = b->ring_head - c->pos;
+            if (len > b->ring_mask + 1 - off) len = b->ring_mask + 1 - off;
+            n = send(c->fd, b->ring + off, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        }
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) c->writable = false;
+            else c->dead = true; // Peer reset or gone
+            return;
+        }
+        if (from_pipe) c->queued -= (uint32_t)n;
+        else c->pos += (uint64_t)n;
+        count(&b->stats.client_out, n);
+    }
+}
+
+// Drop what a client can no longer get from the ring: it resumes with the
+// newest client_buffer bytes
+static void trim_client(EasyBridge* b, BridgeConn* c) {
+    uint64_t size = (uint64_t)b->ring_mask + 1;
+    if (b->ring_head - c->pos > size) {
+        count(&b->stats.dropped, b->ring_head - size - c->pos);
+        c->pos = b->ring_head - size;
+    }
+}
+
+// Give 'n' bytes sitting in in_pipe to every client. Clients that are up to
+// date get them with tee() (shares the pipe pages). A pipe limits buffers,
+// not bytes, so small serial reads would fill it after a few hundred bytes:
+// once a client has a backlog, or a tee comes up short, the rest of its data
+// is copied to the shared ring instead, just like copy mode.
+static void fan_out_splice(EasyBridge* b, uint32_t n) {
+    uint64_t start = b->ring_head;
+    uint64_t head = start + n;
+    bool need_ring = false;
+
+    for (BridgeConn* c = b->clients; c; c = c->next) {
+        if (c->dead) continue;
+        if (c->queued == 0 && c->pos == start) {
+            ssize_t t = tee(b->in_pipe[0], c->pipe[1], n, SPLICE_F_NONBLOCK);
+            if (t < 0) t = 0;
+            c->queued += (uint32_t)t;
+            c->pos = start + (uint64_t)t;
+        }
+        if (c->pos != head) need_ring = true;
+    }
+    b->ring_head = head;
+
+    // Ring positions advance even when nobody needs the bytes: no client
+    // points before them, so they are never read
+    uint32_t left = n;
+    if (need_ring && alloc_ring(b)) {
+        uint64_t pos = start;
+        while (pos < head) {
+            uint32_t off = (uint32_t)(pos & b->ring_mask);
+            uint64_t len = head - pos;
+            if (len > b->ring_mask + 1 - off) len = b->ring_mask + 1 - off;
+            ssize_t t = read(b->in_pipe[0], b->ring + off, len);
+            if (t <= 0) break;
+            pos += (uint64_t)t;
+        }
+        left = (uint32_t)(head - pos);
+    }
+    while (left > 0) {
+        ssize_t t = splice(b->in_pipe[0], NULL, b->null_fd, NULL, left, SPLICE_F_MOVE);
+        if (t <= 0) break;
+        left -= (uint32_t)t;
+    }
+
+    for (BridgeConn* c = b->clients; c; c = c->next) {
+        if (c->dead) continue;
+        if (!b->ring) {
+            // No ring to hold it: lagging clients lose this chunk
+            count(&b->stats.dropped, head - c->pos);
+            c->pos = head;
+        }
+        trim_client(b, c);
+        flush_client(b, c);
+    }
+}
+
+static void fan_out_copy(EasyBridge* b, uint32_t n) {
+    b->ring_head += n;
+    for (BridgeConn* c = b->clients; c; c = c->next) {
+        if (c->dead) continue;
+        trim_client(b, c); // Overwritten before this client could send it
+        flush_client(b, c);
+    }
+}
+
+static void pump_serial_in(EasyBridge* b) {
+    while (b->serial.readable) {
+        ssize_t n;
+        if (b->splice_in) {
+            n = splice(b->serial.fd, NULL, b->in_pipe[1], NULL, BRIDGE_CHUNK,
+                       SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+            if (n < 0 && errno == EINVAL) {
+                if (!switch_to_copy(b)) {
+                    serial_gone(b, NULL);
+                    return;
+                }
+                continue;
+            }
+        } else {
+            uint32_t off = (uint32_t)(b->ring_head & b->ring_mask);
+            uint32_t room = b->ring_mask + 1 - off;
+            n = read(b->serial.fd, b->ring + off, room < BRIDGE_CHUNK ? room : BRIDGE_CHUNK);
+        }
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) b->serial.readable = false;
+            else serial_gone(b, "EasySocket: Bridge serial read failed");
+            return;
+        }
+        if (n == 0) {
+            b->serial.readable = false;
+            return;
+        }
+
+        count(&b->stats.serial_in, n);
+        if (b->splice_in) fan_out_splice(b, (uint32_t)n);
+        else fan_out_copy(b, (uint32_t)n);
+    }
+}
+
+// --- Clients -> serial ---
+
+// Write what is pending; returns false while the serial side is blocked
+static bool push_serial_out(EasyBridge* b) {
+    while (b->out_pending > 0) {
+        if (b->serial_gone) {
+            if (b->splice_out) {
+                splice(b->out_pipe[0], NULL, b->null_fd, NULL, b->out_pending, SPLICE_F_MOVE);
+            }
+            b->out_pending = 0;
+            return true;
+        }
+        if (!b->serial.writable) return false;
+
+        ssize_t n;
+        if (b->splice_out) {
+            n = splice(b->out_pipe[0], NULL, b->serial.fd, NULL, b->out_pending,
+                       SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+            if (n < 0 && errno == EINVAL) {
+                // No splice_write in this driver: pull the data back out of
+                // the pipe and write it from now on
+                n = read(b->out_pipe[0], b->out_buf, b->out_pending);
+                b->out_off = 0;
+                b->out_pending = (n > 0) ? (uint32_t)n : 0;
+                b->splice_out = false;
+                continue;
+            }
+        } else {
+            n = write(b->serial.fd, b->out_buf + b->out_off, b->out_pending);
+        }
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) {
+                b->serial.writable = false;
+                return false;
+            }
+            serial_gone(b, "EasySocket: Bridge serial write failed");
+            continue;
+        }
+        b->out_pending -= (uint32_t)n;
+        b->out_off += (uint32_t)n;
+        count(&b->stats.serial_out, n);
+    }
+    return true;
+}
+
+// One chunk from each readable client per pass, so none can starve the others
+static void pump_serial_out(EasyBridge* b) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (BridgeConn* c = b->clients; c; c = c->next) {
+            if (!push_serial_out(b)) return;
+            if (!c->readable || c->dead) continue;
+
+            ssize_t n;
+            if (b->splice_out) {
+                n = splice(c->fd, NULL, b->out_pipe[1], NULL, BRIDGE_CHUNK,
+                           SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+            } else {
+                n = recv(c->fd, b->out_buf, sizeof(b->out_buf), MSG_DONTWAIT);
+                b->out_off = 0;
+            }
+
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN) c->readable = false;
+                else c->dead = true;
+                continue;
+            }
+            if (n == 0) {
+                c->dead = true; // Client hung up
+                continue;
+            }
+            b->out_pending = (uint32_t)n;
+            progress = true;
+        }
+        if (!push_serial_out(b)) return;
+    }
+}
+
+// --- Bridge Thread ---
+
+static void adopt_pending(EasyBridge* b) {
+    pthread_mutex_lock(&b->lock);
+    PendingClient* p = b->pending;
+    b->pending = NULL;
+    pthread_mutex_unlock(&b->lock);
+
+    while (p) {
+        PendingClient* next = p->next;
+        add_client(b, p->fd);
+        free(p);
+        p = next;
+    }
+}
+
+static void accept_clients(EasyBridge* b) {
+    for (;;) {
+        int fd = accept4(b->listener.fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) perror("EasySocket: Accept failed");
+            return;
+        }
+        add_client(b, fd);
+    }
+}
+
+static void* bridge_thread(void* arg) {
+    EasyBridge* b = arg;
+    struct epoll_event events[BRIDGE_MAX_EVENTS];
+
+    for (;;) {
+        int n = epoll_wait(b->epoll_fd, events, BRIDGE_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("EasySocket: epoll_wait failed");
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            BridgeConn* c = events[i].data.ptr;
+            uint32_t ev = events[i].events;
+
+            if (c->kind == CONN_CTL) {
+                uint64_t v;
+                if (read(b->ctl.fd, &v, sizeof(v)) < 0 && errno != EAGAIN) perror("EasySocket: eventfd");
+                if (__atomic_load_n(&b->stop, __ATOMIC_ACQUIRE)) return NULL;
+                adopt_pending(b);
+            } else if (c->kind == CONN_LISTEN) {
+                accept_clients(b);
+            } else {
+                if (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) c->readable = true;
+                if (ev & (EPOLLOUT | EPOLLHUP | EPOLLERR)) c->writable = true;
+            }
+        }
+
+        pump_serial_in(b);
+        for (BridgeConn* c = b->clients; c; c = c->next) flush_client(b, c);
+        pump_serial_out(b);
+        reap_clients(b);
+    }
+    return NULL;
+}
+
+// --- Implementation ---
+
+static void free_bridge(EasyBridge* b) {
+    if (b->epoll_fd >= 0) close(b->epoll_fd);
+    if (b->listener.fd >= 0) close(b->listener.fd);
+    if (b->ctl.fd >= 0) close(b->ctl.fd);
+    if (b->null_fd >= 0) close(b->null_fd);
+    close_pipe(b->in_pipe);
+    close_pipe(b->out_pipe);
+    pthread_mutex_destroy(&b->lock);
+    free(b->ring);
+    free(b);
+}
+
+static EasyBridge* Bridge_Start(int serial_fd, int port, EasyBridgeMode_t mode, int client_buffer) {
+    EasyBridge* b = calloc(1, sizeof(EasyBridge));
+    if (!b) {
+        perror("EasySocket: Out of memory");
+        return NULL;
+    }
+    pthread_mutex_init(&b->lock, NULL);
+    b->listener.fd = b->ctl.fd = b->null_fd = -1;
+    b->in_pipe[0] = b->in_pipe[1] = b->out_pipe[0] = b->out_pipe[1] = -1;
+    b->client_buffer = (client_buffer > 0) ? (uint32_t)client_buffer : BRIDGE_DEFAULT_BUFFER;
+
+    b->serial.kind = CONN_SERIAL;
+    b->serial.fd = serial_fd;
+    b->serial.writable = true;
+    b->listener.kind = CONN_LISTEN;
+    b->ctl.kind = CONN_CTL;
+
+    b->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    b->ctl.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    b->null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (b->epoll_fd < 0 || b->ctl.fd < 0 || b->null_fd < 0 ||
+        pipe2(b->in_pipe, O_NONBLOCK | O_CLOEXEC) < 0 ||
+        pipe2(b->out_pipe, O_NONBLOCK | O_CLOEXEC) < 0) {
+        perror("EasySocket: Bridge setup failed");
+        free_bridge(b);
+        return NULL;
+    }
+    fcntl(b->in_pipe[1], F_SETPIPE_SZ, BRIDGE_CHUNK);
+    fcntl(b->out_pipe[1], F_SETPIPE_SZ, BRIDGE_CHUNK);
+
+    b->splice_in = b->splice_out = (mode != BRIDGE_COPY);
+    if (!b->splice_in && !switch_to_copy(b)) {
+        free_bridge(b);
+        return NULL;
+    }
+    __atomic_store_n(&b->stats.spliced, b->splice_in, __ATOMIC_RELAXED);
+
+    if (port > 0) {
+        b->listener.fd = easy_listen_socket(port, BRIDGE_BACKLOG);
+        if (b->listener.fd < 0 || !watch(b, &b->listener, EPOLLIN)) {
+            free_bridge(b);
+            return NULL;
+        }
+    }
+
+    b->serial_flags = fcntl(serial_fd, F_GETFL, 0);
+    if (b->serial_flags < 0 || fcntl(serial_fd, F_SETFL, b->serial_flags | O_NONBLOCK) < 0) {
+        perror("EasySocket: Bridge serial fd unusable");
+        free_bridge(b);
+        return NULL;
+    }
+    if (!watch(b, &b->ctl, EPOLLIN) ||
+        !watch(b, &b->serial, EPOLLIN | EPOLLOUT | EPOLLET)) {
+        fcntl(serial_fd, F_SETFL, b->serial_flags);
+        free_bridge(b);
+        return NULL;
+    }
+
+    if (pthread_create(&b->thread, NULL, bridge_thread, b) != 0) {
+        fprintf(stderr, "EasySocket: Unable to create bridge thread\n");
+        fcntl(serial_fd, F_SETFL, b->serial_flags);
+        free_bridge(b);
+        return NULL;
+    }
+
+    if (port > 0) printf("EasySocket: Bridge listening on port %d...\n", port);
+    return b;
+}
+
+static bool Bridge_AddClient(EasyBridge* b, int fd) {
+    if (!b || fd < 0) return false;
+    PendingClient* p = malloc(sizeof(PendingClient));
+    if (!p) {
+        perror("EasySocket: Out of memory");
+        return false;
+    }
+    p->fd = fd;
+
+    pthread_mutex_lock(&b->lock);
+    p->next = b->pending;
+    b->pending = p;
+    pthread_mutex_unlock(&b->lock);
+
+    uint64_t one = 1;
+    return write(b->ctl.fd, &one, sizeof(one)) == sizeof(one);
+}
+
+static void Bridge_Stats(EasyBridge* b, EasyBridgeStats_t* stats) {
+    stats->serial_in = __atomic_load_n(&b->stats.serial_in, __ATOMIC_RELAXED);
+    stats->serial_out = __atomic_load_n(&b->stats.serial_out, __ATOMIC_RELAXED);
+    stats->client_out = __atomic_load_n(&b->stats.client_out, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&b->stats.dropped, __ATOMIC_RELAXED);
+    stats->clients = __atomic_load_n(&b->stats.clients, __ATOMIC_RELAXED);
+    stats->accepted = __atomic_load_n(&b->stats.accepted, __ATOMIC_RELAXED);
+    stats->spliced = __atomic_load_n(&b->stats.spliced, __ATOMIC_RELAXED);
+}
+
+static void Bridge_Stop(EasyBridge* b) {
+    if (!b) return;
+
+    __atomic_store_n(&b->stop, true, __ATOMIC_RELEASE);
+    uint64_t one = 1;
+    if (write(b->ctl.fd, &one, sizeof(one)) < 0) perror("EasySocket: Unable to stop bridge");
+    pthread_join(b->thread, NULL);
+
+    for (BridgeConn* c = b->clients; c; c = c->next) c->dead = true;
+    reap_clients(b);
+    while (b->pending) {
+        PendingClient* p = b->pending;
+        b->pending = p->next;
+        close(p->fd);
+        free(p);
+    }
+    if (!b->serial_gone) epoll_ctl(b->epoll_fd, EPOLL_CTL_DEL, b->serial.fd, NULL);
+    fcntl(b->serial.fd, F_SETFL, b->serial_flags);
+
+    free_bridge(b);
+    printf("EasySocket: Bridge stopped.\n");
+}
+
+// Map the functions
+const EasyBridge_t Bridge = {
+    .Start = Bridge_Start,
+    .AddClient = Bridge_AddClient,
+    .Stats = Bridge_Stats,
+    .Stop = Bridge_Stop
+};
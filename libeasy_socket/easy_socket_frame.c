@@ -0,0 +1,217 @@
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#define FRAME_HEADER_LEN      4
+#define FRAME_DEFAULT_MAX     (16u * 1024 * 1024)
+#define FRAME_INITIAL_BUFFER  65536
+
+// --- Internal Storage ---
+
+// Receive buffer: bytes [head, tail) are unconsumed. Messages are handed out
+// as pointers into [head, tail); only the trailing partial message is ever
+// moved (to the front, when the end of the buffer is reached).
+struct EasyChannel {
+    int fd;
+    EasyFrameMode_t mode;
+    char delimiter;
+    uint32_t max_message;
+
+    uint8_t* buf;
+    size_t cap;
+    size_t head;
+    size_t tail;
+    size_t scan;    // Delimiter mode: everything in [head, scan) has been searched
+};
+
+// --- Helpers ---
+
+// 1 = message, 0 = need more bytes (*need = total bytes required), -1 = bad frame
+static int parse(EasyChannel* ch, EasyMessage_t* msg, size_t* need) {
+    size_t avail = ch->tail - ch->head;
+
+    if (ch->mode == FRAME_LENGTH_PREFIX) {
+        if (avail < FRAME_HEADER_LEN) {
+            *need = FRAME_HEADER_LEN;
+            return 0;
+        }
+        uint32_t len;
+        memcpy(&len, ch->buf + ch->head, sizeof(len));
+        len = ntohl(len);
+        if (len > ch->max_message) {
+            fprintf(stderr, "EasySocket: Message of %u bytes exceeds limit\n", len);
+            return -1;
+        }
+        if (avail < FRAME_HEADER_LEN + (size_t)len) {
+            *need = FRAME_HEADER_LEN + (size_t)len;
+            return 0;
+        }
+        msg->data = ch->buf + ch->head + FRAME_HEADER_LEN;
+        msg->len = len;
+        ch->head += FRAME_HEADER_LEN + len;
+        return 1;
+    }
+
+    // Delimiter framing: only search the bytes that arrived since last time
+    size_t from = (ch->scan > ch->head) ? ch->scan : ch->head;
+    uint8_t* hit = memchr(ch->buf + from, (unsigned char)ch->delimiter, ch->tail - from);
+    if (!hit) {
+        ch->scan = ch->tail;
+        if (avail > ch->max_message) {
+            fprintf(stderr, "EasySocket: Message exceeds limit\n");
+            return -1;
+        }
+        *need = avail + 1;
+        return 0;
+    }
+    msg->data = ch->buf + ch->head;
+    msg->len = (uint32_t)(hit - msg->data);
+    ch->head = (size_t)(hit - ch->buf) + 1;
+    ch->scan = ch->head;
+    return 1;
+}
+
+// Make room after 'tail' so at least 'need' unconsumed bytes fit in the buffer
+static bool make_room(EasyChannel* ch, size_t need) {
+    size_t avail = ch->tail - ch->head;
+
+    if (avail == 0) {
+        ch->head = ch->tail = ch->scan = 0;
+    } else if (ch->head > 0 && (ch->cap - ch->tail < ch->cap / 4 || ch->head + need > ch->cap)) {
+        // Slide the partial message to the front
+        memmove(ch->buf, ch->buf + ch->head, avail);
+        ch->scan -= (ch->scan > ch->head) ? ch->head : ch->scan;
+        ch->tail = avail;
+        ch->head = 0;
+    }
+
+    if (need <= ch->cap && ch->tail < ch->cap) return true;
+
+    size_t new_cap = ch->cap * 2;
+    while (new_cap < need) new_cap *= 2;
+    uint8_t* grown = realloc(ch->buf, new_cap);
+    if (!grown) {
+        perror("EasySocket: Channel buffer");
+        return false;
+    }
+    ch->buf = grown;
+    ch->cap = new_cap;
+    return true;
+}
+
+// --- Implementation ---
+
+static EasyChannel* Channel_Open(int fd, EasyFrameMode_t mode, char delimiter, uint32_t max_message) {
+    EasyChannel* ch = calloc(1, sizeof(EasyChannel));
+    if (!ch) return NULL;
+
+    ch->fd = fd;
+    ch->mode = mode;
+    ch->delimiter = delimiter;
+    ch->max_message = max_message ? max_message : FRAME_DEFAULT_MAX;
+    ch->cap = FRAME_INITIAL_BUFFER;
+    ch->buf = malloc(ch->cap);
+    if (!ch->buf) {
+        free(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+static int Channel_Read(EasyChannel* ch, EasyMessage_t* msg) {
+    for (;;) {
+        size_t need = 0;
+        int r = parse(ch, msg, &need);
+        if (r != 0) return r;
+        if (ch->fd < 0) return 0; // Feed-only channel
+
+        if (!make_room(ch, need)) return -1;
+
+        ssize_t n = read(ch->fd, ch->buf + ch->tail, ch->cap - ch->tail);
+        if (n > 0) {
+            ch->tail += n;
+            continue;
+        }
+        if (n == 0) return -1; // Peer closed
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        perror("EasySocket: Read error");
+        return -1;
+    }
+}
+
+static bool Channel_Feed(EasyChannel* ch, const void* data, int len) {
+    if (len <= 0) return true;
+    if (!make_room(ch, ch->tail - ch->head + len)) return false;
+    memcpy(ch->buf + ch->tail, data, len);
+    ch->tail += len;
+    return true;
+}
+
+static bool Channel_Send(EasyChannel* ch, const void* data, uint32_t len) {
+    uint32_t header = htonl(len);
+    struct iovec iov[2];
+
+    if (ch->mode == FRAME_LENGTH_PREFIX) {
+        iov[0] = (struct iovec){ &header, FRAME_HEADER_LEN };
+        iov[1] = (struct iovec){ (void*)data, len };
+    } else {
+        iov[0] = (struct iovec){ (void*)data, len };
+        iov[1] = (struct iovec){ &ch->delimiter, 1 };
+    }
+
+    struct msghdr mh = { .msg_iov = iov, .msg_iovlen = 2 };
+    size_t left = iov[0].iov_len + iov[1].iov_len;
+
+    while (left > 0) {
+        ssize_t w = sendmsg(ch->fd, &mh, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // Non-blocking socket is full; a message is never sent half-way
+                struct pollfd pfd = { .fd = ch->fd, .events = POLLOUT };
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            perror("EasySocket: Send failed");
+            return false;
+        }
+        left -= w;
+
+        // Short write: skip what was sent and retry with the rest
+        while (w > 0 && mh.msg_iovlen > 0) {
+            if ((size_t)w >= mh.msg_iov->iov_len) {
+                w -= mh.msg_iov->iov_len;
+                mh.msg_iov++;
+                mh.msg_iovlen--;
+            } else {
+                mh.msg_iov->iov_base = (char*)mh.msg_iov->iov_base + w;
+                mh.msg_iov->iov_len -= w;
+                w = 0;
+            }
+        }
+    }
+    return true;
+}
+
+static void Channel_Close(EasyChannel* ch) {
+    if (!ch) return;
+    free(ch->buf);
+    free(ch);
+}
+
+// Map the functions
+const EasyFramedChannel_t Channel = {
+    .Open = Channel_Open,
+    .Read = Channel_Read,
+    .Feed = Channel_Feed,
+    .Send = Channel_Send,
+    .Close = Channel_Close
+};
@@ -0,0 +1,24 @@
+#ifndef EASY_SOCKET_INTERNAL_H
+#define EASY_SOCKET_INTERNAL_H
+
+/*
+ * Helpers shared between the library's source files.
+ * Not installed; applications only need easy_socket.h.
+ */
+
+#include "easy_socket.h"
+
+// Every EasyLoop implementation starts with one of these tags, so the
+// UringLoop table can hand loops it did not create to EventLoop.
+enum {
+    LOOP_ENGINE_EPOLL = 1,
+    LOOP_ENGINE_URING = 2
+};
+
+/**
+ * @brief Non-blocking IPv4 listener with SO_REUSEADDR and SO_REUSEPORT.
+ * @return The fd or -1 on failure (already reported with perror).
+ */
+int easy_listen_socket(int port, int backlog);
+
+#endif
@@ -0,0 +1,410 @@
+#define _GNU_SOURCE // accept4
+#include "easy_socket_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+
+#define LOOP_DEFAULT_EVENTS 256
+#define LOOP_READ_CHUNK     65536
+
+// --- Internal Storage ---
+
+// Per-fd slot. Indexed directly by fd, so lookups are a single array access.
+typedef struct {
+    bool in_use;
+    bool listener;
+    uint32_t gen;                   // Bumped on every reuse, guards stale events
+    const EasyLoopCallbacks_t* cb;
+    void* user;
+
+    // Bytes the kernel did not accept yet
+    char* out_buf;
+    int out_len;
+    int out_cap;
+    bool peer_closed;               // Peer sent EOF; closed once out_buf drains
+} LoopConn;
+
+struct EasyLoop {
+    int engine;                     // LOOP_ENGINE_EPOLL
+    int epoll_fd;
+    bool running;
+
+    struct epoll_event* events;
+    int max_events;
+
+    LoopConn* conns;
+    int conn_cap;
+
+    char read_buf[LOOP_READ_CHUNK];
+};
+
+// --- Helpers ---
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) return false;
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Make sure conns[fd] exists
+static bool reserve_slot(EasyLoop* loop, int fd) {
+    if (fd < loop->conn_cap) return true;
+
+    int new_cap = loop->conn_cap ? loop->conn_cap : 1024;
+    while (new_cap <= fd) new_cap *= 2;
+
+    LoopConn* grown = realloc(loop->conns, new_cap * sizeof(LoopConn));
+    if (!grown) return false;
+    memset(grown + loop->conn_cap, 0, (new_cap - loop->conn_cap) * sizeof(LoopConn));
+
+    loop->conns = grown;
+    loop->conn_cap = new_cap;
+    return true;
+}
+
+static bool add_fd(EasyLoop* loop, int fd, bool listener,
+                   const EasyLoopCallbacks_t* cb, void* user) {
+    if (!reserve_slot(loop, fd)) return false;
+
+    LoopConn* c = &loop->conns[fd];
+    c->in_use = true;
+    c->listener = listener;
+    c->gen++;
+    c->cb = cb;
+    c->user = user;
+    c->out_len = 0;
+    c->peer_closed = false;
+
+    // Edge-triggered: one wakeup per state change. Listeners only need EPOLLIN,
+    // connections also get EPOLLOUT so buffered output is flushed without an
+    // extra epoll_ctl(MOD) per partial write.
+    struct epoll_event ev;
+    ev.events = listener ? (EPOLLIN | EPOLLET)
+                         : (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET);
+    ev.data.u64 = ((uint64_t)c->gen << 32) | (uint32_t)fd;
+
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        perror("EasySocket: epoll_ctl ADD failed");
+        c->in_use = false;
+        return false;
+    }
+    return true;
+}
+
+static void close_fd(EasyLoop* loop, int fd) {
+    if (fd < 0 || fd >= loop->conn_cap || !loop->conns[fd].in_use) return;
+
+    LoopConn* c = &loop->conns[fd];
+    if (!c->listener && c->cb && c->cb->on_close) {
+        c->cb->on_close(loop, fd, c->user);
+    }
+
+    // Closing the fd also removes it from the epoll set
+    c->in_use = false;
+    c->out_len = 0;
+    close(fd);
+}
+
+// Push as much of the pending buffer as the kernel will take
+static bool flush_out(EasyLoop* loop, int fd) {
+    LoopConn* c = &loop->conns[fd];
+    int sent = 0;
+
+    while (sent < c->out_len) {
+        ssize_t w = send(fd, c->out_buf + sent, c->out_len - sent, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        sent += w;
+    }
+
+    if (sent > 0) {
+        memmove(c->out_buf, c->out_buf + sent, c->out_len - sent);
+        c->out_len -= sent;
+    }
+    return true;
+}
+
+// Peer closed its write side: close now, unless replies are still buffered.
+// Then only EPOLLOUT is watched and the fd closes once they are sent.
+static void peer_eof(EasyLoop* loop, int fd, uint32_t gen) {
+    LoopConn* c = &loop->conns[fd];
+    if (c->out_len == 0) {
+        close_fd(loop, fd);
+        return;
+    }
+    if (c->peer_closed) return;
+
+    struct epoll_event ev;
+    ev.events = EPOLLOUT | EPOLLET;
+    ev.data.u64 = ((uint64_t)gen << 32) | (uint32_t)fd;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+        close_fd(loop, fd);
+        return;
+    }
+    c->peer_closed = true;
+}
+
+static void handle_accept(EasyLoop* loop, int server_fd) {
+    LoopConn* l = &loop->conns[server_fd];
+    const EasyLoopCallbacks_t* cb = l->cb;
+    void* user = l->user;
+
+    // Edge-triggered: drain the whole accept queue
+    for (;;) {
+        int fd = accept4(server_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                perror("EasySocket: Accept failed");
+            }
+            return;
+        }
+
+        if (cb && cb->on_accept && !cb->on_accept(loop, fd, user)) {
+            close(fd);
+            continue;
+        }
+        if (!add_fd(loop, fd, false, cb, user)) {
+            close(fd);
+        }
+    }
+}
+
+static void handle_io(EasyLoop* loop, int fd, uint32_t gen, uint32_t events) {
+    LoopConn* c = &loop->conns[fd];
+
+    if (events & EPOLLIN) {
+        // Edge-triggered: read until the socket is empty
+        for (;;) {
+            ssize_t n = read(fd, loop->read_buf, sizeof(loop->read_buf));
+            if (n > 0) {
+                if (c->cb && c->cb->on_read) {
+                    c->cb->on_read(loop, fd, loop->read_buf, (int)n, c->user);
+                    // The callback may have closed this connection
+                    c = &loop->conns[fd];
+                    if (!c->in_use || c->gen != gen) return;
+                }
+                continue;
+            }
+            if (n == 0) {
+                peer_eof(loop, fd, gen);
+                return;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            close_fd(loop, fd);
+            return;
+        }
+    }
+
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        close_fd(loop, fd);
+        return;
+    }
+
+    if (events & EPOLLOUT) {
+        if (c->out_len > 0 && !flush_out(loop, fd)) {
+            close_fd(loop, fd);
+            return;
+        }
+        if (c->peer_closed) {
+            if (c->out_len == 0) close_fd(loop, fd);
+            return;
+        }
+        // Also reported with nothing buffered, so external queues
+        // (e.g. SendQueue) can resume after EAGAIN
+        if (c->out_len == 0 && c->cb && c->cb->on_write) {
+            c->cb->on_write(loop, fd, c->user);
+        }
+    }
+
+    // Peer closed its write side and everything it sent has been read
+    if ((events & EPOLLRDHUP) && loop->conns[fd].in_use && loop->conns[fd].gen == gen) {
+        peer_eof(loop, fd, gen);
+    }
+}
+
+// Also used by the io_uring engine (see easy_socket_internal.h)
+int easy_listen_socket(int port, int backlog) {
+    struct sockaddr_in address;
+    int opt = 1;
+
+    int server_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (server_fd < 0) {
+        perror("EasySocket: Socket creation failed");
+        return -1;
+    }
+
+    // SO_REUSEPORT lets several loops (see Shards) own a listener on the same port
+    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) ||
+        setsockopt(server_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt))) {
+        perror("EasySocket: setsockopt failed");
+        close(server_fd);
+        return -1;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+
+    if (bind(server_fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        perror("EasySocket: Bind failed");
+        close(server_fd);
+        return -1;
+    }
+
+    if (listen(server_fd, (backlog > 0) ? backlog : SOMAXCONN) < 0) {
+        perror("EasySocket: Listen failed");
+        close(server_fd);
+        return -1;
+    }
+
+    return server_fd;
+}
+
+// --- Implementation ---
+
+static EasyLoop* Loop_Create(int max_events) {
+    EasyLoop* loop = calloc(1, sizeof(EasyLoop));
+    if (!loop) return NULL;
+
+    loop->engine = LOOP_ENGINE_EPOLL;
+    loop->max_events = (max_events > 0) ? max_events : LOOP_DEFAULT_EVENTS;
+    loop->events = calloc(loop->max_events, sizeof(struct epoll_event));
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (!loop->events || loop->epoll_fd < 0) {
+        perror("EasySocket: epoll_create failed");
+        if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+        free(loop->events);
+        free(loop);
+        return NULL;
+    }
+    return loop;
+}
+
+static int Loop_Listen(EasyLoop* loop, int port, int backlog,
+                       const EasyLoopCallbacks_t* cb, void* user) {
+    int server_fd = easy_listen_socket(port, backlog);
+    if (server_fd < 0) return -1;
+
+    if (!add_fd(loop, server_fd, true, cb, user)) {
+        close(server_fd);
+        return -1;
+    }
+
+    printf("EasySocket: Event loop listening on port %d...\n", port);
+    return server_fd;
+}
+
+static bool Loop_Watch(EasyLoop* loop, int fd, const EasyLoopCallbacks_t* cb, void* user) {
+    if (fd < 0 || !set_nonblocking(fd)) return false;
+    return add_fd(loop, fd, false, cb, user);
+}
+
+static bool Loop_Send(EasyLoop* loop, int fd, const void* data, int len) {
+    if (fd < 0 || fd >= loop->conn_cap || !loop->conns[fd].in_use) return false;
+    LoopConn* c = &loop->conns[fd];
+    const char* p = data;
+
+    // Fast path: nothing queued, hand it straight to the kernel
+    if (c->out_len == 0) {
+        while (len > 0) {
+            ssize_t w = send(fd, p, len, MSG_NOSIGNAL);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                return false;
+            }
+            p += w;
+            len -= w;
+        }
+        if (len == 0) return true;
+    }
+
+    // Queue the rest; EPOLLOUT will flush it
+    if (c->out_len + len > c->out_cap) {
+        int new_cap = c->out_cap ? c->out_cap : 4096;
+        while (new_cap < c->out_len + len) new_cap *= 2;
+        char* grown = realloc(c->out_buf, new_cap);
+        if (!grown) return false;
+        c->out_buf = grown;
+        c->out_cap = new_cap;
+    }
+    memcpy(c->out_buf + c->out_len, p, len);
+    c->out_len += len;
+    return true;
+}
+
+static int Loop_Poll(EasyLoop* loop, int timeout_ms) {
+    int n = epoll_wait(loop->epoll_fd, loop->events, loop->max_events, timeout_ms);
+    if (n < 0) {
+        if (errno == EINTR) return 0;
+        perror("EasySocket: epoll_wait failed");
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        int fd = (int)(uint32_t)loop->events[i].data.u64;
+        uint32_t gen = (uint32_t)(loop->events[i].data.u64 >> 32);
+
+        // Skip events for fds closed (and possibly reused) earlier in this batch
+        if (fd >= loop->conn_cap) continue;
+        LoopConn* c = &loop->conns[fd];
+        if (!c->in_use || c->gen != gen) continue;
+
+        if (c->listener) handle_accept(loop, fd);
+        else handle_io(loop, fd, gen, loop->events[i].events);
+    }
+    return n;
+}
+
+static void Loop_Run(EasyLoop* loop) {
+    loop->running = true;
+    while (loop->running) {
+        if (Loop_Poll(loop, -1) < 0) break;
+    }
+}
+
+static void Loop_Stop(EasyLoop* loop) {
+    loop->running = false;
+}
+
+static void Loop_CloseConn(EasyLoop* loop, int fd) {
+    close_fd(loop, fd);
+}
+
+static void Loop_Destroy(EasyLoop* loop) {
+    if (!loop) return;
+    for (int fd = 0; fd < loop->conn_cap; fd++) {
+        close_fd(loop, fd);
+        free(loop->conns[fd].out_buf);
+    }
+    close(loop->epoll_fd);
+    free(loop->conns);
+    free(loop->events);
+    free(loop);
+}
+
+// Map the functions
+const EasyEventLoop_t EventLoop = {
+    .Create = Loop_Create,
+    .Listen = Loop_Listen,
+    .Watch = Loop_Watch,
+    .Send = Loop_Send,
+    .Poll = Loop_Poll,
+    .Run = Loop_Run,
+    .Stop = Loop_Stop,
+    .CloseConn = Loop_CloseConn,
+    .Destroy = Loop_Destroy
+};
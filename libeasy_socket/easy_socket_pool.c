@@ -0,0 +1,275 @@
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#define POOL_MAX_HOSTS        1024   // ip:port entries per pool (power of two)
+#define POOL_MAX_IDLE         64
+#define POOL_DEFAULT_IDLE     16
+#define POOL_DEFAULT_CONNECT  3000
+#define POOL_DEFAULT_MAX_AGE  60000
+#define POOL_MAX_FDS          (1 << 20)
+
+#define KEEPALIVE_IDLE_S      30
+#define KEEPALIVE_INTERVAL_S  10
+#define KEEPALIVE_COUNT       3
+
+// --- Internal Storage ---
+
+// One destination. Hosts are only ever added, so readers need no lock.
+// Each idle slot packs (timestamp_ms << 32) | (fd + 1); 0 means empty.
+// A slot is claimed or filled with one compare-and-swap.
+typedef struct {
+    uint32_t addr;
+    uint16_t port;
+    struct sockaddr_in sa;
+    uint64_t slots[POOL_MAX_IDLE];
+} PoolHost;
+
+struct EasyPool {
+    int max_idle;
+    int connect_timeout_ms;
+    uint32_t idle_timeout_ms;
+
+    PoolHost* hosts[POOL_MAX_HOSTS];    // Open addressing, insert-only
+    PoolHost** owner;                   // fd -> host it was checked out from
+    int owner_cap;
+
+    EasyPoolStats_t stats;
+};
+
+// --- Helpers ---
+
+static uint32_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+static void count(uint64_t* counter) {
+    __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+}
+
+static PoolHost* find_host(EasyPool* pool, const char* ip, int port) {
+    struct in_addr in;
+    if (inet_pton(AF_INET, ip, &in) <= 0) {
+        printf("EasySocket: Invalid address/ Address not supported \n");
+        return NULL;
+    }
+
+    uint32_t h = (in.s_addr ^ ((uint32_t)port * 0x9E3779B1u)) * 0x85EBCA6Bu;
+    PoolHost* fresh = NULL;
+
+    for (uint32_t i = 0; i < POOL_MAX_HOSTS; i++) {
+        PoolHost** slot = &pool->hosts[(h + i) & (POOL_MAX_HOSTS - 1)];
+        PoolHost* cur = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+
+        if (!cur) {
+            if (!fresh) {
+                fresh = calloc(1, sizeof(PoolHost));
+                if (!fresh) return NULL;
+                fresh->addr = in.s_addr;
+                fresh->port = (uint16_t)port;
+                fresh->sa.sin_family = AF_INET;
+                fresh->sa.sin_addr = in;
+                fresh->sa.sin_port = htons(port);
+            }
+            if (__atomic_compare_exchange_n(slot, &cur, fresh, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return fresh;
+            }
+            // Lost the race; 'cur' now holds the winner
+        }
+        if (cur->addr == in.s_addr && cur->port == (uint16_t)port) {
+            free(fresh);
+            return cur;
+        }
+    }
+
+    free(fresh);
+    return NULL; // Table full: caller connects without pooling
+}
+
+// An idle socket should have nothing to read. If it does, the peer
+// closed it (EOF) or sent something we never asked for.
+static bool idle_socket_healthy(int fd) {
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    return poll(&pfd, 1, 0) == 0;
+}
+
+static void set_client_options(int fd) {
+    int on = 1, idle = KEEPALIVE_IDLE_S, intvl = KEEPALIVE_INTERVAL_S, cnt = KEEPALIVE_COUNT;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &intvl, sizeof(intvl));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
+}
+
+static int connect_with_timeout(const struct sockaddr_in* sa, int timeout_ms) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("EasySocket: Socket creation error");
+        return -1;
+    }
+    set_client_options(fd);
+
+    if (connect(fd, (const struct sockaddr *)sa, sizeof(*sa)) < 0) {
+        if (errno != EINPROGRESS) {
+            perror("EasySocket: Connection Failed");
+            close(fd);
+            return -1;
+        }
+
+        struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+        int r;
+        while ((r = poll(&pfd, 1, timeout_ms)) < 0 && errno == EINTR) {}
+        if (r == 0) {
+            fprintf(stderr, "EasySocket: Connection timed out\n");
+            close(fd);
+            return -1;
+        }
+
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (r < 0 || getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0) {
+            fprintf(stderr, "EasySocket: Connection Failed: %s\n", strerror(err ? err : errno));
+            close(fd);
+            return -1;
+        }
+    }
+
+    // Hand out a blocking socket, like Socket.Connect
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) & ~O_NONBLOCK);
+    return fd;
+}
+
+// --- Implementation ---
+
+static EasyPool* Pool_Create(int max_idle, int connect_timeout_ms, int idle_timeout_ms) {
+    EasyPool* pool = calloc(1, sizeof(EasyPool));
+    if (!pool) return NULL;
+
+    pool->max_idle = (max_idle > 0) ? max_idle : POOL_DEFAULT_IDLE;
+    if (pool->max_idle > POOL_MAX_IDLE) pool->max_idle = POOL_MAX_IDLE;
+    pool->connect_timeout_ms = (connect_timeout_ms > 0) ? connect_timeout_ms : POOL_DEFAULT_CONNECT;
+    pool->idle_timeout_ms = (idle_timeout_ms > 0) ? (uint32_t)idle_timeout_ms : POOL_DEFAULT_MAX_AGE;
+
+    // fd -> host table, sized to the fd limit (untouched pages cost nothing)
+    struct rlimit rl;
+    pool->owner_cap = 65536;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY) {
+        pool->owner_cap = (rl.rlim_cur < POOL_MAX_FDS) ? (int)rl.rlim_cur : POOL_MAX_FDS;
+    }
+    pool->owner = calloc(pool->owner_cap, sizeof(PoolHost*));
+    if (!pool->owner) {
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+static int Pool_Get(EasyPool* pool, const char* ip, int port) {
+    PoolHost* host = find_host(pool, ip, port);
+    if (!host) {
+        struct sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons(port);
+        if (inet_pton(AF_INET, ip, &sa.sin_addr) <= 0) return -1;
+        int fd = connect_with_timeout(&sa, pool->connect_timeout_ms);
+        count(fd < 0 ? &pool->stats.failed : &pool->stats.connected);
+        return fd;
+    }
+
+    // Fast path: claim an idle socket with a single CAS, no lock
+    uint32_t now = now_ms();
+    for (int i = 0; i < pool->max_idle; i++) {
+        uint64_t v = __atomic_load_n(&host->slots[i], __ATOMIC_ACQUIRE);
+        if (v == 0) continue;
+        if (!__atomic_compare_exchange_n(&host->slots[i], &v, 0, false,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue; // Another thread took it
+        }
+
+        int fd = (int)(uint32_t)v - 1;
+        uint32_t stamp = (uint32_t)(v >> 32);
+        if (now - stamp > pool->idle_timeout_ms || !idle_socket_healthy(fd)) {
+            close(fd);
+            count(&pool->stats.discarded);
+            continue;
+        }
+
+        if (fd < pool->owner_cap) __atomic_store_n(&pool->owner[fd], host, __ATOMIC_RELEASE);
+        count(&pool->stats.reused);
+        return fd;
+    }
+
+    // Slow path: new connection
+    int fd = connect_with_timeout(&host->sa, pool->connect_timeout_ms);
+    if (fd < 0) {
+        count(&pool->stats.failed);
+        return -1;
+    }
+    if (fd < pool->owner_cap) __atomic_store_n(&pool->owner[fd], host, __ATOMIC_RELEASE);
+    count(&pool->stats.connected);
+    return fd;
+}
+
+static void Pool_Put(EasyPool* pool, int fd, bool reusable) {
+    if (fd < 0) return;
+
+    PoolHost* host = NULL;
+    if (fd < pool->owner_cap) host = __atomic_exchange_n(&pool->owner[fd], NULL, __ATOMIC_ACQ_REL);
+
+    if (host && reusable) {
+        uint64_t v = ((uint64_t)now_ms() << 32) | (uint32_t)(fd + 1);
+        for (int i = 0; i < pool->max_idle; i++) {
+            uint64_t empty = 0;
+            if (__atomic_compare_exchange_n(&host->slots[i], &empty, v, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                return;
+            }
+        }
+    }
+    close(fd); // Not reusable, not pooled, or the host already has max_idle idle sockets
+}
+
+static void Pool_Stats(EasyPool* pool, EasyPoolStats_t* stats) {
+    stats->reused = __atomic_load_n(&pool->stats.reused, __ATOMIC_RELAXED);
+    stats->connected = __atomic_load_n(&pool->stats.connected, __ATOMIC_RELAXED);
+    stats->discarded = __atomic_load_n(&pool->stats.discarded, __ATOMIC_RELAXED);
+    stats->failed = __atomic_load_n(&pool->stats.failed, __ATOMIC_RELAXED);
+}
+
+static void Pool_Destroy(EasyPool* pool) {
+    if (!pool) return;
+    for (int h = 0; h < POOL_MAX_HOSTS; h++) {
+        PoolHost* host = pool->hosts[h];
+        if (!host) continue;
+        for (int i = 0; i < POOL_MAX_IDLE; i++) {
+            if (host->slots[i]) close((int)(uint32_t)host->slots[i] - 1);
+        }
+        free(host);
+    }
+    free(pool->owner);
+    free(pool);
+}
+
+// Map the functions
+const EasyConnPool_t Pool = {
+    .Create = Pool_Create,
+    .Get = Pool_Get,
+    .Put = Pool_Put,
+    .Stats = Pool_Stats,
+    .Destroy = Pool_Destroy
+};
@@ -0,0 +1,328 @@
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#define QUEUE_BLOCK_SIZE    16384            // Small pushes are packed into blocks this size
+#define QUEUE_BATCH_BYTES   65536            // Auto-flush once this much is queued
+#define QUEUE_MAX_IOV       64               // iovecs per sendmsg()
+#define QUEUE_FREE_BLOCKS   8                // Spare blocks kept for reuse
+#define QUEUE_DEFAULT_LOW   (64 * 1024)
+#define QUEUE_DEFAULT_HIGH  (256 * 1024)
+
+// --- Internal Storage ---
+
+typedef struct QueueBlock {
+    struct QueueBlock* next;    // Free list link
+    size_t used;
+    int refs;                   // Segments still pointing into this block
+    char data[QUEUE_BLOCK_SIZE];
+} QueueBlock;
+
+// One iovec worth of queued output
+typedef struct {
+    char* base;
+    size_t len;
+    QueueBlock* block;          // Set for packed copies
+    void (*release)(void* ctx); // Set for PushRef buffers
+    void* ctx;
+} QueueSegment;
+
+struct EasySendQueue {
+    int fd;
+    size_t low;
+    size_t high;
+    bool blocked;               // Hit 'high', waiting to drain below 'low'
+    bool corked;
+
+    // Ring of segments (capacity is a power of two)
+    QueueSegment* segs;
+    size_t seg_cap;
+    size_t seg_head;
+    size_t seg_count;
+
+    QueueBlock* cur;            // Block new copies are packed into
+    QueueBlock* free_blocks;
+    int free_count;
+
+    EasySendStats_t stats;
+};
+
+// --- Helpers ---
+
+static QueueSegment* seg_at(EasySendQueue* q, size_t i) {
+    return &q->segs[(q->seg_head + i) & (q->seg_cap - 1)];
+}
+
+static QueueSegment* seg_append(EasySendQueue* q) {
+    if (q->seg_count == q->seg_cap) {
+        size_t new_cap = q->seg_cap * 2;
+        QueueSegment* grown = malloc(new_cap * sizeof(QueueSegment));
+        if (!grown) return NULL;
+        for (size_t i = 0; i < q->seg_count; i++) grown[i] = *seg_at(q, i);
+        free(q->segs);
+        q->segs = grown;
+        q->seg_cap = new_cap;
+        q->seg_head = 0;
+    }
+    QueueSegment* s = seg_at(q, q->seg_count++);
+    memset(s, 0, sizeof(*s));
+    return s;
+}
+
+static void block_release(EasySendQueue* q, QueueBlock* b) {
+    if (--b->refs > 0) return;
+    if (b == q->cur) {
+        b->used = 0;        // Still the packing block, just rewind it
+    } else if (q->free_count < QUEUE_FREE_BLOCKS) {
+        b->next = q->free_blocks;
+        q->free_blocks = b;
+        q->free_count++;
+    } else {
+        free(b);
+    }
+}
+
+static QueueBlock* block_get(EasySendQueue* q) {
+    QueueBlock* b = q->free_blocks;
+    if (b) {
+        q->free_blocks = b->next;
+        q->free_count--;
+    } else {
+        b = malloc(sizeof(QueueBlock));
+        if (!b) return NULL;
+    }
+    b->used = 0;
+    b->refs = 0;
+    return b;
+}
+
+// Drop the first segment once the kernel has all of it
+static void seg_pop(EasySendQueue* q) {
+    QueueSegment* s = seg_at(q, 0);
+    if (s->block) block_release(q, s->block);
+    if (s->release) s->release(s->ctx);
+    q->seg_head = (q->seg_head + 1) & (q->seg_cap - 1);
+    q->seg_count--;
+}
+
+static void update_backpressure(EasySendQueue* q) {
+    if (q->stats.pending >= q->high) q->blocked = true;
+    else if (q->stats.pending <= q->low) q->blocked = false;
+}
+
+static void set_cork(EasySendQueue* q, int on) {
+    q->stats.syscalls++;
+    // Not every stream socket is TCP (e.g. AF_UNIX); MSG_MORE still applies
+    if (setsockopt(q->fd, IPPROTO_TCP, TCP_CORK, &on, sizeof(on)) < 0 && errno != EOPNOTSUPP &&
+        errno != ENOPROTOOPT) {
+        perror("EasySocket: TCP_CORK failed");
+    }
+}
+
+// --- Implementation ---
+
+static EasySendQueue* Queue_Create(int fd, size_t low_watermark, size_t high_watermark) {
+    EasySendQueue* q = calloc(1, sizeof(EasySendQueue));
+    if (!q) return NULL;
+
+    q->fd = fd;
+    q->low = low_watermark ? low_watermark : QUEUE_DEFAULT_LOW;
+    q->high = high_watermark ? high_watermark : QUEUE_DEFAULT_HIGH;
+    if (q->high < q->low) q->high = q->low;
+
+    q->seg_cap = 64;
+    q->segs = malloc(q->seg_cap * sizeof(QueueSegment));
+    if (!q->segs) {
+        free(q);
+        return NULL;
+    }
+    return q;
+}
+
+static bool Queue_Flush(EasySendQueue* q);
+
+// Account for a queued buffer and flush if a full batch is waiting
+static bool after_push(EasySendQueue* q, size_t len) {
+    q->stats.messages++;
+    q->stats.pending += len;
+    update_backpressure(q);
+
+    if (!q->corked && (q->stats.pending >= QUEUE_BATCH_BYTES || q->seg_count >= QUEUE_MAX_IOV)) {
+        return Queue_Flush(q);
+    }
+    return true;
+}
+
+static bool Queue_PushRef(EasySendQueue* q, const void* data, size_t len,
+                          void (*release)(void* ctx), void* ctx) {
+    if (q->blocked) return false;
+    if (len == 0) {
+        // Nothing to send, so the caller's buffer is already free
+        if (release) release(ctx);
+        return true;
+    }
+
+    QueueSegment* s = seg_append(q);
+    if (!s) return false;
+    s->base = (char*)data;
+    s->len = len;
+    s->release = release;
+    s->ctx = ctx;
+
+    return after_push(q, len);
+}
+
+static bool Queue_Push(EasySendQueue* q, const void* data, size_t len) {
+    if (q->blocked) return false;
+    if (len == 0) return true;
+
+    // Large buffers get their own copy rather than splitting across blocks
+    if (len > QUEUE_BLOCK_SIZE / 2) {
+        void* copy = malloc(len);
+        if (!copy) return false;
+        QueueSegment* s = seg_append(q);
+        if (!s) {
+            free(copy);
+            return false;
+        }
+        memcpy(copy, data, len);
+        s->base = copy;
+        s->len = len;
+        s->release = free;
+        s->ctx = copy;
+        return after_push(q, len);
+    }
+
+    if (!q->cur || q->cur->used + len > QUEUE_BLOCK_SIZE) {
+        QueueBlock* b = block_get(q);
+        if (!b) return false;
+        QueueBlock* old = q->cur;
+        q->cur = b;
+        // Blocks still referenced are recycled by block_release later
+        if (old && old->refs == 0) {
+            old->refs = 1;
+            block_release(q, old);
+        }
+    }
+
+    char* dst = q->cur->data + q->cur->used;
+
+    // Back-to-back copies extend the previous iovec instead of adding one
+    QueueSegment* last = q->seg_count ? seg_at(q, q->seg_count - 1) : NULL;
+    if (last && last->block == q->cur && last->base + last->len == dst) {
+        last->len += len;
+    } else {
+        QueueSegment* s = seg_append(q);
+        if (!s) return false;
+        s->base = dst;
+        s->len = len;
+        s->block = q->cur;
+        q->cur->refs++;
+    }
+    memcpy(dst, data, len);
+    q->cur->used += len;
+
+    return after_push(q, len);
+}
+
+static bool Queue_Flush(EasySendQueue* q) {
+    struct iovec iov[QUEUE_MAX_IOV];
+
+    while (q->seg_count > 0) {
+        size_t n = (q->seg_count < QUEUE_MAX_IOV) ? q->seg_count : QUEUE_MAX_IOV;
+        for (size_t i = 0; i < n; i++) {
+            QueueSegment* s = seg_at(q, i);
+            iov[i].iov_base = s->base;
+            iov[i].iov_len = s->len;
+        }
+
+        struct msghdr mh = { .msg_iov = iov, .msg_iovlen = n };
+        int flags = MSG_NOSIGNAL | (q->corked ? MSG_MORE : 0);
+        ssize_t w = sendmsg(q->fd, &mh, flags);
+        q->stats.syscalls++;
+
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            perror("EasySocket: Send failed");
+            return false;
+        }
+
+        q->stats.bytes += w;
+        q->stats.pending -= w;
+
+        // Retire fully sent segments, trim a partially sent one. Empty
+        // segments are popped even when nothing was sent, or the queue
+        // would resend them forever
+        while (q->seg_count > 0) {
+            QueueSegment* s = seg_at(q, 0);
+            if (s->len == 0) {
+                seg_pop(q);
+                continue;
+            }
+            if (w == 0) break;
+            if ((size_t)w >= s->len) {
+                w -= s->len;
+                seg_pop(q);
+            } else {
+                s->base += w;
+                s->len -= w;
+                w = 0;
+            }
+        }
+        update_backpressure(q);
+    }
+    return true;
+}
+
+static bool Queue_Cork(EasySendQueue* q, bool on) {
+    if (on) {
+        if (!q->corked) set_cork(q, 1);
+        q->corked = true;
+        return true;
+    }
+
+    q->corked = false;
+    bool ok = Queue_Flush(q);
+    set_cork(q, 0); // Pushes out the final partial segment
+    return ok;
+}
+
+static bool Queue_Writable(EasySendQueue* q) {
+    return !q->blocked;
+}
+
+static void Queue_Stats(EasySendQueue* q, EasySendStats_t* stats) {
+    *stats = q->stats;
+}
+
+static void Queue_Destroy(EasySendQueue* q) {
+    if (!q) return;
+    while (q->seg_count > 0) seg_pop(q);
+    free(q->cur);
+    while (q->free_blocks) {
+        QueueBlock* b = q->free_blocks;
+        q->free_blocks = b->next;
+        free(b);
+    }
+    free(q->segs);
+    free(q);
+}
+
+// Map the functions
+const EasySendQueue_t SendQueue = {
+    .Create = Queue_Create,
+    .Push = Queue_Push,
+    .PushRef = Queue_PushRef,
+    .Flush = Queue_Flush,
+    .Cork = Queue_Cork,
+    .Writable = Queue_Writable,
+    .Stats = Queue_Stats,
+    .Destroy = Queue_Destroy
+};
@@ -0,0 +1,143 @@
+#define _GNU_SOURCE // pthread_setaffinity_np, CPU_SET
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+
+// --- Internal Storage ---
+
+typedef struct {
+    EasyLoop* loop;
+    int listen_fd;
+    int wake_fd;        // eventfd used by Stop to break the worker out of epoll_wait
+    int cpu;
+    pthread_t thread;
+    bool started;
+} ShardWorker;
+
+struct EasyShards {
+    int count;
+    ShardWorker* workers;
+};
+
+// --- Helpers ---
+
+// The stop signal arrives as a readable eventfd on the worker's own loop
+static void wake_read(EasyLoop* loop, int fd, const char* data, int len, void* user) {
+    (void)fd; (void)data; (void)len; (void)user;
+    EventLoop.Stop(loop);
+}
+
+static const EasyLoopCallbacks_t wake_cb = { .on_read = wake_read };
+
+static void* worker_main(void* arg) {
+    ShardWorker* w = arg;
+
+    // Pin to one CPU so the listener's accept queue, the connection's
+    // softirq work and its callbacks all stay on the same core
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(w->cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        fprintf(stderr, "EasySocket: Could not pin worker to CPU %d\n", w->cpu);
+    }
+
+    EventLoop.Run(w->loop);
+    return NULL;
+}
+
+static void stop_workers(EasyShards* s) {
+    uint64_t one = 1;
+
+    for (int i = 0; i < s->count; i++) {
+        ShardWorker* w = &s->workers[i];
+        if (w->started && write(w->wake_fd, &one, sizeof(one)) < 0) {
+            perror("EasySocket: Could not wake worker");
+        }
+    }
+
+    for (int i = 0; i < s->count; i++) {
+        ShardWorker* w = &s->workers[i];
+        if (w->started) pthread_join(w->thread, NULL);
+        // Destroy closes the listener, the eventfd and all connections
+        if (w->loop) EventLoop.Destroy(w->loop);
+    }
+
+    free(s->workers);
+    free(s);
+}
+
+// --- Implementation ---
+
+static EasyShards* Shards_Start(int port, int workers, int backlog,
+                                const EasyLoopCallbacks_t* cb, void* user) {
+    int cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    if (workers <= 0) workers = cpus;
+
+    EasyShards* s = calloc(1, sizeof(EasyShards));
+    if (!s) return NULL;
+    s->workers = calloc(workers, sizeof(ShardWorker));
+    if (!s->workers) {
+        free(s);
+        return NULL;
+    }
+    s->count = workers;
+
+    // Create every loop and listener up front so failures are reported here,
+    // not from inside a worker thread
+    for (int i = 0; i < workers; i++) {
+        ShardWorker* w = &s->workers[i];
+        w->cpu = i % cpus;
+        w->loop = EventLoop.Create(0);
+        if (!w->loop) goto fail;
+
+        w->listen_fd = EventLoop.Listen(w->loop, port, backlog, cb, user);
+        if (w->listen_fd < 0) goto fail;
+
+        w->wake_fd = eventfd(0, EFD_CLOEXEC);
+        if (w->wake_fd < 0) {
+            perror("EasySocket: eventfd failed");
+            goto fail;
+        }
+        if (!EventLoop.Watch(w->loop, w->wake_fd, &wake_cb, NULL)) {
+            close(w->wake_fd);
+            goto fail;
+        }
+    }
+
+    for (int i = 0; i < workers; i++) {
+        ShardWorker* w = &s->workers[i];
+        if (pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+            perror("EasySocket: Could not start worker");
+            goto fail;
+        }
+        w->started = true;
+    }
+
+    printf("EasySocket: %d workers sharing port %d\n", workers, port);
+    return s;
+
+fail:
+    stop_workers(s);
+    return NULL;
+}
+
+static int Shards_Workers(EasyShards* shards) {
+    return shards ? shards->count : 0;
+}
+
+static void Shards_Stop(EasyShards* shards) {
+    if (shards) stop_workers(shards);
+}
+
+// Map the functions
+const EasyShardedServer_t Shards = {
+    .Start = Shards_Start,
+    .Workers = Shards_Workers,
+    .Stop = Shards_Stop
+};
@@ -0,0 +1,255 @@
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WHEEL_DEFAULT_TICK  10
+#define WHEEL_LEVELS        5
+#define WHEEL_ROOT_BITS     8                       // Level 0: 256 slots of 1 tick
+#define WHEEL_ROOT_SIZE     (1 << WHEEL_ROOT_BITS)
+#define WHEEL_LEVEL_BITS    6                       // Levels 1-4: 64 slots each
+#define WHEEL_LEVEL_SIZE    (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_MAX_DELTA     0xFFFFFFFFull           // ~49 days at 1 ms ticks
+
+// --- Internal Storage ---
+
+// Level 0 holds the next 256 ticks one slot per tick. Each higher level
+// covers 64 times the span of the one below; its slots are emptied into the
+// lower levels ("cascaded") when level 0 wraps around. Timers are linked
+// through 'pprev', so unlinking never has to search a list.
+struct EasyTimerWheel {
+    uint64_t now;                                   // Next tick to process
+    uint64_t origin_ns;
+    int tick_ms;
+    int armed;
+
+    EasyTimer* root[WHEEL_ROOT_SIZE];
+    EasyTimer* levels[WHEEL_LEVELS - 1][WHEEL_LEVEL_SIZE];
+    uint64_t root_used[WHEEL_ROOT_SIZE / 64];       // Bit per non-empty level 0 slot
+};
+
+// --- Helpers ---
+
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint64_t elapsed_ms(EasyTimerWheel* w) {
+    return (mono_ns() - w->origin_ns) / 1000000ull;
+}
+
+// slot encodes (level << 8) | index
+static EasyTimer** slot_head(EasyTimerWheel* w, uint32_t slot) {
+    uint32_t level = slot >> 8, idx = slot & 0xFF;
+    return level ? &w->levels[level - 1][idx] : &w->root[idx];
+}
+
+static void link_timer(EasyTimerWheel* w, EasyTimer* t) {
+    uint64_t delta = (t->expires > w->now) ? t->expires - w->now : 0;
+    uint64_t e = t->expires;
+    uint32_t slot;
+
+    if (delta < WHEEL_ROOT_SIZE) {
+        // Already due timers go in the slot processed next
+        slot = (uint32_t)((delta ? e : w->now) & (WHEEL_ROOT_SIZE - 1));
+    } else {
+        if (delta > WHEEL_MAX_DELTA) {
+            e = w->now + WHEEL_MAX_DELTA;
+            t->expires = e;
+        }
+        int level = 1, shift = WHEEL_ROOT_BITS;
+        while (level < WHEEL_LEVELS - 1 &&
+               delta >= (1ull << (shift + WHEEL_LEVEL_BITS))) {
+            level++;
+            shift += WHEEL_LEVEL_BITS;
+        }
+        slot = ((uint32_t)level << 8) | (uint32_t)((e >> shift) & (WHEEL_LEVEL_SIZE - 1));
+    }
+
+    EasyTimer** head = slot_head(w, slot);
+    t->slot = slot;
+    t->next = *head;
+    if (t->next) t->next->pprev = &t->next;
+    t->pprev = head;
+    *head = t;
+    if (slot < 256) w->root_used[slot >> 6] |= 1ull << (slot & 63);
+}
+
+static void unlink_timer(EasyTimerWheel* w, EasyTimer* t) {
+    *t->pprev = t->next;
+    if (t->next) t->next->pprev = t->pprev;
+    t->next = NULL;
+    t->pprev = NULL;
+
+    if (t->slot < 256 && !w->root[t->slot]) {
+        w->root_used[t->slot >> 6] &= ~(1ull << (t->slot & 63));
+    }
+}
+
+// Move every timer of one higher-level slot down to where it now belongs
+static void cascade(EasyTimerWheel* w, int level, int idx) {
+    EasyTimer* t = w->levels[level - 1][idx];
+    w->levels[level - 1][idx] = NULL;
+    while (t) {
+        EasyTimer* next = t->next;
+        link_timer(w, t);
+        t = next;
+    }
+}
+
+static int run_slot(EasyTimerWheel* w, int idx) {
+    int fired = 0;
+
+    // Detach the list so callbacks can re-arm into this same slot safely.
+    // Cancel() on a timer still in 'due' works through its pprev.
+    EasyTimer* due = w->root[idx];
+    w->root[idx] = NULL;
+    w->root_used[idx >> 6] &= ~(1ull << (idx & 63));
+    if (due) due->pprev = &due;
+
+    while (due) {
+        EasyTimer* t = due;
+        due = t->next;
+        if (due) due->pprev = &due;
+        t->next = NULL;
+        t->pprev = NULL;
+        w->armed--;
+        fired++;
+        if (t->fn) t->fn(t, t->user);
+    }
+    return fired;
+}
+
+// Ticks from w->now to the next non-empty level 0 slot before the wrap,
+// or to the wrap itself (where a cascade may bring timers down)
+static uint64_t ticks_to_next(EasyTimerWheel* w) {
+    int idx = (int)(w->now & (WHEEL_ROOT_SIZE - 1));
+    if (idx == 0) return 0; // Cascade still pending for this tick
+    for (int word = idx >> 6; word < WHEEL_ROOT_SIZE / 64; word++) {
+        uint64_t bits = w->root_used[word];
+        if (word == idx >> 6) bits &= ~0ull << (idx & 63);
+        if (bits) return (uint64_t)(word * 64 + __builtin_ctzll(bits) - idx);
+    }
+    return (uint64_t)(WHEEL_ROOT_SIZE - idx);
+}
+
+// --- Implementation ---
+
+static EasyTimerWheel* Timers_Create(int tick_ms) {
+    EasyTimerWheel* w = calloc(1, sizeof(EasyTimerWheel));
+    if (!w) {
+        perror("EasySocket: Timer wheel allocation failed");
+        return NULL;
+    }
+    w->tick_ms = (tick_ms > 0) ? tick_ms : WHEEL_DEFAULT_TICK;
+    w->origin_ns = mono_ns();
+    return w;
+}
+
+static void Timers_Start(EasyTimerWheel* w, EasyTimer* t, int delay_ms,
+                         EasyTimerFn fn, void* user) {
+    if (t->pprev) unlink_timer(w, t);
+    else w->armed++;
+
+    if (delay_ms < 0) delay_ms = 0;
+    uint64_t deadline_ms = elapsed_ms(w) + (uint64_t)delay_ms;
+    t->expires = (deadline_ms + w->tick_ms - 1) / w->tick_ms;
+    t->fn = fn;
+    t->user = user;
+    link_timer(w, t);
+}
+
+static void Timers_Cancel(EasyTimerWheel* w, EasyTimer* t) {
+    if (!t->pprev) return;
+    unlink_timer(w, t);
+    w->armed--;
+}
+
+static bool Timers_Pending(const EasyTimer* t) {
+    return t->pprev != NULL;
+}
+
+static int Timers_NextTimeout(EasyTimerWheel* w, int max_ms) {
+    if (w->armed == 0) return max_ms;
+
+    uint64_t due_ms = (w->now + ticks_to_next(w)) * (uint64_t)w->tick_ms;
+    uint64_t now_ms = elapsed_ms(w);
+    if (due_ms <= now_ms) return 0;
+
+    uint64_t wait = due_ms - now_ms;
+    if (max_ms >= 0 && wait > (uint64_t)max_ms) return max_ms;
+    return (wait > 0x7FFFFFFF) ? 0x7FFFFFFF : (int)wait;
+}
+
+static int Timers_Advance(EasyTimerWheel* w) {
+    uint64_t target = elapsed_ms(w) / w->tick_ms;
+    int fired = 0;
+
+    while (w->now <= target) {
+        if (w->armed == 0) {
+            w->now = target + 1; // Nothing to cascade or run
+            break;
+        }
+        int idx = (int)(w->now & (WHEEL_ROOT_SIZE - 1));
+
+        if (idx == 0) {
+            // Level 0 wrapped: pull the next span down from each level above
+            int shift = WHEEL_ROOT_BITS;
+            for (int level = 1; level < WHEEL_LEVELS; level++) {
+                int sub = (int)((w->now >> shift) & (WHEEL_LEVEL_SIZE - 1));
+                cascade(w, level, sub);
+                if (sub != 0) break;
+                shift += WHEEL_LEVEL_BITS;
+            }
+        } else if (!w->root[idx]) {
+            // Skip empty slots up to the wrap or the target in one step
+            uint64_t skip = ticks_to_next(w);
+            if (w->now + skip > target + 1) skip = target + 1 - w->now;
+            w->now += skip;
+            continue;
+        }
+
+        // Step past this tick first: a callback re-arming for "now" lands in
+        // the next slot instead of the one being run (a whole rotation late)
+        w->now++;
+        fired += run_slot(w, idx);
+    }
+    return fired;
+}
+
+static int Timers_Poll(EasyTimerWheel* w, const EasyEventLoop_t* engine,
+                       EasyLoop* loop, int max_ms) {
+    int n = engine->Poll(loop, Timers_NextTimeout(w, max_ms));
+    if (n < 0) return -1;
+    return n + Timers_Advance(w);
+}
+
+static void Timers_Destroy(EasyTimerWheel* w) {
+    if (!w) return;
+    // Leave the caller's timers looking disarmed
+    for (uint32_t slot = 0; slot < (WHEEL_LEVELS << 8); slot++) {
+        if ((slot & 0xFF) >= (slot < 256 ? WHEEL_ROOT_SIZE : WHEEL_LEVEL_SIZE)) continue;
+        EasyTimer* t = *slot_head(w, slot);
+        while (t) {
+            EasyTimer* next = t->next;
+            t->next = NULL;
+            t->pprev = NULL;
+            t = next;
+        }
+    }
+    free(w);
+}
+
+// Map the functions
+const EasyTimers_t Timers = {
+    .Create = Timers_Create,
+    .Start = Timers_Start,
+    .Cancel = Timers_Cancel,
+    .Pending = Timers_Pending,
+    .NextTimeout = Timers_NextTimeout,
+    .Advance = Timers_Advance,
+    .Poll = Timers_Poll,
+    .Destroy = Timers_Destroy
+};
@@ -0,0 +1,309 @@
+#define _GNU_SOURCE // recvmmsg, sendmmsg
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+#define UDP_BATCH_MAX     64     // Datagrams per recvmmsg/sendmmsg call
+#define UDP_GSO_MAX_SEGS  64     // Kernel limit on segments per GSO send
+#define UDP_MAX_PAYLOAD   65507
+
+// --- Helpers ---
+
+static bool make_addr(const char* ip, int port, struct sockaddr_in* addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
+    if (inet_pton(AF_INET, ip, &addr->sin_addr) <= 0) {
+        printf("EasySocket: Invalid address/ Address not supported \n");
+        return false;
+    }
+    return true;
+}
+
+static bool wait_readable(int fd, int timeout_ms) {
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    int r;
+    while ((r = poll(&pfd, 1, timeout_ms)) < 0 && errno == EINTR) {}
+    return r > 0;
+}
+
+// Plain sendmmsg() of equal slices; used when UDP GSO is not available
+static bool send_slices(int fd, const uint8_t* data, int len, int segment_size) {
+    struct mmsghdr msgs[UDP_BATCH_MAX];
+    struct iovec iov[UDP_BATCH_MAX];
+
+    while (len > 0) {
+        int n = 0;
+        while (len > 0 && n < UDP_BATCH_MAX) {
+            int part = (len < segment_size) ? len : segment_size;
+            iov[n] = (struct iovec){ (void*)data, (size_t)part };
+            memset(&msgs[n], 0, sizeof(msgs[n]));
+            msgs[n].msg_hdr.msg_iov = &iov[n];
+            msgs[n].msg_hdr.msg_iovlen = 1;
+            data += part;
+            len -= part;
+            n++;
+        }
+        for (int done = 0; done < n;) {
+            int r = sendmmsg(fd, msgs + done, n - done, 0);
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                perror("EasySocket: UDP send failed");
+                return false;
+            }
+            done += r;
+        }
+    }
+    return true;
+}
+
+// --- Implementation ---
+
+static int Udp_Bind(int port, int rcvbuf) {
+    struct sockaddr_in address;
+    int opt = 1;
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("EasySocket: Socket creation failed");
+        return -1;
+    }
+
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt))) {
+        perror("EasySocket: setsockopt failed");
+        close(fd);
+        return -1;
+    }
+    // Bursts at tens of thousands of packets/s overflow the default buffer
+    if (rcvbuf > 0 && setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf))) {
+        perror("EasySocket: SO_RCVBUF failed");
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        perror("EasySocket: Bind failed");
+        close(fd);
+        return -1;
+    }
+
+    printf("EasySocket: UDP bound to port %d\n", port);
+    return fd;
+}
+
+static int Udp_Connect(const char* ip, int port) {
+    struct sockaddr_in serv_addr;
+    if (!make_addr(ip, port, &serv_addr)) return -1;
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("EasySocket: Socket creation error");
+        return -1;
+    }
+
+    if (connect(fd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+        perror("EasySocket: UDP connect failed");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool Udp_Send(int fd, const void* data, int len) {
+    if (send(fd, data, len, 0) < 0) {
+        perror("EasySocket: UDP send failed");
+        return false;
+    }
+    return true;
+}
+
+static bool Udp_SendTo(int fd, const char* ip, int port, const void* data, int len) {
+    struct sockaddr_in addr;
+    if (!make_addr(ip, port, &addr)) return false;
+    if (sendto(fd, data, len, 0, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("EasySocket: UDP send failed");
+        return false;
+    }
+    return true;
+}
+
+static int Udp_Receive(int fd, void* buffer, int max_len, struct sockaddr_in* from) {
+    socklen_t addrlen = sizeof(struct sockaddr_in);
+    int n = recvfrom(fd, buffer, max_len, 0, (struct sockaddr *)from, from ? &addrlen : NULL);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        perror("EasySocket: UDP read error");
+    }
+    return n;
+}
+
+static int Udp_ReceiveBatch(int fd, EasyDatagram_t* slots, int count, int timeout_ms) {
+    struct mmsghdr msgs[UDP_BATCH_MAX];
+    struct iovec iov[UDP_BATCH_MAX];
+    union {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control[UDP_BATCH_MAX];
+
+    if (count <= 0) return 0;
+    if (timeout_ms != 0 && !wait_readable(fd, timeout_ms)) return 0;
+
+    int total = 0;
+    while (total < count) {
+        int n = (count - total < UDP_BATCH_MAX) ? count - total : UDP_BATCH_MAX;
+        for (int i = 0; i < n; i++) {
+            EasyDatagram_t* s = &slots[total + i];
+            iov[i] = (struct iovec){ s->data, s->cap };
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_name = &s->addr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(s->addr);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = control[i].buf;
+            msgs[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+        }
+
+        // Never block here: the wait (if any) already happened above
+        int r = recvmmsg(fd, msgs, n, MSG_DONTWAIT, NULL);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            perror("EasySocket: UDP read error");
+            return total ? total : -1;
+        }
+
+        for (int i = 0; i < r; i++) {
+            EasyDatagram_t* s = &slots[total + i];
+            s->len = msgs[i].msg_len;
+            s->segment_size = 0;
+            for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cm;
+                 cm = CMSG_NXTHDR(&msgs[i].msg_hdr, cm)) {
+                if (cm->cmsg_level == SOL_UDP && cm->cmsg_type == UDP_GRO) {
+                    int seg;
+                    memcpy(&seg, CMSG_DATA(cm), sizeof(seg));
+                    s->segment_size = (uint16_t)seg;
+                }
+            }
+        }
+        total += r;
+        if (r < n) break; // Socket drained
+    }
+    return total;
+}
+
+static int Udp_SendBatch(int fd, const EasyDatagram_t* slots, int count) {
+    struct mmsghdr msgs[UDP_BATCH_MAX];
+    struct iovec iov[UDP_BATCH_MAX];
+    int total = 0;
+
+    while (total < count) {
+        int n = (count - total < UDP_BATCH_MAX) ? count - total : UDP_BATCH_MAX;
+        for (int i = 0; i < n; i++) {
+            const EasyDatagram_t* s = &slots[total + i];
+            iov[i] = (struct iovec){ s->data, s->len };
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            if (s->addr.sin_family != 0) {
+                msgs[i].msg_hdr.msg_name = (void*)&s->addr;
+                msgs[i].msg_hdr.msg_namelen = sizeof(s->addr);
+            }
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int r = sendmmsg(fd, msgs, n, 0);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            perror("EasySocket: UDP send failed");
+            return total ? total : -1;
+        }
+        total += r;
+    }
+    return total;
+}
+
+static bool Udp_SendSegmented(int fd, const void* data, int len, int segment_size) {
+    const uint8_t* p = data;
+    if (segment_size <= 0) return false;
+
+    // Each GSO send is limited to 64 segments and one maximum-size datagram
+    int max_chunk = segment_size * UDP_GSO_MAX_SEGS;
+    if (max_chunk > UDP_MAX_PAYLOAD) max_chunk = (UDP_MAX_PAYLOAD / segment_size) * segment_size;
+    if (max_chunk <= 0) return false;
+
+    while (len > 0) {
+        int chunk = (len < max_chunk) ? len : max_chunk;
+        if (chunk <= segment_size) return send_slices(fd, p, len, segment_size);
+
+        union {
+            char buf[CMSG_SPACE(sizeof(uint16_t))];
+            struct cmsghdr align;
+        } control;
+        struct iovec iov = { (void*)p, (size_t)chunk };
+        struct msghdr mh = { .msg_iov = &iov, .msg_iovlen = 1,
+                             .msg_control = control.buf, .msg_controllen = sizeof(control.buf) };
+        struct cmsghdr* cm = CMSG_FIRSTHDR(&mh);
+        cm->cmsg_level = SOL_UDP;
+        cm->cmsg_type = UDP_SEGMENT;
+        cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t seg = (uint16_t)segment_size;
+        memcpy(CMSG_DATA(cm), &seg, sizeof(seg));
+
+        if (sendmsg(fd, &mh, 0) < 0) {
+            if (errno == EINTR) continue;
+            // No GSO in this kernel / on this route: send the rest one by one
+            if (errno == EINVAL || errno == EIO || errno == ENOPROTOOPT || errno == EOPNOTSUPP) {
+                return send_slices(fd, p, len, segment_size);
+            }
+            perror("EasySocket: UDP send failed");
+            return false;
+        }
+        p += chunk;
+        len -= chunk;
+    }
+    return true;
+}
+
+static bool Udp_EnableGro(int fd) {
+    int on = 1;
+    if (setsockopt(fd, SOL_UDP, UDP_GRO, &on, sizeof(on)) < 0) {
+        perror("EasySocket: UDP_GRO not supported");
+        return false;
+    }
+    return true;
+}
+
+static void Udp_Close(int fd) {
+    close(fd);
+}
+
+// Map the functions
+const EasyUdp_t UDP = {
+    .Bind = Udp_Bind,
+    .Connect = Udp_Connect,
+    .Send = Udp_Send,
+    .SendTo = Udp_SendTo,
+    .Receive = Udp_Receive,
+    .ReceiveBatch = Udp_ReceiveBatch,
+    .SendBatch = Udp_SendBatch,
+    .SendSegmented = Udp_SendSegmented,
+    .EnableGro = Udp_EnableGro,
+    .Close = Udp_Close
+};
@@ -0,0 +1,224 @@
+#define _GNU_SOURCE // accept4
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#define UNIX_BACKLOG 128
+
+// --- Helpers ---
+
+// Fills 'addr' and returns its length, or 0 if the path does not fit
+static socklen_t make_addr(const char* path, struct sockaddr_un* addr) {
+    size_t len = strlen(path);
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+
+    if (len == 0 || len >= sizeof(addr->sun_path)) {
+        fprintf(stderr, "EasySocket: Invalid unix socket path '%s'\n", path);
+        return 0;
+    }
+    memcpy(addr->sun_path, path, len);
+    if (path[0] == '@') {
+        // Abstract namespace: leading NUL, length marks the end of the name
+        addr->sun_path[0] = '\0';
+        return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + len);
+    }
+    return (socklen_t)sizeof(*addr);
+}
+
+static int socket_type(EasyUnixType_t type) {
+    return (type == UNIX_SEQPACKET) ? SOCK_SEQPACKET : SOCK_STREAM;
+}
+
+// --- Implementation ---
+
+static int Unix_StartServer(const char* path, EasyUnixType_t type) {
+    struct sockaddr_un address;
+    socklen_t addrlen = make_addr(path, &address);
+    if (!addrlen) return -1;
+
+    int server_fd = socket(AF_UNIX, socket_type(type) | SOCK_CLOEXEC, 0);
+    if (server_fd < 0) {
+        perror("EasySocket: Socket creation failed");
+        return -1;
+    }
+
+    // Remove a socket file left behind by a previous run (never a regular file)
+    struct stat st;
+    if (path[0] != '@' && stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(path);
+    }
+
+    if (bind(server_fd, (struct sockaddr *)&address, addrlen) < 0) {
+        perror("EasySocket: Bind failed");
+        close(server_fd);
+        return -1;
+    }
+
+    if (listen(server_fd, UNIX_BACKLOG) < 0) {
+        perror("EasySocket: Listen failed");
+        close(server_fd);
+        return -1;
+    }
+
+    printf("EasySocket: Server listening on %s...\n", path);
+    return server_fd;
+}
+
+static int Unix_Accept(int server_fd) {
+    int new_socket = accept4(server_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (new_socket < 0) {
+        perror("EasySocket: Accept failed");
+        return -1;
+    }
+    printf("EasySocket: Local connection accepted\n");
+    return new_socket;
+}
+
+static int Unix_Connect(const char* path, EasyUnixType_t type) {
+    struct sockaddr_un serv_addr;
+    socklen_t addrlen = make_addr(path, &serv_addr);
+    if (!addrlen) return -1;
+
+    int sock = socket(AF_UNIX, socket_type(type) | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        perror("EasySocket: Socket creation error");
+        return -1;
+    }
+
+    if (connect(sock, (struct sockaddr *)&serv_addr, addrlen) < 0) {
+        perror("EasySocket: Connection Failed");
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+static bool Unix_Send(int fd, const void* data, int len) {
+    const char* p = data;
+    // A seqpacket send is all-or-nothing, so this loop only repeats on streams
+    do {
+        ssize_t w = send(fd, p, len, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            perror("EasySocket: Send failed");
+            return false;
+        }
+        p += w;
+        len -= w;
+    } while (len > 0);
+    return true;
+}
+
+static int Unix_Receive(int fd, void* buffer, int max_len) {
+    int bytes_read;
+    while ((bytes_read = recv(fd, buffer, max_len, 0)) < 0 && errno == EINTR) {}
+    if (bytes_read < 0) {
+        perror("EasySocket: Read error");
+    }
+    return bytes_read;
+}
+
+static bool Unix_SendFd(int fd, int fd_to_pass, const void* data, int len) {
+    char dummy = 0;
+    union {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+
+    // The fd rides on real data: the kernel drops ancillary data on empty sends
+    struct iovec iov = { (void*)data, (size_t)len };
+    if (!data || len <= 0) {
+        iov.iov_base = &dummy;
+        iov.iov_len = 1;
+    }
+
+    struct msghdr mh = { .msg_iov = &iov, .msg_iovlen = 1,
+                         .msg_control = control.buf, .msg_controllen = sizeof(control.buf) };
+    struct cmsghdr* cm = CMSG_FIRSTHDR(&mh);
+    cm->cmsg_level = SOL_SOCKET;
+    cm->cmsg_type = SCM_RIGHTS;
+    cm->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cm), &fd_to_pass, sizeof(int));
+
+    ssize_t w;
+    while ((w = sendmsg(fd, &mh, MSG_NOSIGNAL)) < 0 && errno == EINTR) {}
+    if (w < 0) {
+        perror("EasySocket: Send fd failed");
+        return false;
+    }
+
+    // Rest of a large stream payload goes without the fd
+    if ((size_t)w < iov.iov_len) {
+        return Unix_Send(fd, (const char*)iov.iov_base + w, (int)(iov.iov_len - w));
+    }
+    return true;
+}
+
+static int Unix_ReceiveFd(int fd, void* buffer, int max_len, int* received_fd) {
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * 4)]; // Room to catch (and close) extras
+        struct cmsghdr align;
+    } control;
+
+    *received_fd = -1;
+    struct iovec iov = { buffer, (size_t)max_len };
+    struct msghdr mh = { .msg_iov = &iov, .msg_iovlen = 1,
+                         .msg_control = control.buf, .msg_controllen = sizeof(control.buf) };
+
+    int bytes_read;
+    while ((bytes_read = recvmsg(fd, &mh, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {}
+    if (bytes_read < 0) {
+        perror("EasySocket: Read error");
+        return -1;
+    }
+
+    for (struct cmsghdr* cm = CMSG_FIRSTHDR(&mh); cm; cm = CMSG_NXTHDR(&mh, cm)) {
+        if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_RIGHTS) continue;
+        int count = (int)((cm->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        for (int i = 0; i < count; i++) {
+            int passed;
+            memcpy(&passed, CMSG_DATA(cm) + i * sizeof(int), sizeof(int));
+            if (*received_fd < 0) *received_fd = passed;
+            else close(passed); // Only one fd per message is supported
+        }
+    }
+    if (mh.msg_flags & MSG_CTRUNC) {
+        fprintf(stderr, "EasySocket: Passed fds truncated\n");
+    }
+    return bytes_read;
+}
+
+static void Unix_Close(int fd) {
+    struct sockaddr_un addr;
+    socklen_t addrlen = sizeof(addr);
+    int listening = 0;
+    socklen_t optlen = sizeof(listening);
+
+    // A listening socket bound to a filesystem path owns that file
+    if (getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &optlen) == 0 && listening &&
+        getsockname(fd, (struct sockaddr *)&addr, &addrlen) == 0 &&
+        addrlen > offsetof(struct sockaddr_un, sun_path) && addr.sun_path[0] != '\0') {
+        unlink(addr.sun_path);
+    }
+    close(fd);
+    printf("EasySocket: Connection closed.\n");
+}
+
+// Map the functions
+const EasyUnixSocket_t UnixSocket = {
+    .StartServer = Unix_StartServer,
+    .Accept = Unix_Accept,
+    .Connect = Unix_Connect,
+    .Send = Unix_Send,
+    .Receive = Unix_Receive,
+    .SendFd = Unix_SendFd,
+    .ReceiveFd = Unix_ReceiveFd,
+    .Close = Unix_Close
+};
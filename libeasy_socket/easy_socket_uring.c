@@ -0,0 +1,797 @@
+#include "easy_socket_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+// The engine needs the 6.0 uapi (multishot accept and recv, provided
+// buffer rings); older headers build the epoll fallback only
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ACCEPT_MULTISHOT) && defined(IORING_ASYNC_CANCEL_ANY)
+#define EASY_HAVE_URING 1
+#endif
+#endif
+#endif
+
+#ifdef EASY_HAVE_URING
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+/*
+ * io_uring engine for the EventLoop interface, using raw syscalls (no
+ * liburing). Listeners use one multishot accept, connections one multishot
+ * recv that picks buffers from a registered buffer ring, and every SQE
+ * queued during a wakeup goes to the kernel in the next io_uring_enter().
+ */
+
+#define URING_ENTRIES    4096
+#define URING_BUF_COUNT  4096   // Provided receive buffers (power of two)
+#define URING_BUF_SIZE   4096
+#define URING_BUF_GROUP  0
+
+// user_data tags. Send operations use their (8-byte aligned) pointer instead.
+#define TAG_ACCEPT 1
+#define TAG_RECV   2
+#define TAG_IGNORE 3
+
+// --- Internal Storage ---
+
+// One in-flight send. Outlives its connection if the fd is closed mid-send,
+// because the kernel may still be reading 'buf'.
+typedef struct {
+    int fd;
+    uint32_t gen;
+    bool busy;
+    bool orphaned;
+    char* buf;
+    int len;
+    int off;
+    int cap;
+} UringSend;
+
+typedef struct {
+    bool in_use;
+    bool listener;
+    bool retry_send;     // Send could not be queued (SQ full); retried in Poll
+    bool peer_closed;    // Peer sent EOF; closed once the sends drain
+    uint32_t gen;
+    const EasyLoopCallbacks_t* cb;
+    void* user;
+
+    UringSend* send;     // Buffer being sent by the kernel
+    char* pending;       // Bytes queued behind it
+    int pending_len;
+    int pending_cap;
+} UringConn;
+
+typedef struct {
+    int engine;          // LOOP_ENGINE_URING, must come first
+    int ring_fd;
+    bool running;
+
+    // Submission ring
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    struct io_uring_sqe* sqes;
+    unsigned sq_entries;
+    unsigned sq_local_tail;
+    unsigned to_submit;
+
+    // Completion ring
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+
+    void* sq_ptr;
+    size_t sq_len;
+    void* cq_ptr;
+    size_t cq_len;
+    size_t sqes_len;
+    bool ext_arg;
+
+    // Provided buffer ring for multishot recv
+    struct io_uring_buf_ring* br;
+    char* buf_pool;
+    unsigned br_tail;
+
+    UringConn* conns;
+    int conn_cap;
+    int inflight;        // SQEs whose final CQE has not arrived
+    int send_retries;    // Connections with retry_send set
+} UringEngine;
+
+// --- Raw Syscalls ---
+
+static int uring_setup(unsigned entries, struct io_uring_params* p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                       unsigned flags, void* arg, size_t argsz) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+static int uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+// --- Helpers ---
+
+static uint64_t tag(int type, int fd, uint32_t gen) {
+    return ((uint64_t)gen << 32) | ((uint64_t)(uint32_t)fd << 2) | (uint64_t)type;
+}
+
+static bool reserve_slot(UringEngine* u, int fd) {
+    if (fd < u->conn_cap) return true;
+
+    int new_cap = u->conn_cap ? u->conn_cap : 1024;
+    while (new_cap <= fd) new_cap *= 2;
+
+    UringConn* grown = realloc(u->conns, new_cap * sizeof(UringConn));
+    if (!grown) return false;
+    memset(grown + u->conn_cap, 0, (new_cap - u->conn_cap) * sizeof(UringConn));
+
+    u->conns = grown;
+    u->conn_cap = new_cap;
+    return true;
+}
+
+static int submit(UringEngine* u, unsigned min_complete, int timeout_ms) {
+    unsigned flags = min_complete ? IORING_ENTER_GETEVENTS : 0;
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    void* argp = NULL;
+    size_t argsz = 0;
+
+    if (min_complete && timeout_ms >= 0 && u->ext_arg) {
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long long)(timeout_ms % 1000) * 1000000;
+        memset(&arg, 0, sizeof(arg));
+        arg.ts = (uint64_t)(uintptr_t)&ts;
+        flags |= IORING_ENTER_EXT_ARG;
+        argp = &arg;
+        argsz = sizeof(arg);
+    }
+
+    int r = uring_enter(u->ring_fd, u->to_submit, min_complete, flags, argp, argsz);
+    if (r >= 0) {
+        u->to_submit -= (unsigned)r < u->to_submit ? (unsigned)r : u->to_submit;
+        return r;
+    }
+    if (errno == ETIME || errno == EINTR || errno == EBUSY) return 0;
+    perror("EasySocket: io_uring_enter failed");
+    return -1;
+}
+
+static struct io_uring_sqe* get_sqe(UringEngine* u) {
+    unsigned head = __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+    if (u->sq_local_tail - head >= u->sq_entries) {
+        // Ring full: hand what we have to the kernel first
+        submit(u, 0, 0);
+        head = __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+        if (u->sq_local_tail - head >= u->sq_entries) return NULL;
+    }
+
+    unsigned idx = u->sq_local_tail & *u->sq_mask;
+    struct io_uring_sqe* sqe = &u->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    u->sq_array[idx] = idx;
+    u->sq_local_tail++;
+    __atomic_store_n(u->sq_tail, u->sq_local_tail, __ATOMIC_RELEASE);
+    u->to_submit++;
+    u->inflight++;
+    return sqe;
+}
+
+static bool arm_accept(UringEngine* u, int fd) {
+    struct io_uring_sqe* sqe = get_sqe(u);
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = tag(TAG_ACCEPT, fd, u->conns[fd].gen);
+    return true;
+}
+
+static bool arm_recv(UringEngine* u, int fd) {
+    struct io_uring_sqe* sqe = get_sqe(u);
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUF_GROUP;
+    sqe->user_data = tag(TAG_RECV, fd, u->conns[fd].gen);
+    return true;
+}
+
+static void prep_send(struct io_uring_sqe* sqe, UringSend* s) {
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = s->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(s->buf + s->off);
+    sqe->len = (unsigned)(s->len - s->off);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = (uint64_t)(uintptr_t)s;
+    s->busy = true;
+}
+
+// Give a receive buffer back to the kernel (published once per wakeup)
+static void recycle_buffer(UringEngine* u, unsigned bid) {
+    struct io_uring_buf* b = &u->br->bufs[u->br_tail & (URING_BUF_COUNT - 1)];
+    b->addr = (uint64_t)(uintptr_t)(u->buf_pool + (size_t)bid * URING_BUF_SIZE);
+    b->len = URING_BUF_SIZE;
+    b->bid = (uint16_t)bid;
+    u->br_tail++;
+}
+
+static void publish_buffers(UringEngine* u) {
+    __atomic_store_n(&u->br->tail, (uint16_t)u->br_tail, __ATOMIC_RELEASE);
+}
+
+static bool add_conn(UringEngine* u, int fd, bool listener,
+                     const EasyLoopCallbacks_t* cb, void* user) {
+    if (!reserve_slot(u, fd)) return false;
+
+    UringConn* c = &u->conns[fd];
+    c->in_use = true;
+    c->listener = listener;
+    c->gen++;
+    c->cb = cb;
+    c->user = user;
+    c->pending_len = 0;
+    c->peer_closed = false;
+    if (c->send) c->send->len = c->send->off = 0; // Left over from a closed fd
+
+    return listener ? arm_accept(u, fd) : arm_recv(u, fd);
+}
+
+static void close_conn(UringEngine* u, int fd) {
+    if (fd < 0 || fd >= u->conn_cap || !u->conns[fd].in_use) return;
+
+    UringConn* c = &u->conns[fd];
+    if (!c->listener && c->cb && c->cb->on_close) {
+        c->cb->on_close((EasyLoop*)u, fd, c->user);
+    }
+
+    // A send still owned by the kernel is freed when its CQE arrives
+    if (c->send && c->send->busy) {
+        c->send->orphaned = true;
+        c->send = NULL;
+    }
+
+    // shutdown() completes the outstanding multishot requests; their CQEs
+    // are then ignored because the generation no longer matches
+    c->in_use = false;
+    c->pending_len = 0;
+    if (c->retry_send) {
+        c->retry_send = false;
+        u->send_retries--;
+    }
+    shutdown(fd, SHUT_RDWR);
+    close(fd);
+}
+
+// Queue the next send for 'fd' if none is in flight: the rest of a short
+// send, else everything pending. Returns false, with nothing changed, when
+// no SQE (or send state) is available.
+static bool try_send(UringEngine* u, int fd) {
+    UringConn* c = &u->conns[fd];
+    UringSend* s = c->send;
+    if (s && s->busy) return true;
+
+    bool resume = s && s->off < s->len;
+    if (!resume && c->pending_len == 0) return true;
+    if (!s) {
+        s = c->send = calloc(1, sizeof(UringSend));
+        if (!s) return false;
+    }
+
+    // Take the SQE before touching the buffers, so a full SQ loses nothing
+    struct io_uring_sqe* sqe = get_sqe(u);
+    if (!sqe) return false;
+
+    if (!resume) {
+        // Swap buffers: the old send buffer becomes the new pending buffer
+        char* old_buf = s->buf;
+        int old_cap = s->cap;
+        s->buf = c->pending;
+        s->cap = c->pending_cap;
+        s->len = c->pending_len;
+        s->off = 0;
+        s->fd = fd;
+        s->gen = c->gen;
+        c->pending = old_buf;
+        c->pending_cap = old_cap;
+        c->pending_len = 0;
+    }
+    prep_send(sqe, s);
+    return true;
+}
+
+static void start_send(UringEngine* u, int fd) {
+    UringConn* c = &u->conns[fd];
+    if (try_send(u, fd) || c->retry_send) return;
+    c->retry_send = true;
+    u->send_retries++;
+}
+
+// Sends that found the SQ full, retried once io_uring_enter has drained it
+static void retry_sends(UringEngine* u) {
+    for (int fd = 0; fd < u->conn_cap && u->send_retries > 0; fd++) {
+        UringConn* c = &u->conns[fd];
+        if (!c->retry_send) continue;
+        c->retry_send = false;
+        u->send_retries--;
+        start_send(u, fd);
+    }
+}
+
+static bool sends_idle(const UringConn* c) {
+    const UringSend* s = c->send;
+    return c->pending_len == 0 && !c->retry_send && (!s || (!s->busy && s->off >= s->len));
+}
+
+// Peer half-closed: recv is not re-armed, but replies already queued are
+// still delivered before the connection is closed
+static void peer_eof(UringEngine* u, int fd) {
+    UringConn* c = &u->conns[fd];
+    if (sends_idle(c)) {
+        close_conn(u, fd);
+        return;
+    }
+    c->peer_closed = true;
+}
+
+static void handle_send(UringEngine* u, UringSend* s, int res) {
+    s->busy = false;
+    if (s->orphaned) {
+        free(s->buf);
+        free(s);
+        return;
+    }
+
+    int fd = s->fd;
+    if (res < 0) {
+        close_conn(u, fd);
+        return;
+    }
+
+    s->off += res;
+    UringConn* c = &u->conns[fd];
+    if (s->off < s->len || c->pending_len > 0) {
+        start_send(u, fd); // Short send: push the rest first
+    } else if (c->peer_closed) {
+        close_conn(u, fd);
+    } else if (c->cb && c->cb->on_write) {
+        c->cb->on_write((EasyLoop*)u, fd, c->user);
+    }
+}
+
+static void handle_cqe(UringEngine* u, struct io_uring_cqe* cqe) {
+    uint64_t ud = cqe->user_data;
+    bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+    if (!more) u->inflight--;
+
+    int type = (int)(ud & 3);
+    if (type == 0) {
+        handle_send(u, (UringSend*)(uintptr_t)ud, cqe->res);
+        return;
+    }
+    if (type == TAG_IGNORE) return;
+
+    int fd = (int)((ud >> 2) & 0x3FFFFFFF);
+    uint32_t gen = (uint32_t)(ud >> 32);
+    bool has_buf = (cqe->flags & IORING_CQE_F_BUFFER) != 0;
+    unsigned bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+
+    bool live = fd < u->conn_cap && u->conns[fd].in_use && u->conns[fd].gen == gen;
+    if (!live) {
+        if (has_buf) recycle_buffer(u, bid);
+        return;
+    }
+    UringConn* c = &u->conns[fd];
+
+    if (type == TAG_ACCEPT) {
+        if (cqe->res >= 0) {
+            int client = cqe->res;
+            if (c->cb && c->cb->on_accept && !c->cb->on_accept((EasyLoop*)u, client, c->user)) {
+                close(client);
+            } else if (!add_conn(u, client, false, c->cb, c->user)) {
+                close(client);
+            }
+        } else if (cqe->res != -EAGAIN && cqe->res != -EINTR) {
+            fprintf(stderr, "EasySocket: Accept failed: %s\n", strerror(-cqe->res));
+        }
+        if (!more && u->conns[fd].in_use && u->conns[fd].gen == gen) arm_accept(u, fd);
+        return;
+    }
+
+    // TAG_RECV
+    if (cqe->res > 0 && has_buf) {
+        if (c->cb && c->cb->on_read) {
+            const char* data = u->buf_pool + (size_t)bid * URING_BUF_SIZE;
+            c->cb->on_read((EasyLoop*)u, fd, data, cqe->res, c->user);
+        }
+        recycle_buffer(u, bid);
+        c = &u->conns[fd];
+        if (!c->in_use || c->gen != gen) return;
+        if (!more) arm_recv(u, fd);
+        return;
+    }
+
+    if (has_buf) recycle_buffer(u, bid);
+
+    // Out of provided buffers: re-arm once the ones in this batch are returned
+    if (cqe->res == -ENOBUFS) {
+        if (!more) arm_recv(u, fd);
+        return;
+    }
+    if (cqe->res == 0) {
+        peer_eof(u, fd);
+        return;
+    }
+    close_conn(u, fd);
+}
+
+static int reap(UringEngine* u) {
+    unsigned head = *u->cq_head;
+    unsigned tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+    int n = 0;
+
+    while (head != tail) {
+        struct io_uring_cqe cqe = u->cqes[head & *u->cq_mask];
+        head++;
+        // Release the slot before dispatch so callbacks can queue more work
+        __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+        handle_cqe(u, &cqe);
+        n++;
+        tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+    }
+    if (n) publish_buffers(u);
+    return n;
+}
+
+static bool setup_buffers(UringEngine* u) {
+    size_t ring_len = URING_BUF_COUNT * sizeof(struct io_uring_buf);
+    if (posix_memalign((void**)&u->br, (size_t)sysconf(_SC_PAGESIZE), ring_len) != 0) return false;
+    memset(u->br, 0, ring_len);
+
+    u->buf_pool = malloc((size_t)URING_BUF_COUNT * URING_BUF_SIZE);
+    if (!u->buf_pool) return false;
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)u->br;
+    reg.ring_entries = URING_BUF_COUNT;
+    reg.bgid = URING_BUF_GROUP;
+    if (uring_register(u->ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        perror("EasySocket: io_uring buffer ring registration failed");
+        return false;
+    }
+
+    for (unsigned i = 0; i < URING_BUF_COUNT; i++) recycle_buffer(u, i);
+    publish_buffers(u);
+    return true;
+}
+
+// --- Helper: Next CQE, submitting and waiting (up to 1s) if none is posted ---
+static bool next_cqe(UringEngine* u, struct io_uring_cqe* out) {
+    for (int tries = 0; tries < 2; tries++) {
+        unsigned head = *u->cq_head;
+        if (head != __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE)) {
+            *out = u->cqes[head & *u->cq_mask];
+            __atomic_store_n(u->cq_head, head + 1, __ATOMIC_RELEASE);
+            if (!(out->flags & IORING_CQE_F_MORE)) u->inflight--;
+            return true;
+        }
+        if (submit(u, 1, 1000) < 0) return false;
+    }
+    return false;
+}
+
+// Kernels between 5.19 and 6.0 accept the buffer ring but reject multishot
+// recv, which would close every connection: try one on a socketpair first
+static bool probe_multishot_recv(UringEngine* u) {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) < 0) return false;
+
+    bool ok = false;
+    struct io_uring_sqe* sqe = (write(sv[1], "x", 1) == 1) ? get_sqe(u) : NULL;
+    if (sqe) {
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = sv[0];
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = URING_BUF_GROUP;
+        sqe->user_data = TAG_IGNORE;
+
+        struct io_uring_cqe cqe;
+        if (next_cqe(u, &cqe)) {
+            ok = cqe.res == 1 && (cqe.flags & IORING_CQE_F_MORE);
+            // shutdown() ends the multishot recv; drain it before going on
+            shutdown(sv[0], SHUT_RDWR);
+            for (;;) {
+                if (cqe.flags & IORING_CQE_F_BUFFER) recycle_buffer(u, cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                if (!(cqe.flags & IORING_CQE_F_MORE)) break;
+                if (!next_cqe(u, &cqe)) {
+                    ok = false;
+                    break;
+                }
+            }
+            publish_buffers(u);
+        }
+    }
+    close(sv[0]);
+    close(sv[1]);
+    return ok;
+}
+
+static void free_uring(UringEngine* u) {
+    if (u->sqes) munmap(u->sqes, u->sqes_len);
+    if (u->cq_ptr && u->cq_ptr != u->sq_ptr) munmap(u->cq_ptr, u->cq_len);
+    if (u->sq_ptr) munmap(u->sq_ptr, u->sq_len);
+    if (u->ring_fd >= 0) close(u->ring_fd);
+    free(u->br);
+    free(u->buf_pool);
+    free(u);
+}
+
+static EasyLoop* uring_create(void) {
+    UringEngine* u = calloc(1, sizeof(UringEngine));
+    if (!u) return NULL;
+    u->engine = LOOP_ENGINE_URING;
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    u->ring_fd = uring_setup(URING_ENTRIES, &p);
+    if (u->ring_fd < 0 && errno == EINVAL) {
+        // Older kernel: retry without the optional flags
+        memset(&p, 0, sizeof(p));
+        u->ring_fd = uring_setup(URING_ENTRIES, &p);
+    }
+    if (u->ring_fd < 0) {
+        free(u);
+        return NULL;
+    }
+    u->ext_arg = (p.features & IORING_FEAT_EXT_ARG) != 0;
+
+    // Map the rings (one mapping when the kernel supports it)
+    u->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_len > u->sq_len) u->sq_len = u->cq_len;
+    }
+    u->sq_ptr = mmap(NULL, u->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     u->ring_fd, IORING_OFF_SQ_RING);
+    if (u->sq_ptr == MAP_FAILED) {
+        u->sq_ptr = NULL;
+        free_uring(u);
+        return NULL;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_ptr = u->sq_ptr;
+    } else {
+        u->cq_ptr = mmap(NULL, u->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         u->ring_fd, IORING_OFF_CQ_RING);
+        if (u->cq_ptr == MAP_FAILED) {
+            u->cq_ptr = NULL;
+            free_uring(u);
+            return NULL;
+        }
+    }
+    u->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   u->ring_fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) {
+        u->sqes = NULL;
+        free_uring(u);
+        return NULL;
+    }
+
+    char* sq = u->sq_ptr;
+    u->sq_head = (unsigned*)(sq + p.sq_off.head);
+    u->sq_tail = (unsigned*)(sq + p.sq_off.tail);
+    u->sq_mask = (unsigned*)(sq + p.sq_off.ring_mask);
+    u->sq_array = (unsigned*)(sq + p.sq_off.array);
+    u->sq_local_tail = *u->sq_tail;
+    u->sq_entries = p.sq_entries;
+
+    char* cq = u->cq_ptr;
+    u->cq_head = (unsigned*)(cq + p.cq_off.head);
+    u->cq_tail = (unsigned*)(cq + p.cq_off.tail);
+    u->cq_mask = (unsigned*)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+
+    if (!setup_buffers(u)) {
+        free_uring(u);
+        return NULL;
+    }
+    if (!probe_multishot_recv(u)) {
+        free_uring(u);
+        errno = EOPNOTSUPP;
+        return NULL;
+    }
+    return (EasyLoop*)u;
+}
+
+#endif // EASY_HAVE_URING
+
+// --- Implementation ---
+// Each entry forwards to EventLoop when the loop is an epoll fallback.
+
+#ifdef EASY_HAVE_URING
+#define AS_URING(loop) ((loop) && *(int*)(loop) == LOOP_ENGINE_URING ? (UringEngine*)(loop) : NULL)
+#endif
+
+static EasyLoop* Uring_Create(int max_events) {
+#ifdef EASY_HAVE_URING
+    EasyLoop* loop = uring_create();
+    if (loop) return loop;
+    perror("EasySocket: io_uring unavailable, using epoll");
+#endif
+    return EventLoop.Create(max_events);
+}
+
+static int Uring_Listen(EasyLoop* loop, int port, int backlog,
+                        const EasyLoopCallbacks_t* cb, void* user) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        int server_fd = easy_listen_socket(port, backlog);
+        if (server_fd < 0) return -1;
+        if (!add_conn(u, server_fd, true, cb, user)) {
+            close(server_fd);
+            return -1;
+        }
+        printf("EasySocket: io_uring loop listening on port %d...\n", port);
+        return server_fd;
+    }
+#endif
+    return EventLoop.Listen(loop, port, backlog, cb, user);
+}
+
+static bool Uring_Watch(EasyLoop* loop, int fd, const EasyLoopCallbacks_t* cb, void* user) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) return fd >= 0 && add_conn(u, fd, false, cb, user);
+#endif
+    return EventLoop.Watch(loop, fd, cb, user);
+}
+
+static bool Uring_Send(EasyLoop* loop, int fd, const void* data, int len) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        if (fd < 0 || fd >= u->conn_cap || !u->conns[fd].in_use) return false;
+        UringConn* c = &u->conns[fd];
+
+        // Queue behind any in-flight send; submitted with the next io_uring_enter
+        if (c->pending_len + len > c->pending_cap) {
+            int new_cap = c->pending_cap ? c->pending_cap : 4096;
+            while (new_cap < c->pending_len + len) new_cap *= 2;
+            char* grown = realloc(c->pending, new_cap);
+            if (!grown) return false;
+            c->pending = grown;
+            c->pending_cap = new_cap;
+        }
+        memcpy(c->pending + c->pending_len, data, len);
+        c->pending_len += len;
+        start_send(u, fd);
+        return true;
+    }
+#endif
+    return EventLoop.Send(loop, fd, data, len);
+}
+
+static int Uring_Poll(EasyLoop* loop, int timeout_ms) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        if (u->send_retries > 0) retry_sends(u);
+
+        // Completions already posted need no syscall at all
+        int n = reap(u);
+        if (n > 0 && u->to_submit == 0) return n;
+
+        // One syscall submits everything queued and waits for completions
+        if (submit(u, (n > 0 || timeout_ms == 0) ? 0 : 1, timeout_ms) < 0) return -1;
+        return n + reap(u);
+    }
+#endif
+    return EventLoop.Poll(loop, timeout_ms);
+}
+
+static void Uring_Run(EasyLoop* loop) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        u->running = true;
+        while (u->running) {
+            if (Uring_Poll(loop, -1) < 0) break;
+        }
+        return;
+    }
+#endif
+    EventLoop.Run(loop);
+}
+
+static void Uring_Stop(EasyLoop* loop) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        u->running = false;
+        return;
+    }
+#endif
+    EventLoop.Stop(loop);
+}
+
+static void Uring_CloseConn(EasyLoop* loop, int fd) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        close_conn(u, fd);
+        return;
+    }
+#endif
+    EventLoop.CloseConn(loop, fd);
+}
+
+static void Uring_Destroy(EasyLoop* loop) {
+#ifdef EASY_HAVE_URING
+    UringEngine* u = AS_URING(loop);
+    if (u) {
+        for (int fd = 0; fd < u->conn_cap; fd++) close_conn(u, fd);
+
+        // Cancel what is left and wait (briefly) so the kernel is done with
+        // every buffer before it is freed
+        struct io_uring_sqe* sqe = get_sqe(u);
+        if (sqe) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+            sqe->user_data = TAG_IGNORE;
+        }
+        for (int i = 0; i < 100 && u->inflight > 0; i++) {
+            if (submit(u, 1, 10) < 0) break;
+            reap(u);
+        }
+
+        for (int fd = 0; fd < u->conn_cap; fd++) {
+            UringConn* c = &u->conns[fd];
+            if (c->send) {
+                free(c->send->buf);
+                free(c->send);
+            }
+            free(c->pending);
+        }
+        free(u->conns);
+        free_uring(u);
+        return;
+    }
+#endif
+    EventLoop.Destroy(loop);
+}
+
+// Map the functions
+const EasyEventLoop_t UringLoop = {
+    .Create = Uring_Create,
+    .Listen = Uring_Listen,
+    .Watch = Uring_Watch,
+    .Send = Uring_Send,
+    .Poll = Uring_Poll,
+    .Run = Uring_Run,
+    .Stop = Uring_Stop,
+    .CloseConn = Uring_CloseConn,
+    .Destroy = Uring_Destroy
+};
@@ -0,0 +1,200 @@
+#include "easy_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+#define ZC_DEFAULT_THRESHOLD (32 * 1024)  // Below this, pinning pages costs more than copying
+#define SENDFILE_MAX_CHUNK   (1 << 30)
+
+// --- Internal Storage ---
+
+static EasyZeroCopyStats_t zc_stats;
+
+// --- Helpers ---
+
+static void wait_fd(int fd, short events) {
+    struct pollfd pfd = { .fd = fd, .events = events };
+    while (poll(&pfd, 1, -1) < 0 && errno == EINTR) {}
+}
+
+static int64_t send_plain(int fd, const char* buf, size_t len) {
+    size_t sent = 0;
+    while (sent < len) {
+        ssize_t w = send(fd, buf + sent, len - sent, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                wait_fd(fd, POLLOUT);
+                continue;
+            }
+            perror("EasySocket: Send failed");
+            return -1;
+        }
+        sent += w;
+    }
+    return (int64_t)sent;
+}
+
+// Read zerocopy completions from the error queue. Each notification covers
+// a range of send calls [ee_info, ee_data].
+static bool reap_completions(int fd, uint64_t* completed) {
+    char control[128];
+
+    for (;;) {
+        struct msghdr msg = { .msg_control = control, .msg_controllen = sizeof(control) };
+        if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            perror("EasySocket: Error queue read failed");
+            return false;
+        }
+
+        for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            bool v4 = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR);
+            bool v6 = (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+            if (!v4 && !v6) continue;
+
+            struct sock_extended_err serr;
+            memcpy(&serr, CMSG_DATA(cm), sizeof(serr));
+            if (serr.ee_errno != 0 || serr.ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+
+            uint64_t n = (uint64_t)(serr.ee_data - serr.ee_info) + 1;
+            *completed += n;
+            if (serr.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                __atomic_fetch_add(&zc_stats.copied_sends, n, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+// --- Implementation ---
+
+static int64_t ZeroCopy_SendFile(int fd, int file_fd, int64_t offset, int64_t len) {
+    if (len == 0) {
+        struct stat st;
+        if (fstat(file_fd, &st) < 0) {
+            perror("EasySocket: fstat failed");
+            return -1;
+        }
+        len = st.st_size - offset;
+        if (len <= 0) return 0;
+    }
+
+    off_t off = (off_t)offset;
+    int64_t total = 0;
+
+    while (total < len) {
+        int64_t chunk = len - total;
+        if (chunk > SENDFILE_MAX_CHUNK) chunk = SENDFILE_MAX_CHUNK;
+
+        ssize_t n = sendfile(fd, file_fd, &off, (size_t)chunk);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                wait_fd(fd, POLLOUT);
+                continue;
+            }
+            perror("EasySocket: sendfile failed");
+            return -1;
+        }
+        if (n == 0) break; // File ended early
+        total += n;
+    }
+    return total;
+}
+
+static int64_t ZeroCopy_SendPath(int fd, const char* path, int64_t offset, int64_t len) {
+    int file_fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (file_fd < 0) {
+        perror("EasySocket: Could not open file");
+        return -1;
+    }
+    int64_t sent = ZeroCopy_SendFile(fd, file_fd, offset, len);
+    close(file_fd);
+    return sent;
+}
+
+static int64_t ZeroCopy_SendBuffer(int fd, const void* buf, size_t len, size_t threshold) {
+    const char* p = buf;
+    int one = 1;
+
+    if (threshold == 0) threshold = ZC_DEFAULT_THRESHOLD;
+    if (len < threshold || setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) < 0) {
+        __atomic_fetch_add(&zc_stats.fallback_sends, 1, __ATOMIC_RELAXED);
+        return send_plain(fd, p, len);
+    }
+
+    size_t sent = 0;
+    uint64_t issued = 0, completed = 0;
+
+    while (sent < len) {
+        ssize_t w = send(fd, p + sent, len - sent, MSG_ZEROCOPY | MSG_NOSIGNAL);
+        if (w >= 0) {
+            sent += w;
+            issued++;
+            continue;
+        }
+
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            wait_fd(fd, POLLOUT);
+            if (!reap_completions(fd, &completed)) return -1;
+            continue;
+        }
+        if (errno == ENOBUFS) {
+            // Out of pinned-page budget (optmem_max): wait for completions
+            // to release some, or copy the rest if none are outstanding
+            if (completed < issued) {
+                wait_fd(fd, 0);
+                if (!reap_completions(fd, &completed)) return -1;
+                continue;
+            }
+            __atomic_fetch_add(&zc_stats.fallback_sends, 1, __ATOMIC_RELAXED);
+            int64_t rest = send_plain(fd, p + sent, len - sent);
+            if (rest < 0) return -1;
+            sent += rest;
+            break;
+        }
+        perror("EasySocket: Zerocopy send failed");
+        return -1;
+    }
+
+    // The caller owns 'buf' again only after the kernel has released every page
+    while (completed < issued) {
+        wait_fd(fd, 0); // POLLERR signals a non-empty error queue
+        if (!reap_completions(fd, &completed)) return -1;
+    }
+
+    __atomic_fetch_add(&zc_stats.zerocopy_sends, issued, __ATOMIC_RELAXED);
+    return (int64_t)sent;
+}
+
+static void ZeroCopy_Stats(EasyZeroCopyStats_t* stats) {
+    stats->zerocopy_sends = __atomic_load_n(&zc_stats.zerocopy_sends, __ATOMIC_RELAXED);
+    stats->copied_sends = __atomic_load_n(&zc_stats.copied_sends, __ATOMIC_RELAXED);
+    stats->fallback_sends = __atomic_load_n(&zc_stats.fallback_sends, __ATOMIC_RELAXED);
+}
+
+// Map the functions
+const EasyZeroCopy_t ZeroCopy = {
+    .SendFile = ZeroCopy_SendFile,
+    .SendPath = ZeroCopy_SendPath,
+    .SendBuffer = ZeroCopy_SendBuffer,
+    .Stats = ZeroCopy_Stats
+};
@@ -0,0 +1,162 @@
+/*
+ * Input monitor vs. a digitalRead busy loop, on a replayed waveform.
+ *
+ * The simulated REG_IN plays a recorded-style waveform: each DI pin
+ * toggles every 3-6 ms, and every edge bounces five times over 140 us.
+ *   poll    - digitalRead(DI1..DI4) in a loop, counting every change
+ *   monitor - rob_monitor at the given rate with a 500 us debounce
+ * Reported: port reads per second, CPU used, edges reported vs. real
+ * edges, event timestamp minus the start of each edge (its bounce lasts
+ * 140 us), and the monitor's own tick statistics.
+ *
+ * Usage: ./bench/bench_monitor [rate_hz] [seconds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "rob_gpio.h"
+
+#define GRID_NS     10000ULL         // Waveform resolution
+#define DEBOUNCE_US 500
+
+static const unsigned long long bounce_ns[] = { 0, 20000, 50000, 90000, 140000 };
+#define BOUNCES  (sizeof(bounce_ns) / sizeof(bounce_ns[0]))
+#define SETTLE_NS 140000ULL
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned long long edge_period(int pin) {
+    return (3 + pin) * 1000000ULL;
+}
+
+// Level of one input at time t: edges at every k * period, each a burst
+static int level(int pin, unsigned long long t) {
+    unsigned long long k = t / edge_period(pin);
+    if (k == 0) return 0;
+    unsigned long long offset = t % edge_period(pin);
+    unsigned long long toggles = 0;
+    for (size_t j = 0; j < BOUNCES; j++) toggles += (bounce_ns[j] <= offset);
+    return (int)((k - 1 + toggles) & 1);
+}
+
+static rob_sim_step_t* make_waveform(unsigned long long duration, int* count) {
+    rob_sim_step_t* steps = malloc((duration / GRID_NS + 1) * sizeof(rob_sim_step_t));
+    int n = 0;
+    int last = -1;
+    for (unsigned long long t = 0; t <= duration; t += GRID_NS) {
+        int reg = 0;
+        for (int pin = DI1; pin <= DI4; pin++) reg |= level(pin, t) << pin;
+        if (reg != last) {
+            steps[n].time_ns = t;
+            steps[n].reg_in = (unsigned char)reg;
+            n++;
+            last = reg;
+        }
+    }
+    *count = n;
+    return steps;
+}
+
+static long expected_edges(unsigned long long duration) {
+    long edges = 0;
+    for (int pin = DI1; pin <= DI4; pin++) {
+        for (unsigned long long e = edge_period(pin); e + SETTLE_NS < duration; e += edge_period(pin)) edges++;
+    }
+    return edges;
+}
+
+static void run_poll(const rob_sim_step_t* steps, int count, double seconds, long expected) {
+    rob_sim_reset(0x0F, 0x00);
+    rob_sim_play(steps, count);
+    unsigned int prev = 0;
+    long changes = 0;
+    double t0 = now_s(), c0 = cpu_s();
+    while (now_s() - t0 < seconds) {
+        unsigned int v = 0;
+        for (int pin = DI1; pin <= DI4; pin++) v |= (unsigned int)digitalRead(pin) << pin;
+        changes += __builtin_popcount(v ^ prev);
+        prev = v;
+    }
+    double wall = now_s() - t0, cpu = cpu_s() - c0;
+    unsigned long reads;
+    rob_sim_counts(&reads, NULL);
+    printf("%-8s %12.0f %6.0f%% %8ld %8ld %10s %10s\n", "poll", reads / wall, cpu / wall * 100, changes, expected, "-",
+           "-");
+}
+
+static void run_monitor(const rob_sim_step_t* steps, int count, double seconds, long expected, unsigned int rate) {
+    rob_sim_reset(0x0F, 0x00);
+    rob_monitor_config_t config = { rate, { DEBOUNCE_US, DEBOUNCE_US, DEBOUNCE_US, DEBOUNCE_US }, NULL, NULL, 0 };
+    if (rob_monitor_start(&config) != 0) return;
+
+    rob_sim_play(steps, count);
+    unsigned long long start = (unsigned long long)(now_s() * 1e9);
+    double t0 = now_s(), c0 = cpu_s();
+
+    long events = 0, wrong = 0;
+    double err_sum = 0, err_max = 0;
+    rob_event_t batch[64];
+    while (now_s() - t0 < seconds) {
+        usleep(1000);
+        int n = rob_monitor_poll(batch, 64);
+        for (int i = 0; i < n; i++) {
+            // Match to the nearest edge; a sample inside the bounce can
+            // be the first one at the new level, so t may precede the settle
+            long long t = (long long)(batch[i].time_ns - start);
+            long long p = (long long)edge_period(batch[i].pin);
+            long long k = (t + p / 2) / p;
+            if (k == 0 || batch[i].value != (k & 1)) {
+                wrong++;
+                continue;
+            }
+            double err = (double)(t - k * p) / 1e3;
+            err_sum += err;
+            if (err > err_max) err_max = err;
+            events++;
+        }
+    }
+    double wall = now_s() - t0, cpu = cpu_s() - c0;
+    rob_monitor_stop();
+
+    rob_monitor_stats_t stats;
+    rob_monitor_stats(&stats);
+    printf("%-8s %12.0f %6.0f%% %8ld %8ld %9.1f %9.1f\n", "monitor", stats.samples / wall, cpu / wall * 100, events,
+           expected, events ? err_sum / events : 0, err_max);
+    printf("  ticks: %lu missed, worst wake-up %.1f us late, %lu dropped, %ld unmatched (late ticks)\n", stats.missed_ticks,
+           stats.max_late_ns / 1e3, stats.dropped, wrong);
+}
+
+int main(int argc, char** argv) {
+    unsigned int rate = (argc > 1) ? (unsigned int)atoi(argv[1]) : 10000;
+    double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+    if (rate == 0) rate = 10000;
+    if (seconds <= 0) seconds = 1.0;
+
+    unsigned long long duration = (unsigned long long)(seconds * 1e9);
+    int count;
+    rob_sim_step_t* steps = make_waveform(duration, &count);
+    long expected = expected_edges(duration);
+
+    rob_set_io(&rob_io_sim);
+    rob_sim_reset(0x0F, 0x00);
+    if (rob_setup() != 0) return 1;
+
+    printf("waveform: %d steps over %.1f s, %ld real edges; monitor at %u Hz\n", count, seconds, expected, rate);
+    printf("%-8s %12s %7s %8s %8s %10s %10s\n", "mode", "reads/s", "cpu", "edges", "real", "delay us", "max us");
+    run_poll(steps, count, seconds, expected);
+    run_monitor(steps, count, seconds, expected, rate);
+
+    free(steps);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+ * Updating every output / reading every input: one pin at a time vs. the
+ * mask calls, against the simulated ports (no root or hardware needed).
+ *
+ *   rmw x4          - the old digitalWrite: inb + outb per pin
+ *   digitalWrite x4 - one outb per pin through the shadow register
+ *   writePins       - one outb for all four
+ *   digitalRead x4  - one inb per pin
+ *   readAllInputs   - one inb for all four
+ *
+ * Reported per update: port accesses, REG_OUT writes that leave the
+ * outputs half-changed, and time. Each set runs with a free simulated bus
+ * and with one that costs a realistic ~1 us per access.
+ *
+ * Usage: ./bench/bench_pins [latency_ns]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rob_gpio.h"
+
+#define REG_OUT 0xA02
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// The pre-shadow write path, for comparison
+static void rmw_write(int pin, int value) {
+    int bit = pin - DO1;
+    unsigned char reg = rob_io_sim.in(REG_OUT);
+    reg = (value == HIGH) ? reg & ~(1 << bit) : reg | (1 << bit); // Active low
+    rob_io_sim.out(reg, REG_OUT);
+}
+
+static void set_rmw(unsigned int v) {
+    for (int p = DO1; p <= DO4; p++) rmw_write(p, (v >> p) & 1);
+}
+
+static void set_each(unsigned int v) {
+    for (int p = DO1; p <= DO4; p++) digitalWrite(p, (v >> p) & 1);
+}
+
+static void set_all(unsigned int v) {
+    writePins(ROB_ALL_DO, v);
+}
+
+static unsigned int get_each(void) {
+    unsigned int v = 0;
+    for (int p = DI1; p <= DI4; p++) v |= (unsigned int)digitalRead(p) << p;
+    return v;
+}
+
+static unsigned int get_all(void) {
+    return readAllInputs();
+}
+
+static void report(const char* name, long updates, double elapsed) {
+    unsigned long reads, writes;
+    rob_sim_counts(&reads, &writes);
+    double ops = (double)(reads + writes) / updates;
+    double partial = (writes > 0) ? (double)writes / updates - 1 : 0;
+    printf("%-16s %8.1f %10.1f %10.1f\n", name, ops, partial, elapsed / updates * 1e9);
+}
+
+static void run_write(const char* name, void (*set)(unsigned int), double budget) {
+    long updates = 0;
+    rob_sim_reset(0x0F, 0x00); // All outputs OFF
+    double t0 = now_s();
+    do {
+        // Alternate all-on / all-off so every pin changes every update
+        for (int i = 0; i < 64; i++) set((updates + i) & 1 ? ROB_ALL_DO : 0);
+        updates += 64;
+    } while (now_s() - t0 < budget);
+    double elapsed = now_s() - t0;
+    report(name, updates, elapsed);
+    // Last update was all-on, which is all bits clear (active low)
+    if ((rob_sim_outputs() & 0x0F) != 0x00) printf("  WRONG FINAL STATE 0x%02X\n", rob_sim_outputs());
+}
+
+static void run_read(const char* name, unsigned int (*get)(void), double budget) {
+    long updates = 0;
+    unsigned int sum = 0;
+    rob_sim_reset(0x0F, 0x05);
+    double t0 = now_s();
+    do {
+        for (int i = 0; i < 64; i++) sum += get();
+        updates += 64;
+    } while (now_s() - t0 < budget);
+    double elapsed = now_s() - t0;
+    report(name, updates, elapsed);
+    if (sum != 0x05u * (unsigned int)updates) printf("  MISMATCH\n");
+}
+
+int main(int argc, char** argv) {
+    unsigned int slow_ns = (argc > 1) ? (unsigned int)atoi(argv[1]) : 1000;
+
+    rob_set_io(&rob_io_sim);
+    rob_sim_reset(0x0F, 0x00);
+    if (rob_setup() != 0) return 1;
+
+    unsigned int latencies[2] = { 0, slow_ns };
+    for (int l = 0; l < 2; l++) {
+        rob_sim_set_latency(latencies[l]);
+        double budget = 0.3;
+        printf("bus latency %u ns\n", latencies[l]);
+        printf("%-16s %8s %10s %10s\n", "call", "port ops", "partial", "ns/update");
+        run_write("rmw x4", set_rmw, budget);
+        run_write("digitalWrite x4", set_each, budget);
+        run_write("writePins", set_all, budget);
+        run_read("digitalRead x4", get_each, budget);
+        run_read("readAllInputs", get_all, budget);
+        printf("\n");
+    }
+    return 0;
+}
\ No newline at end of file
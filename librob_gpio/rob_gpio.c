@@ -3,10 +3,7 @@
 #include <unistd.h>
 #include <sys/io.h>
 #include "rob_gpio.h"
-
-// --- REGISTERS ---
-#define REG_OUT 0xA02
-#define REG_IN  0xA03
+#include "rob_gpio_internal.h"
 
 // --- HARDWARE MAPPING STRUCT ---
 typedef struct {
@@ -17,6 +14,8 @@ typedef struct {
 } pin_config_t;
 
 // --- THE MAP ---
+// Outputs must live in REG_OUT and inputs in REG_IN: the multi-pin
+// calls move each group with one access to its register.
 static const pin_config_t PIN_MAP[8] = {
     // INPUTS (DI1-DI4) - Usually Normal Logic (1=High Voltage)
     { REG_IN,  0, 0, 0 }, // DI1
@@ -38,74 +37,131 @@ static const pin_config_t PIN_MAP[8] = {
 // It abstracts away the hardware inversion.
 static int pin_states[8] = {0}; 
 
+// --- PORT I/O ---
+static const rob_io_t* io = &rob_io_hw;
+
+// Last value written to REG_OUT. The outputs are only ever changed
+// through this library, so writes never need to read the port first.
+static unsigned char out_shadow = 0;
+
+// --- PRECOMPUTED MASKS (built from PIN_MAP by build_masks) ---
+// do_to_reg: logical DO1-DO4 nibble -> REG_OUT bits for those pins
+// out_invert: REG_OUT bits of the active-low outputs
+// in_to_di: raw REG_IN byte -> logical DI1-DI4 nibble, inversion applied
+static unsigned char do_to_reg[16];
+static unsigned char out_invert = 0;
+static unsigned char in_to_di[256];
+
+static void build_masks(void) {
+    out_invert = 0;
+    for (int i = DO1; i <= DO4; i++) {
+        if (PIN_MAP[i].invert) out_invert |= 1 << PIN_MAP[i].bit_num;
+    }
+    for (int nibble = 0; nibble < 16; nibble++) {
+        do_to_reg[nibble] = 0;
+        for (int i = DO1; i <= DO4; i++) {
+            if (nibble & (1 << (i - DO1))) do_to_reg[nibble] |= 1 << PIN_MAP[i].bit_num;
+        }
+    }
+    for (int reg = 0; reg < 256; reg++) {
+        in_to_di[reg] = 0;
+        for (int i = DI1; i <= DI4; i++) {
+            int physical_bit = (reg >> PIN_MAP[i].bit_num) & 1;
+            if (physical_bit ^ PIN_MAP[i].invert) in_to_di[reg] |= 1 << i;
+        }
+    }
+}
+
+// --- HARDWARE BACKEND ---
+static int hw_open(void) {
+    return ioperm(REG_OUT, 2, 1);
+}
+
+static unsigned char hw_in(unsigned short port) {
+    return inb(port);
+}
+
+static void hw_out(unsigned char value, unsigned short port) {
+    outb(value, port);
+}
+
+const rob_io_t rob_io_hw = { hw_open, hw_in, hw_out };
+
+void rob_set_io(const rob_io_t* backend) {
+    io = backend ? backend : &rob_io_hw;
+}
+
 // --- SETUP ---
 int rob_setup(void) {
-    if (ioperm(REG_OUT, 2, 1)) {
+    if (io->open()) {
         perror("[LIB-ROB] GPIO Init Failed.");
         return -1;
     }
+
+    build_masks();
     
     // Sync Logic: Read hardware, apply inversion map, store in array
     
-    // Sync Outputs
-    unsigned char out_reg = inb(REG_OUT);
-    for(int i = 4; i <= 7; i++) {
-        int physical_bit = (out_reg >> PIN_MAP[i].bit_num) & 1;
-        // If inverted logic: Physical 0 -> Logical 1 (HIGH)
-        if (PIN_MAP[i].invert) {
-            pin_states[i] = !physical_bit; 
-        } else {
-            pin_states[i] = physical_bit;
-        }
+    // Sync Outputs (and take over the register into the shadow)
+    out_shadow = io->in(REG_OUT);
+    unsigned char logical_out = out_shadow ^ out_invert;
+    for(int i = DO1; i <= DO4; i++) {
+        pin_states[i] = (logical_out >> PIN_MAP[i].bit_num) & 1;
     }
     
     // Sync Inputs
-    unsigned char in_reg = inb(REG_IN);
-    for(int i = 0; i <= 3; i++) {
-        int physical_bit = (in_reg >> PIN_MAP[i].bit_num) & 1;
-        if (PIN_MAP[i].invert) {
-            pin_states[i] = !physical_bit;
-        } else {
-            pin_states[i] = physical_bit;
-        }
-    }
+    readAllInputs();
 
     return 0;
 }
 
-// --- DIGITAL WRITE ---
-void digitalWrite(int pin, int value) {
-    if (pin < 0 || pin > 7) return;
+// --- MULTI-PIN WRITE ---
+// One outb for any number of outputs, so they all change together
+void writePins(unsigned int mask, unsigned int values) {
+    if (mask & ROB_ALL_DI) {
+        fprintf(stderr, "[LIB-ROB] Error: Pins in mask 0x%02X are Read-Only\n", mask & ROB_ALL_DI);
+    }
 
-    if (PIN_MAP[pin].is_output == 0) {
-        fprintf(stderr, "[LIB-ROB] Error: Pin %d is Read-Only\n", pin);
-        return;
+    unsigned int do_mask = (mask & ROB_ALL_DO) >> DO1;
+    unsigned int do_values = (values & mask & ROB_ALL_DO) >> DO1;
+    if (do_mask == 0) return;
+
+    // Logical -> physical: place the bits, then flip the active-low ones
+    unsigned char reg_mask = do_to_reg[do_mask];
+    unsigned char reg_bits = do_to_reg[do_values] ^ (out_invert & reg_mask);
+
+    out_shadow = (out_shadow & ~reg_mask) | reg_bits;
+    io->out(out_shadow, REG_OUT);
+
+    for (int i = DO1; i <= DO4; i++) {
+        if (mask & ROB_PIN(i)) pin_states[i] = (values >> i) & 1;
     }
+}
 
-    // 1. Store the LOGICAL intent (e.g., User wants HIGH/ON)
-    pin_states[pin] = (value == HIGH) ? HIGH : LOW;
+// --- MULTI-PIN READ ---
+unsigned int rob_sample_inputs(void) {
+    return in_to_di[io->in(REG_IN)];
+}
 
-    // 2. Determine PHYSICAL bit to write
-    // If invert is true: HIGH -> 0, LOW -> 1
-    int physical_value;
-    if (PIN_MAP[pin].invert) {
-        physical_value = (value == HIGH) ? 0 : 1; 
-    } else {
-        physical_value = (value == HIGH) ? 1 : 0;
+unsigned int readAllInputs(void) {
+    unsigned int di = rob_sample_inputs();
+    for (int i = DI1; i <= DI4; i++) {
+        pin_states[i] = (di >> i) & 1;
     }
+    return di;
+}
 
-    // 3. Read-Modify-Write
-    unsigned char current_reg = inb(PIN_MAP[pin].port_addr);
-    unsigned char next_reg;
-    int bit = PIN_MAP[pin].bit_num;
+// --- DIGITAL WRITE ---
+void digitalWrite(int pin, int value) {
+    if (pin < 0 || pin > 7) return;
 
-    if (physical_value == 1) {
-        next_reg = current_reg | (1 << bit);
-    } else {
-        next_reg = current_reg & ~(1 << bit);
+    if (PIN_MAP[pin].is_output == 0) {
+        fprintf(stderr, "[LIB-ROB] Error: Pin %d is Read-Only\n", pin);
+        return;
     }
 
-    outb(next_reg, PIN_MAP[pin].port_addr);
+    // A one-pin batch: the shadow replaces the old inb read-modify-write
+    writePins(ROB_PIN(pin), (value == HIGH) ? ROB_PIN(pin) : 0);
 }
 
 // --- DIGITAL READ ---
@@ -118,19 +174,7 @@ int digitalRead(int pin) {
     }
 
     // If Input, read hardware and map back to logical
-    unsigned char reg_val = inb(PIN_MAP[pin].port_addr);
-    int bit = PIN_MAP[pin].bit_num;
-    int physical_val = (reg_val >> bit) & 1;
-    
-    int logical_val;
-    if (PIN_MAP[pin].invert) {
-        logical_val = !physical_val;
-    } else {
-        logical_val = physical_val;
-    }
-    
-    pin_states[pin] = logical_val;
-    return logical_val;
+    return (readAllInputs() >> pin) & 1;
 }
 
 // --- DEBUG ---
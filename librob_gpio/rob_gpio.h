@@ -1,6 +1,8 @@
 #ifndef ROB_GPIO_H
 #define ROB_GPIO_H
 
+#include <stdint.h>
+
 // --- LOGIC STATES ---
 #define HIGH 1
 #define LOW  0
@@ -18,10 +20,165 @@
 #define DO3 6
 #define DO4 7
 
+// --- PIN MASKS ---
+// Multi-pin calls take one bit per pin ID: ROB_PIN(DO2) | ROB_PIN(DO4)
+#define ROB_PIN(pin)   (1u << (pin))
+#define ROB_ALL_DI     0x0Fu
+#define ROB_ALL_DO     0xF0u
+
+// --- PORT I/O BACKEND ---
+// Everything the library does to the hardware goes through one of these.
+// The default talks to the real ports (ioperm/inb/outb, needs root);
+// rob_io_sim below is a register file in memory for tests and benchmarks.
+typedef struct {
+    int (*open)(void);                                   // 0 on success
+    unsigned char (*in)(unsigned short port);
+    void (*out)(unsigned char value, unsigned short port);
+} rob_io_t;
+
+extern const rob_io_t rob_io_hw;
+extern const rob_io_t rob_io_sim;
+
 // --- FUNCTION PROTOTYPES ---
+// Call before rob_setup to change the backend (NULL = rob_io_hw)
+void rob_set_io(const rob_io_t* io);
 int rob_setup(void);
 void digitalWrite(int pin, int value);
 int digitalRead(int pin);
 void print_pin_states(void);
 
+// Sets every DO pin in 'mask' to its bit in 'values' (HIGH = bit set),
+// all with a single write to the output register
+void writePins(unsigned int mask, unsigned int values);
+// Logical state of DI1..DI4 (bits 0-3) from a single register read
+unsigned int readAllInputs(void);
+
+// --- INPUT MONITOR ---
+// A thread samples REG_IN at a fixed rate and reports debounced edges on
+// DI1-DI4, instead of the caller polling digitalRead in a loop.
+// Programs using it link with -lpthread.
+typedef struct {
+    unsigned long long time_ns;   // CLOCK_MONOTONIC of the first sample at the new level
+    unsigned char pin;            // DI1..DI4
+    unsigned char value;          // HIGH = rising edge, LOW = falling edge
+} rob_event_t;
+
+typedef void (*rob_event_cb)(const rob_event_t* event, void* ctx);
+
+typedef struct {
+    unsigned int rate_hz;           // Samples per second (0 = 1000)
+    unsigned int debounce_us[4];    // Per input: how long a new level must hold
+    rob_event_cb callback;          // Runs on the monitor thread; NULL = queue events
+    void* ctx;
+    int realtime_priority;          // > 0: SCHED_FIFO at this priority, plus mlockall
+} rob_monitor_config_t;
+
+typedef struct {
+    unsigned long samples;          // REG_IN reads
+    unsigned long missed_ticks;     // Ticks skipped because the thread ran late
+    unsigned long events;
+    unsigned long dropped;          // Events lost to a full queue
+    unsigned long long max_late_ns; // Worst wake-up delay past a tick
+} rob_monitor_stats_t;
+
+// Needs rob_setup first. Returns 0, or -1 if already running, rate_hz is
+// above 1000000000 or the thread cannot start
+int rob_monitor_start(const rob_monitor_config_t* config);
+void rob_monitor_stop(void);
+// Copies up to 'max' queued events out, oldest first; returns how many
+int rob_monitor_poll(rob_event_t* events, int max);
+void rob_monitor_stats(rob_monitor_stats_t* stats);
+
+// --- CAPTURE ---
+// Logic-analyzer style recording of DI1-DI4: a thread reads REG_IN as
+// fast as the bus allows and keeps only the changes, each with the time
+// it was seen and how many samples the previous state lasted, in a ring
+// allocated up front. rob_capture_flush drains the ring into a file.
+// The loop never sleeps: with realtime_priority it should have a CPU of
+// its own (the kernel's RT throttling is all that stops it otherwise).
+// Programs using it link with -lpthread -lm; tools/rob_capture_dump
+// decodes the files.
+typedef struct {
+    unsigned int ring_records;      // Ring capacity (0 = 65536 records)
+    int use_tsc;                    // Stamp with rdtsc (x86) instead of clock_gettime
+    unsigned int stall_ns;          // Longer sample gaps count as stalls (0 = 50000)
+    int realtime_priority;          // > 0: SCHED_FIFO at this priority, plus mlockall
+} rob_capture_config_t;
+
+typedef struct {
+    uint64_t samples;               // REG_IN reads
+    uint64_t changes;               // Records written to the ring
+    uint64_t dropped;               // Changes lost to a full ring
+    uint64_t stalls;                // Sample gaps longer than stall_ns
+    uint64_t missed_samples;        // Estimated samples lost in those stalls
+    uint64_t duration_ns;           // First sample to latest sample
+    uint64_t gap_min_ns;            // Time between consecutive samples...
+    uint64_t gap_max_ns;
+    double gap_mean_ns;
+    double gap_stddev_ns;           // ...and its spread, i.e. the sampling jitter
+    double rate_hz;
+} rob_capture_stats_t;
+
+// Only one capture at a time; rob_setup first. 0 on success, -1 on error
+int rob_capture_start(const rob_capture_config_t* config);
+// Ends the capture, flushes what is left to 'path' (unless NULL), frees the ring
+int rob_capture_stop(const char* path);
+// Moves the records in the ring to the end of 'path' (a new capture
+// replaces an older one in the file); returns how many, or -1
+long rob_capture_flush(const char* path);
+void rob_capture_stats(rob_capture_stats_t* stats);
+
+// Capture file: a header, then one record per change, oldest first.
+// Integers are in host byte order.
+#define ROB_CAPTURE_MAGIC    "ROBCAPT\0"
+#define ROB_CAPTURE_VERSION  1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;           // sizeof(rob_capture_record_t)
+    uint64_t start_ns;              // CLOCK_MONOTONIC of the first sample
+    uint64_t records;
+    uint8_t initial_state;          // DI1-DI4 at the first sample
+    uint8_t tsc;                    // Record times are TSC ticks, not ns
+    uint8_t reserved[6];
+    double tick_ns;                 // Length of one record time unit
+    rob_capture_stats_t stats;      // As of the last flush
+} rob_capture_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint64_t stamp;                 // ticks since start << 5 | gap flag << 4 | DI1-DI4
+    uint32_t run;                   // Samples at the previous state (saturates)
+} rob_capture_record_t;
+
+// Record times are kept in clock ticks: TSC ticks are converted with a
+// rate measured over the whole capture, which is far more exact than any
+// rate known when the record was written
+#define ROB_CAPTURE_TIME(r)   ((r)->stamp >> 5)
+#define ROB_CAPTURE_NS(h, r)  ((double)ROB_CAPTURE_TIME(r) * (h)->tick_ns)
+#define ROB_CAPTURE_STATE(r)  ((unsigned int)((r)->stamp & 0x0F))
+// Set on the first record after the ring was full: changes are missing before it
+#define ROB_CAPTURE_GAP(r)    ((unsigned int)((r)->stamp >> 4) & 1)
+
+// --- SIMULATION (rob_io_sim) ---
+// Raw register contents, before any inversion
+void rob_sim_reset(unsigned char reg_out, unsigned char reg_in);
+void rob_sim_set_inputs(unsigned char reg_in);
+unsigned char rob_sim_outputs(void);
+// Port accesses since the last reset
+void rob_sim_counts(unsigned long* reads, unsigned long* writes);
+// Busy-waits this long in every access, to model bus cost (0 = none)
+void rob_sim_set_latency(unsigned int ns);
+
+// Recorded input waveform: REG_IN takes each step's value at its time
+typedef struct {
+    unsigned long long time_ns;   // From the start of playback
+    unsigned char reg_in;         // Raw REG_IN value
+} rob_sim_step_t;
+
+// Replays 'steps' (sorted by time) from now on; REG_IN keeps its current
+// value until the first step and the last value after the end. The array
+// must outlive playback. rob_sim_reset / rob_sim_set_inputs stop it.
+void rob_sim_play(const rob_sim_step_t* steps, int count);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rob_gpio.h"
+#include "rob_gpio_internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+// --- CAPTURE ---
+// The loop body is one port read, one timestamp and a compare; a record
+// is written only when the inputs change. The ring is single producer
+// (the capture thread), single consumer (flush/stop, from one thread).
+
+#define DEFAULT_RING   65536
+#define DEFAULT_STALL  50000
+#define PUBLISH_EVERY  1024    // Samples between stats updates (power of two)
+
+static rob_capture_config_t config;
+static pthread_t thread;
+static int running = 0;
+static int ready = 0;
+static int locked = 0;
+
+static rob_capture_record_t* ring = NULL;
+static unsigned long ring_mask = 0;
+static unsigned long ring_head = 0;    // Next record to write
+static unsigned long ring_tail = 0;    // Next record to flush
+
+static uint64_t start_ns = 0;
+static unsigned char initial_state = 0;
+
+// The loop counts time in ticks: TSC ticks, or ns with CLOCK_MONOTONIC.
+// The TSC rate is measured against CLOCK_MONOTONIC from the first sample
+// to now (or to the end of the capture), so it gets better as it runs.
+static uint64_t tsc0 = 0;
+static uint64_t tsc_end = 0;
+static uint64_t mono_end = 0;
+static uint64_t stall_ticks = 0;
+
+// Published by the capture thread every PUBLISH_EVERY samples
+static struct {
+    uint64_t samples;
+    uint64_t changes;
+    uint64_t dropped;
+    uint64_t stalls;
+    uint64_t missed;
+    uint64_t last;
+    uint64_t gap_min;
+    uint64_t gap_max;
+    double gap_sumsq;
+} live;
+
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#if HAVE_TSC
+// --- Helper: Rough TSC rate over 10 ms, only for the stall threshold ---
+static double quick_tick_ns(void) {
+    struct timespec pause = { 0, 10000000 };
+    uint64_t t0 = mono_ns();
+    uint64_t c0 = __rdtsc();
+    nanosleep(&pause, NULL);
+    return (double)(mono_ns() - t0) / (double)(__rdtsc() - c0);
+}
+#endif
+
+static inline uint64_t ticks(void) {
+#if HAVE_TSC
+    if (config.use_tsc) return __rdtsc() - tsc0;
+#endif
+    return mono_ns() - start_ns;
+}
+
+static double tick_ns(void) {
+#if HAVE_TSC
+    if (config.use_tsc) {
+        uint64_t mono = __atomic_load_n(&mono_end, __ATOMIC_ACQUIRE);
+        uint64_t tsc = tsc_end;
+        if (mono == 0) {
+            mono = mono_ns();
+            tsc = __rdtsc();
+        }
+        return (tsc > tsc0) ? (double)(mono - start_ns) / (double)(tsc - tsc0) : 1.0;
+    }
+#endif
+    return 1.0;
+}
+
+static void* capture_thread(void* arg) {
+    (void)arg;
+    if (config.realtime_priority > 0) rob_set_realtime(config.realtime_priority, "Capture");
+
+    uint64_t samples = 0, changes = 0, dropped = 0, stalls = 0, missed = 0;
+    uint64_t gap_min = UINT64_MAX, gap_max = 0;
+    double gap_sumsq = 0;
+    uint64_t gap_flag = 0;
+
+    // First sample: the baseline every record is relative to
+    start_ns = mono_ns();
+#if HAVE_TSC
+    tsc0 = __rdtsc();
+#endif
+    unsigned int state = rob_sample_inputs();
+    initial_state = (unsigned char)state;
+    uint64_t prev = 0;
+    uint32_t run = 1;
+    samples = 1;
+    __atomic_store_n(&ready, 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        if ((samples & (PUBLISH_EVERY - 1)) == 0) {
+            __atomic_store_n(&live.samples, samples, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.changes, changes, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.dropped, dropped, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.stalls, stalls, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.missed, missed, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.last, prev, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.gap_min, gap_min, __ATOMIC_RELAXED);
+            __atomic_store_n(&live.gap_max, gap_max, __ATOMIC_RELAXED);
+            __atomic_store(&live.gap_sumsq, &gap_sumsq, __ATOMIC_RELAXED);
+            if (!__atomic_load_n(&running, __ATOMIC_ACQUIRE)) break;
+        }
+
+        unsigned int di = rob_sample_inputs();
+        uint64_t now = ticks();
+        uint64_t gap = now - prev;
+        prev = now;
+        samples++;
+
+        if (gap < gap_min) gap_min = gap;
+        if (gap > gap_max) gap_max = gap;
+        gap_sumsq += (double)gap * (double)gap;
+        if (gap > stall_ticks) {
+            // Samples the loop would have taken at its average pace
+            uint64_t mean = now / (samples - 1);
+            stalls++;
+            if (mean > 0 && gap > mean) missed += gap / mean - 1;
+        }
+
+        if (di == state) {
+            if (run < UINT32_MAX) run++;
+            continue;
+        }
+
+        // Changed: one record, unless the ring is full
+        unsigned long head = ring_head;
+        if (head - __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE) > ring_mask) {
+            dropped++;
+            gap_flag = 1;
+        } else {
+            ring[head & ring_mask].stamp = now << 5 | gap_flag << 4 | di;
+            ring[head & ring_mask].run = run;
+            __atomic_store_n(&ring_head, head + 1, __ATOMIC_RELEASE);
+            changes++;
+            gap_flag = 0;
+        }
+        state = di;
+        run = 1;
+    }
+
+    // Fixes the TSC rate for flushes from here on
+#if HAVE_TSC
+    tsc_end = __rdtsc();
+#endif
+    __atomic_store_n(&mono_end, mono_ns(), __ATOMIC_RELEASE);
+    return NULL;
+}
+
+int rob_capture_start(const rob_capture_config_t* cfg) {
+    if (ring) {
+        fprintf(stderr, "[LIB-ROB] Capture: already running\n");
+        return -1;
+    }
+
+    config = *cfg;
+    if (config.stall_ns == 0) config.stall_ns = DEFAULT_STALL;
+    unsigned long cap = config.ring_records ? config.ring_records : DEFAULT_RING;
+    unsigned long size = 1;
+    while (size < cap) size <<= 1;
+    if (config.use_tsc && !HAVE_TSC) {
+        fprintf(stderr, "[LIB-ROB] Capture: no TSC on this CPU, using CLOCK_MONOTONIC\n");
+        config.use_tsc = 0;
+    }
+    stall_ticks = config.stall_ns;
+#if HAVE_TSC
+    if (config.use_tsc) stall_ticks = (uint64_t)(config.stall_ns / quick_tick_ns());
+#endif
+
+    // Touch every page now, so the loop never takes a fault on a new record
+    ring = malloc(size * sizeof(rob_capture_record_t));
+    if (!ring) {
+        perror("[LIB-ROB] Capture: ring allocation failed");
+        return -1;
+    }
+    memset(ring, 0, size * sizeof(rob_capture_record_t));
+    ring_mask = size - 1;
+    ring_head = ring_tail = 0;
+    memset(&live, 0, sizeof(live));
+    mono_end = tsc_end = 0;
+
+    if (config.realtime_priority > 0) locked = rob_lock_memory("Capture");
+
+    __atomic_store_n(&ready, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&running, 1, __ATOMIC_RELEASE);
+    int err = pthread_create(&thread, NULL, capture_thread, NULL);
+    if (err) {
+        fprintf(stderr, "[LIB-ROB] Capture: thread start failed (%s)\n", strerror(err));
+        __atomic_store_n(&running, 0, __ATOMIC_RELEASE);
+        if (locked) rob_unlock_memory();
+        locked = 0;
+        free(ring);
+        ring = NULL;
+        return -1;
+    }
+
+    // Flushes need start_ns and the initial state
+    while (!__atomic_load_n(&ready, __ATOMIC_ACQUIRE)) sched_yield();
+    return 0;
+}
+
+int rob_capture_stop(const char* path) {
+    if (!ring) return -1;
+
+    __atomic_store_n(&running, 0, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    int result = 0;
+    if (path && rob_capture_flush(path) < 0) result = -1;
+
+    free(ring);
+    ring = NULL;
+    if (locked) rob_unlock_memory();
+    locked = 0;
+    return result;
+}
+
+// --- Helper: Is 'h' the header of this capture's file? ---
+static int same_capture(const rob_capture_header_t* h, off_t file_len) {
+    return memcmp(h->magic, ROB_CAPTURE_MAGIC, sizeof(h->magic)) == 0 &&
+           h->version == ROB_CAPTURE_VERSION &&
+           h->record_size == sizeof(rob_capture_record_t) &&
+           h->start_ns == start_ns &&
+           (uint64_t)file_len == sizeof(*h) + h->records * sizeof(rob_capture_record_t);
+}
+
+long rob_capture_flush(const char* path) {
+    if (!ring) {
+        fprintf(stderr, "[LIB-ROB] Capture: not running\n");
+        return -1;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        perror("[LIB-ROB] Capture: open failed");
+        return -1;
+    }
+
+    struct stat st;
+    rob_capture_header_t h;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(h) ||
+        pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) || !same_capture(&h, st.st_size)) {
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, ROB_CAPTURE_MAGIC, sizeof(h.magic));
+        h.version = ROB_CAPTURE_VERSION;
+        h.record_size = sizeof(rob_capture_record_t);
+        h.start_ns = start_ns;
+        h.initial_state = initial_state;
+        h.tsc = (uint8_t)(config.use_tsc != 0);
+    }
+    h.tick_ns = tick_ns();
+
+    unsigned long tail = ring_tail;
+    unsigned long n = __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE) - tail;
+    size_t file_len = sizeof(h) + (h.records + n) * sizeof(rob_capture_record_t);
+    if (ftruncate(fd, (off_t)file_len) < 0) {
+        perror("[LIB-ROB] Capture: file resize failed");
+        close(fd);
+        return -1;
+    }
+    char* map = mmap(NULL, file_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("[LIB-ROB] Capture: mmap failed");
+        return -1;
+    }
+
+    // Oldest first; the ring may wrap once
+    rob_capture_record_t* dst = (rob_capture_record_t*)(map + sizeof(h)) + h.records;
+    unsigned long first = tail & ring_mask;
+    unsigned long chunk = (n < ring_mask + 1 - first) ? n : ring_mask + 1 - first;
+    memcpy(dst, ring + first, chunk * sizeof(rob_capture_record_t));
+    memcpy(dst + chunk, ring, (n - chunk) * sizeof(rob_capture_record_t));
+    __atomic_store_n(&ring_tail, tail + n, __ATOMIC_RELEASE);
+
+    h.records += n;
+    rob_capture_stats(&h.stats);
+    memcpy(map, &h, sizeof(h));
+    munmap(map, file_len);
+    return (long)n;
+}
+
+void rob_capture_stats(rob_capture_stats_t* out) {
+    memset(out, 0, sizeof(*out));
+    out->samples = __atomic_load_n(&live.samples, __ATOMIC_RELAXED);
+    out->changes = __atomic_load_n(&live.changes, __ATOMIC_RELAXED);
+    out->dropped = __atomic_load_n(&live.dropped, __ATOMIC_RELAXED);
+    out->stalls = __atomic_load_n(&live.stalls, __ATOMIC_RELAXED);
+    out->missed_samples = __atomic_load_n(&live.missed, __ATOMIC_RELAXED);
+    uint64_t last = __atomic_load_n(&live.last, __ATOMIC_RELAXED);
+    if (out->samples < 2 || last == 0) return;
+
+    // Everything below was counted in ticks
+    double scale = tick_ns();
+    double gaps = (double)(out->samples - 1);
+    double sumsq;
+    __atomic_load(&live.gap_sumsq, &sumsq, __ATOMIC_RELAXED);
+    double mean = last / gaps;
+    double variance = sumsq / gaps - mean * mean;
+
+    out->duration_ns = (uint64_t)(last * scale);
+    out->gap_min_ns = (uint64_t)(__atomic_load_n(&live.gap_min, __ATOMIC_RELAXED) * scale);
+    out->gap_max_ns = (uint64_t)(__atomic_load_n(&live.gap_max, __ATOMIC_RELAXED) * scale);
+    out->gap_mean_ns = mean * scale;
+    out->gap_stddev_ns = (variance > 0) ? sqrt(variance) * scale : 0;
+    out->rate_hz = gaps * 1e9 / (last * scale);
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef ROB_GPIO_INTERNAL_H
+#define ROB_GPIO_INTERNAL_H
+
+// Shared between the library's own files; not installed.
+
+// --- REGISTERS ---
+#define REG_OUT 0xA02
+#define REG_IN  0xA03
+
+// One REG_IN read through the current backend, mapped to the logical
+// DI1-DI4 bits. Unlike readAllInputs it leaves pin_states alone, so the
+// monitor and capture threads can call it.
+unsigned int rob_sample_inputs(void);
+
+// Moves the calling thread to SCHED_FIFO, or warns as 'who' and carries on
+void rob_set_realtime(int priority, const char* who);
+
+// mlockall is per process, so the monitor and capture threads share one
+// reference count: memory is unlocked when the last user lets go, and
+// never if it was already locked before the library first locked it.
+// Returns 1 if the caller now holds a reference, 0 (warned as 'who') if not.
+int rob_lock_memory(const char* who);
+void rob_unlock_memory(void);
+
+#endif
\ No newline at end of file
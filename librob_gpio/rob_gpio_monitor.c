@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "rob_gpio.h"
+#include "rob_gpio_internal.h"
+
+// --- INPUT MONITOR ---
+// One REG_IN read per tick covers all four inputs: XOR against the
+// debounced state gives every pin that differs, so a quiet tick costs one
+// port read and one compare. A differing pin must keep its new level for
+// its debounce window before the edge is reported; going back earlier
+// cancels it.
+
+#define NUM_DI      4
+#define QUEUE_SIZE  1024   // Power of two
+
+static rob_monitor_config_t config;
+static pthread_t thread;
+static int running = 0;
+static int locked = 0;
+
+// --- EVENT QUEUE ---
+// Single producer (the monitor thread), single consumer (rob_monitor_poll)
+static rob_event_t queue[QUEUE_SIZE];
+static unsigned long queue_head = 0;   // Next slot to write
+static unsigned long queue_tail = 0;   // Next slot to read
+
+static rob_monitor_stats_t stats;
+
+static void count(unsigned long* counter, unsigned long n) {
+    __atomic_store_n(counter, *counter + n, __ATOMIC_RELAXED);
+}
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void deliver(const rob_event_t* event) {
+    count(&stats.events, 1);
+    if (config.callback) {
+        config.callback(event, config.ctx);
+        return;
+    }
+
+    unsigned long head = queue_head;
+    if (head - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE) == QUEUE_SIZE) {
+        count(&stats.dropped, 1);
+        return;
+    }
+    queue[head & (QUEUE_SIZE - 1)] = *event;
+    __atomic_store_n(&queue_head, head + 1, __ATOMIC_RELEASE);
+}
+
+// --- Helper: SCHED_FIFO for the calling thread only ---
+void rob_set_realtime(int priority, const char* who) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err) {
+        fprintf(stderr, "[LIB-ROB] %s: SCHED_FIFO unavailable (%s), running normal priority\n", who,
+                strerror(err));
+    }
+}
+
+// --- Helper: Shared mlockall reference count ---
+static pthread_mutex_t lock_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int lock_users = 0;
+static int lock_owned = 0;   // Nothing was locked before us, so unlocking is ours to do
+
+// VmLck in /proc/self/status: any locked pages, e.g. from the application
+static int memory_locked(void) {
+    FILE* f = fopen("/proc/self/status", "r");
+    if (!f) return 0;
+    char line[128];
+    unsigned long kb = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "VmLck: %lu", &kb) == 1) break;
+    }
+    fclose(f);
+    return kb > 0;
+}
+
+int rob_lock_memory(const char* who) {
+    int ok = 1;
+    pthread_mutex_lock(&lock_mutex);
+    if (lock_users == 0) {
+        lock_owned = !memory_locked();
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            fprintf(stderr, "[LIB-ROB] %s: mlockall failed (%s)\n", who, strerror(errno));
+            ok = 0;
+        }
+    }
+    if (ok) lock_users++;
+    pthread_mutex_unlock(&lock_mutex);
+    return ok;
+}
+
+void rob_unlock_memory(void) {
+    pthread_mutex_lock(&lock_mutex);
+    if (lock_users > 0 && --lock_users == 0 && lock_owned) munlockall();
+    pthread_mutex_unlock(&lock_mutex);
+}
+
+static void* monitor_thread(void* arg) {
+    (void)arg;
+    if (config.realtime_priority > 0) rob_set_realtime(config.realtime_priority, "Monitor");
+
+    unsigned long long period = 1000000000ULL / config.rate_hz;
+    unsigned long long debounce[NUM_DI];
+    for (int i = 0; i < NUM_DI; i++) debounce[i] = config.debounce_us[i] * 1000ULL;
+
+    // The levels at start are the baseline, not events
+    unsigned int stable = rob_sample_inputs();
+    unsigned int pending = 0;                  // Pins waiting out their window
+    unsigned long long since[NUM_DI] = {0};    // When each pending pin changed
+    unsigned long long next = now_ns() + period;
+
+    while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+        struct timespec wake = { (time_t)(next / 1000000000ULL), (long)(next % 1000000000ULL) };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR) {}
+
+        unsigned long long now = now_ns();
+        unsigned int di = rob_sample_inputs();
+        count(&stats.samples, 1);
+
+        unsigned long long late = now - next;
+        if (late > stats.max_late_ns) __atomic_store_n(&stats.max_late_ns, late, __ATOMIC_RELAXED);
+        next += period;
+        if (now >= next) {
+            // Overran whole ticks: skip them rather than sample in a burst
+            unsigned long long behind = (now - next) / period + 1;
+            count(&stats.missed_ticks, (unsigned long)behind);
+            next += behind * period;
+        }
+
+        unsigned int changed = di ^ stable;
+        if ((changed | pending) == 0) continue;
+
+        // New candidates start their window; pins back at the stable level drop out
+        unsigned int started = changed & ~pending;
+        pending = changed;
+        for (int i = 0; i < NUM_DI; i++) {
+            if (started & (1u << i)) since[i] = now;
+        }
+
+        for (int i = 0; i < NUM_DI; i++) {
+            if (!(pending & (1u << i)) || now - since[i] < debounce[i]) continue;
+            rob_event_t event = { since[i], (unsigned char)(DI1 + i), (unsigned char)((di >> i) & 1) };
+            stable ^= 1u << i;
+            pending &= ~(1u << i);
+            deliver(&event);
+        }
+    }
+    return NULL;
+}
+
+int rob_monitor_start(const rob_monitor_config_t* cfg) {
+    if (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+        fprintf(stderr, "[LIB-ROB] Monitor: already running\n");
+        return -1;
+    }
+
+    // The tick period is whole nanoseconds, so it must come out at least 1
+    if (cfg->rate_hz > 1000000000u) {
+        fprintf(stderr, "[LIB-ROB] Monitor: rate_hz %u is above 1 GHz\n", cfg->rate_hz);
+        return -1;
+    }
+
+    config = *cfg;
+    if (config.rate_hz == 0) config.rate_hz = 1000;
+    memset(&stats, 0, sizeof(stats));
+    queue_head = queue_tail = 0;
+
+    // Keep page faults out of the sampling loop
+    if (config.realtime_priority > 0) locked = rob_lock_memory("Monitor");
+
+    __atomic_store_n(&running, 1, __ATOMIC_RELEASE);
+    int err = pthread_create(&thread, NULL, monitor_thread, NULL);
+    if (err) {
+        __atomic_store_n(&running, 0, __ATOMIC_RELEASE);
+        fprintf(stderr, "[LIB-ROB] Monitor: thread start failed (%s)\n", strerror(err));
+        if (locked) rob_unlock_memory();
+        locked = 0;
+        return -1;
+    }
+    return 0;
+}
+
+void rob_monitor_stop(void) {
+    if (!__atomic_exchange_n(&running, 0, __ATOMIC_ACQ_REL)) return;
+    pthread_join(thread, NULL);
+    if (locked) rob_unlock_memory();
+    locked = 0;
+}
+
+int rob_monitor_poll(rob_event_t* events, int max) {
+    unsigned long tail = queue_tail;
+    unsigned long head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+    int n = 0;
+    while (tail != head && n < max) {
+        events[n++] = queue[tail & (QUEUE_SIZE - 1)];
+        tail++;
+    }
+    __atomic_store_n(&queue_tail, tail, __ATOMIC_RELEASE);
+    return n;
+}
+
+void rob_monitor_stats(rob_monitor_stats_t* out) {
+    out->samples = __atomic_load_n(&stats.samples, __ATOMIC_RELAXED);
+    out->missed_ticks = __atomic_load_n(&stats.missed_ticks, __ATOMIC_RELAXED);
+    out->events = __atomic_load_n(&stats.events, __ATOMIC_RELAXED);
+    out->dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    out->max_late_ns = __atomic_load_n(&stats.max_late_ns, __ATOMIC_RELAXED);
+}
\ No newline at end of file
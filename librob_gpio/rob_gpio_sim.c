@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <time.h>
+#include "rob_gpio.h"
+#include "rob_gpio_internal.h"
+
+// --- SIMULATED REGISTER FILE ---
+// Stands in for the two ports rob_setup asks ioperm for (REG_OUT and
+// REG_IN), so the library runs without root or the hardware.
+// The registers are atomics: one thread can drive the inputs while
+// another runs the library.
+#define SIM_BASE  REG_OUT
+#define SIM_PORTS 2
+
+static unsigned char regs[SIM_PORTS];
+static unsigned long reads = 0;
+static unsigned long writes = 0;
+static unsigned int latency_ns = 0;
+
+// Waveform playback: REG_IN follows 'wave' once it is set
+static const rob_sim_step_t* wave = NULL;
+static int wave_count = 0;
+static long long wave_start_ns = 0;
+
+static long long sim_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// --- Helper: REG_IN at this moment of the waveform ---
+static unsigned char wave_value(const rob_sim_step_t* steps) {
+    unsigned long long t = (unsigned long long)(sim_now_ns() - wave_start_ns);
+    if (t < steps[0].time_ns) return __atomic_load_n(&regs[1], __ATOMIC_ACQUIRE);
+
+    // Last step at or before t
+    int lo = 0, hi = wave_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (steps[mid].time_ns <= t) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return steps[lo].reg_in;
+}
+
+// --- Helper: Busy-wait, like a slow ISA bus cycle ---
+static void sim_delay(void) {
+    if (latency_ns == 0) return;
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000000000L + (now.tv_nsec - start.tv_nsec) < (long)latency_ns);
+}
+
+static int sim_open(void) {
+    return 0;
+}
+
+static unsigned char sim_in(unsigned short port) {
+    sim_delay();
+    __atomic_fetch_add(&reads, 1, __ATOMIC_RELAXED);
+    if (port < SIM_BASE || port >= SIM_BASE + SIM_PORTS) return 0xFF; // Floating bus
+    if (port == REG_IN) {
+        const rob_sim_step_t* steps = __atomic_load_n(&wave, __ATOMIC_ACQUIRE);
+        if (steps) return wave_value(steps);
+    }
+    return __atomic_load_n(&regs[port - SIM_BASE], __ATOMIC_ACQUIRE);
+}
+
+static void sim_out(unsigned char value, unsigned short port) {
+    sim_delay();
+    __atomic_fetch_add(&writes, 1, __ATOMIC_RELAXED);
+    if (port < SIM_BASE || port >= SIM_BASE + SIM_PORTS) {
+        fprintf(stderr, "[LIB-ROB] Sim: write to unmapped port 0x%X\n", port);
+        return;
+    }
+    __atomic_store_n(&regs[port - SIM_BASE], value, __ATOMIC_RELEASE);
+}
+
+const rob_io_t rob_io_sim = { sim_open, sim_in, sim_out };
+
+// --- TEST CONTROLS ---
+void rob_sim_reset(unsigned char reg_out, unsigned char reg_in) {
+    __atomic_store_n(&wave, NULL, __ATOMIC_RELEASE);
+    __atomic_store_n(&regs[0], reg_out, __ATOMIC_RELEASE);
+    __atomic_store_n(&regs[1], reg_in, __ATOMIC_RELEASE);
+    __atomic_store_n(&reads, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&writes, 0, __ATOMIC_RELAXED);
+}
+
+void rob_sim_set_inputs(unsigned char reg_in) {
+    __atomic_store_n(&wave, NULL, __ATOMIC_RELEASE);
+    __atomic_store_n(&regs[1], reg_in, __ATOMIC_RELEASE);
+}
+
+unsigned char rob_sim_outputs(void) {
+    return __atomic_load_n(&regs[0], __ATOMIC_ACQUIRE);
+}
+
+void rob_sim_counts(unsigned long* r, unsigned long* w) {
+    if (r) *r = __atomic_load_n(&reads, __ATOMIC_RELAXED);
+    if (w) *w = __atomic_load_n(&writes, __ATOMIC_RELAXED);
+}
+
+void rob_sim_set_latency(unsigned int ns) {
+    latency_ns = ns;
+}
+
+void rob_sim_play(const rob_sim_step_t* steps, int count) {
+    __atomic_store_n(&wave, NULL, __ATOMIC_RELEASE);
+    if (!steps || count <= 0) return;
+
+    wave_count = count;
+    wave_start_ns = sim_now_ns();
+    __atomic_store_n(&wave, steps, __ATOMIC_RELEASE);
+}
\ No newline at end of file
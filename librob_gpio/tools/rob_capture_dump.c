@@ -0,0 +1,106 @@
+/*
+ * Decodes a capture file written by rob_capture_flush / rob_capture_stop.
+ *
+ * Prints the capture statistics and one line per change: time since the
+ * start, DI4..DI1, and how many samples the previous state lasted. With
+ * -vcd the changes are written as a Value Change Dump for a waveform
+ * viewer (GTKWave and friends) instead.
+ *
+ * Usage: ./tools/rob_capture_dump [-vcd] capture.bin
+ */
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rob_gpio.h"
+
+static void print_bits(unsigned int state) {
+    for (int pin = DI4; pin >= DI1; pin--) putchar('0' + ((state >> pin) & 1));
+}
+
+static void dump_text(const rob_capture_header_t* h, const rob_capture_record_t* records) {
+    const rob_capture_stats_t* s = &h->stats;
+    printf("%llu changes over %.6f s, timestamps from %s\n", (unsigned long long)h->records,
+           s->duration_ns / 1e9, h->tsc ? "TSC" : "CLOCK_MONOTONIC");
+    printf("samples %llu at %.0f/s; gap mean %.1f ns, stddev %.1f ns, min %llu ns, max %llu ns\n",
+           (unsigned long long)s->samples, s->rate_hz, s->gap_mean_ns, s->gap_stddev_ns,
+           (unsigned long long)s->gap_min_ns, (unsigned long long)s->gap_max_ns);
+    printf("stalls %llu (~%llu samples missed), changes dropped on a full ring %llu\n",
+           (unsigned long long)s->stalls, (unsigned long long)s->missed_samples, (unsigned long long)s->dropped);
+
+    printf("%14s  DI4321  %10s\n", "time us", "held");
+    printf("%14.3f  ", 0.0);
+    print_bits(h->initial_state);
+    printf("  %10s\n", "-");
+    for (uint64_t i = 0; i < h->records; i++) {
+        const rob_capture_record_t* r = &records[i];
+        printf("%14.3f  ", ROB_CAPTURE_NS(h, r) / 1e3);
+        print_bits(ROB_CAPTURE_STATE(r));
+        printf("  %10u%s\n", r->run, ROB_CAPTURE_GAP(r) ? "  (changes lost before this)" : "");
+    }
+}
+
+static void dump_vcd(const rob_capture_header_t* h, const rob_capture_record_t* records) {
+    printf("$timescale 1ns $end\n$scope module rob_gpio $end\n");
+    for (int pin = DI1; pin <= DI4; pin++) printf("$var wire 1 %c DI%d $end\n", '!' + pin, pin + 1);
+    printf("$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+    for (int pin = DI1; pin <= DI4; pin++) printf("%u%c\n", (h->initial_state >> pin) & 1, '!' + pin);
+    printf("$end\n");
+
+    unsigned int state = h->initial_state;
+    for (uint64_t i = 0; i < h->records; i++) {
+        const rob_capture_record_t* r = &records[i];
+        unsigned int next = ROB_CAPTURE_STATE(r);
+        printf("#%llu\n", (unsigned long long)ROB_CAPTURE_NS(h, r));
+        for (int pin = DI1; pin <= DI4; pin++) {
+            if ((state ^ next) & (1u << pin)) printf("%u%c\n", (next >> pin) & 1, '!' + pin);
+        }
+        state = next;
+    }
+    printf("#%llu\n", (unsigned long long)h->stats.duration_ns);
+}
+
+int main(int argc, char** argv) {
+    int vcd = argc > 2 && strcmp(argv[1], "-vcd") == 0;
+    if (argc != 2 + vcd) {
+        fprintf(stderr, "Usage: %s [-vcd] capture.bin\n", argv[0]);
+        return 2;
+    }
+    const char* path = argv[1 + vcd];
+
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(path);
+        return 1;
+    }
+    if ((size_t)st.st_size < sizeof(rob_capture_header_t)) {
+        fprintf(stderr, "%s: too short for a capture file\n", path);
+        return 1;
+    }
+    const char* map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    const rob_capture_header_t* h = (const rob_capture_header_t*)map;
+    if (memcmp(h->magic, ROB_CAPTURE_MAGIC, sizeof(h->magic)) != 0 || h->version != ROB_CAPTURE_VERSION ||
+        h->record_size != sizeof(rob_capture_record_t) ||
+        (uint64_t)st.st_size != sizeof(*h) + h->records * sizeof(rob_capture_record_t)) {
+        fprintf(stderr, "%s: not a version %d capture file\n", path, ROB_CAPTURE_VERSION);
+        return 1;
+    }
+
+    const rob_capture_record_t* records = (const rob_capture_record_t*)(map + sizeof(*h));
+    if (vcd) {
+        dump_vcd(h, records);
+    } else {
+        dump_text(h, records);
+    }
+    munmap((void*)map, st.st_size);
+    return 0;
+}
\ No newline at end of file